@@ -0,0 +1,12 @@
+# build and run page_size_performance_test once for every supported page size
+# usage: sh page_size_benchmark.sh [build type] [build root], each page size is built in <build root>/build-page-<size>,
+# the build root defaults to the current directory
+SOURCE_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_TYPE=${1:-Release}
+BUILD_ROOT=${2:-.}
+for PAGE_SIZE in 4096 8192 16384 32768; do
+  BUILD_DIR=${BUILD_ROOT}/build-page-${PAGE_SIZE}
+  cmake -S ${SOURCE_DIR} -B ${BUILD_DIR} -DCMAKE_BUILD_TYPE=${BUILD_TYPE} -DMINISQL_PAGE_SIZE=${PAGE_SIZE} > /dev/null || exit 1
+  cmake --build ${BUILD_DIR} --target page_size_performance_test -j > /dev/null || exit 1
+  (cd ${BUILD_DIR}/test && ./page_size_performance_test 2>&1 | grep "\[page size")
+done
@@ -0,0 +1,130 @@
+#include "buffer/arc_replacer.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+
+ARCReplacer::ARCReplacer(size_t num_pages) : capacity_(num_pages), frames_(num_pages) {}
+
+ARCReplacer::~ARCReplacer() = default;
+
+bool ARCReplacer::VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) {
+  ListType preferred = PreferredList();
+  for (ListType type : {preferred, preferred == ListType::kRecent ? ListType::kFrequent : ListType::kRecent}) {
+    auto &frames = GetList(type);
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      if (evictable(*it)) {
+        *frame_id = *it;
+        frames.erase(std::next(it).base());
+        FrameEntry &entry = frames_[*frame_id];
+        AddGhost(type, entry.page_id_);
+        entry = FrameEntry();
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ARCReplacer::Pin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= capacity_ || frames_[frame_id].list_ == ListType::kNone) {
+    return;
+  }
+  // the page is gone, e.g. deleted, so it is not remembered
+  FrameEntry &entry = frames_[frame_id];
+  GetList(entry.list_).erase(entry.pos_);
+  entry = FrameEntry();
+}
+
+void ARCReplacer::Unpin(frame_id_t frame_id) { Admit(frame_id, INVALID_PAGE_ID); }
+
+void ARCReplacer::Admit(frame_id_t frame_id, page_id_t page_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= capacity_) {
+    LOG(ERROR) << "Frame id out of range: " << frame_id;
+    return;
+  }
+  FrameEntry &entry = frames_[frame_id];
+  if (entry.list_ != ListType::kNone) {
+    return;
+  }
+  ListType type = ListType::kRecent;
+  auto ghost = page_id == INVALID_PAGE_ID ? ghosts_.end() : ghosts_.find(page_id);
+  if (ghost != ghosts_.end()) {
+    // the page was evicted too early, give more frames to the list it was evicted from
+    size_t num_recent = recent_ghosts_.size();
+    size_t num_frequent = frequent_ghosts_.size();
+    if (ghost->second.first == ListType::kRecent) {
+      recent_target_ = std::min(capacity_, recent_target_ + std::max<size_t>(num_frequent / num_recent, 1));
+      recent_ghosts_.erase(ghost->second.second);
+    } else {
+      recent_target_ -= std::min(recent_target_, std::max<size_t>(num_recent / num_frequent, 1));
+      frequent_ghosts_.erase(ghost->second.second);
+    }
+    ghosts_.erase(ghost);
+    type = ListType::kFrequent;
+  }
+  auto &frames = GetList(type);
+  frames.push_front(frame_id);
+  entry.list_ = type;
+  entry.pos_ = frames.begin();
+  entry.page_id_ = page_id;
+}
+
+void ARCReplacer::RecordAccess(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= capacity_ || frames_[frame_id].list_ == ListType::kNone) {
+    return;
+  }
+  // a second access moves the frame to the front of the frequent list
+  FrameEntry &entry = frames_[frame_id];
+  frequent_.splice(frequent_.begin(), GetList(entry.list_), entry.pos_);
+  entry.list_ = ListType::kFrequent;
+}
+
+size_t ARCReplacer::Size() { return recent_.size() + frequent_.size(); }
+
+void ARCReplacer::PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) {
+  ListType preferred = PreferredList();
+  for (ListType type : {preferred, preferred == ListType::kRecent ? ListType::kFrequent : ListType::kRecent}) {
+    auto &frames = GetList(type);
+    for (auto it = frames.rbegin(); it != frames.rend() && frame_ids->size() < max_frames; ++it) {
+      frame_ids->push_back(*it);
+    }
+  }
+}
+
+ARCReplacer::ListType ARCReplacer::PreferredList() const {
+  if (frequent_.empty() || (!recent_.empty() && recent_.size() > recent_target_)) {
+    return ListType::kRecent;
+  }
+  return ListType::kFrequent;
+}
+
+void ARCReplacer::AddGhost(ListType type, page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  auto &ghosts = type == ListType::kRecent ? recent_ghosts_ : frequent_ghosts_;
+  ghosts.push_front(page_id);
+  ghosts_[page_id] = std::make_pair(type, ghosts.begin());
+  TrimGhosts();
+}
+
+void ARCReplacer::TrimGhosts() {
+  // T1 + B1 holds at most capacity pages, all four lists together at most twice the capacity
+  while (!recent_ghosts_.empty() && recent_.size() + recent_ghosts_.size() > capacity_) {
+    ghosts_.erase(recent_ghosts_.back());
+    recent_ghosts_.pop_back();
+  }
+  while (Size() + recent_ghosts_.size() + frequent_ghosts_.size() > 2 * capacity_) {
+    auto &oldest = frequent_ghosts_.empty() ? recent_ghosts_ : frequent_ghosts_;
+    ghosts_.erase(oldest.back());
+    oldest.pop_back();
+  }
+}
+
+void ARCReplacer::Resize(size_t num_frames) {
+  capacity_ = num_frames;
+  frames_.resize(num_frames);
+  recent_target_ = std::min(recent_target_, capacity_);
+  TrimGhosts();
+}
@@ -0,0 +1,37 @@
+#include "buffer/buffer_access_strategy.h"
+
+BufferAccessStrategy::BufferAccessStrategy(BufferAccessType type)
+    : ring_size_(type == BufferAccessType::kBulkRead ? BULK_READ_RING_SIZE : BULK_WRITE_RING_SIZE) {}
+
+frame_id_t BufferAccessStrategy::GetCurrentFrame(const BufferPoolManager *pool, size_t max_frames,
+                                                 page_id_t *page_id) {
+  Ring &ring = GetRing(pool, max_frames);
+  if (ring.slots_.size() < GetRingSize(max_frames)) {
+    return INVALID_FRAME_ID;
+  }
+  *page_id = ring.slots_[ring.next_].page_id_;
+  return ring.slots_[ring.next_].frame_id_;
+}
+
+void BufferAccessStrategy::Remember(const BufferPoolManager *pool, frame_id_t frame_id, page_id_t page_id) {
+  Ring &ring = rings_[pool];
+  // the ring is filled before it comes around
+  if (ring.next_ == ring.slots_.size()) {
+    ring.slots_.emplace_back();
+  }
+  ring.slots_[ring.next_] = {frame_id, page_id};
+  ring.next_++;
+}
+
+BufferAccessStrategy::Ring &BufferAccessStrategy::GetRing(const BufferPoolManager *pool, size_t max_frames) {
+  Ring &ring = rings_[pool];
+  size_t ring_size = GetRingSize(max_frames);
+  // the pool may have been shrunk, the frames beyond the ring size go back to the replacer
+  if (ring.slots_.size() > ring_size) {
+    ring.slots_.resize(ring_size);
+  }
+  if (ring.next_ >= ring_size) {
+    ring.next_ = 0;
+  }
+  return ring;
+}
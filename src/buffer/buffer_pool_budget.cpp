@@ -0,0 +1,228 @@
+#include "buffer/buffer_pool_budget.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glog/logging.h"
+
+BufferPoolBudget::BufferPoolBudget(size_t budget, std::chrono::milliseconds interval)
+    : budget_(budget), interval_(interval) {
+  thread_ = std::thread(&BufferPoolBudget::Run, this);
+}
+
+BufferPoolBudget::~BufferPoolBudget() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+size_t BufferPoolBudget::GetInitialSize() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // a fair share, the pools already there are cut down when the new one is registered
+  return std::max({GetShared() / (members_.size() + 1), std::min(MIN_POOL_SIZE, GetShared()), size_t{1}});
+}
+
+void BufferPoolBudget::Register(BufferPoolManager *bpm) {
+  Targets targets;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    members_.push_back({bpm, bpm->GetNumMisses()});
+    std::vector<size_t> sizes;
+    for (auto &member : members_) {
+      sizes.push_back(member.bpm_->GetPoolSize());
+    }
+    targets = FitTargets(sizes);
+  }
+  ApplyTargets(targets, false);
+}
+
+void BufferPoolBudget::Unregister(BufferPoolManager *bpm) {
+  std::unique_lock<std::mutex> lock(latch_);
+  members_.erase(std::remove_if(members_.begin(), members_.end(),
+                                [bpm](const Member &member) { return member.bpm_ == bpm; }),
+                 members_.end());
+  cv_.wait(lock, [this, bpm] { return resizing_.count(bpm) == 0; });
+}
+
+void BufferPoolBudget::SetBudget(size_t budget) {
+  Targets targets;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    budget_ = budget;
+    // a smaller budget is enforced right away, the frames of a larger one go to the pools that miss on the next pass
+    std::vector<size_t> sizes;
+    for (auto &member : members_) {
+      sizes.push_back(member.bpm_->GetPoolSize());
+    }
+    targets = FitTargets(sizes);
+  }
+  ApplyTargets(targets, false);
+}
+
+size_t BufferPoolBudget::GetBudget() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return budget_;
+}
+
+void BufferPoolBudget::SetReserved(size_t reserved) {
+  Targets targets;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    reserved_ = reserved;
+    std::vector<size_t> sizes;
+    for (auto &member : members_) {
+      sizes.push_back(member.bpm_->GetPoolSize());
+    }
+    targets = FitTargets(sizes);
+  }
+  ApplyTargets(targets, false);
+}
+
+size_t BufferPoolBudget::GetReserved() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return reserved_;
+}
+
+void BufferPoolBudget::Rebalance() {
+  std::scoped_lock<std::mutex> pass_lock(pass_latch_);
+  Targets targets;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    targets = ComputeTargets();
+  }
+  ApplyTargets(targets, true);
+}
+
+void BufferPoolBudget::Run() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (!cv_.wait_for(lock, interval_, [this] { return stop_; })) {
+    lock.unlock();
+    Rebalance();
+    lock.lock();
+  }
+}
+
+BufferPoolBudget::Targets BufferPoolBudget::ComputeTargets() {
+  if (members_.empty()) {
+    return {};
+  }
+  size_t floor = GetFloor();
+  std::vector<size_t> targets(members_.size());
+  size_t total_demand = 0;
+  for (size_t i = 0; i < members_.size(); i++) {
+    Member &member = members_[i];
+    size_t num_misses = member.bpm_->GetNumMisses();
+    member.demand_ = member.demand_ / 2 + (num_misses - member.last_misses_);
+    member.last_misses_ = num_misses;
+    targets[i] = member.bpm_->GetPoolSize();
+    total_demand += member.demand_;
+  }
+  if (total_demand > 0) {
+    // idle pools give back half of their frames above the floor, the pools that miss split the rest
+    size_t idle_frames = 0;
+    for (size_t i = 0; i < members_.size(); i++) {
+      if (members_[i].demand_ == 0) {
+        targets[i] -= targets[i] > floor ? (targets[i] - floor) / 2 : 0;
+        idle_frames += targets[i];
+      }
+    }
+    size_t rest = GetShared() > idle_frames ? GetShared() - idle_frames : 0;
+    for (size_t i = 0; i < members_.size(); i++) {
+      if (members_[i].demand_ > 0) {
+        auto share = static_cast<size_t>(static_cast<double>(rest) * members_[i].demand_ / total_demand);
+        targets[i] = std::max(share, floor);
+      }
+    }
+  }
+  return FitTargets(targets);
+}
+
+BufferPoolBudget::Targets BufferPoolBudget::FitTargets(std::vector<size_t> sizes) {
+  size_t floor = GetFloor();
+  // the frames above the floor are cut in proportion until the targets fit in the budget
+  size_t shared = GetShared();
+  size_t sum = 0;
+  size_t above_floor = 0;
+  for (auto size : sizes) {
+    sum += size;
+    above_floor += size > floor ? size - floor : 0;
+  }
+  if (sum > shared && above_floor > 0) {
+    size_t excess = sum - shared;
+    for (auto &size : sizes) {
+      if (size > floor) {
+        auto cut = static_cast<size_t>(
+            std::ceil(static_cast<double>(size - floor) * static_cast<double>(excess) / above_floor));
+        size -= std::min(cut, size - floor);
+      }
+    }
+  }
+  Targets targets;
+  for (size_t i = 0; i < members_.size(); i++) {
+    targets.emplace_back(members_[i].bpm_, sizes[i]);
+  }
+  return targets;
+}
+
+void BufferPoolBudget::ApplyTargets(const Targets &targets, bool grow) {
+  // pools shrink first, the frames they give back make room for the ones that grow
+  for (auto &target : targets) {
+    size_t pool_size;
+    if (BeginResize(target.first, target.second, false, &pool_size)) {
+      if (!target.first->Resize(pool_size)) {
+        LOG(WARNING) << "Unable to shrink buffer pool to " << pool_size << " frames, retried on the next pass";
+      }
+      EndResize(target.first);
+    }
+  }
+  if (!grow) {
+    return;
+  }
+  for (auto &target : targets) {
+    size_t pool_size;
+    if (BeginResize(target.first, target.second, true, &pool_size)) {
+      target.first->Resize(pool_size);
+      EndResize(target.first);
+    }
+  }
+}
+
+bool BufferPoolBudget::BeginResize(BufferPoolManager *bpm, size_t target, bool grow, size_t *pool_size) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (resizing_.count(bpm) != 0 ||
+      std::none_of(members_.begin(), members_.end(), [bpm](const Member &member) { return member.bpm_ == bpm; })) {
+    return false;
+  }
+  size_t size = bpm->GetPoolSize();
+  size_t total = 0;
+  for (auto &member : members_) {
+    total += member.bpm_->GetPoolSize();
+  }
+  if (!grow) {
+    // small changes are skipped, unless the budget is exceeded
+    if (target >= size || (size - target < GetMinStep(size) && total <= GetShared())) {
+      return false;
+    }
+    *pool_size = target;
+  } else {
+    // only one pass grows pools at a time, so the room left in the budget is not given out twice
+    size_t growth = target > size ? std::min(target - size, GetShared() > total ? GetShared() - total : 0) : 0;
+    if (growth == 0 || growth < GetMinStep(size)) {
+      return false;
+    }
+    *pool_size = size + growth;
+  }
+  resizing_.insert(bpm);
+  return true;
+}
+
+void BufferPoolBudget::EndResize(BufferPoolManager *bpm) {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    resizing_.erase(bpm);
+  }
+  cv_.notify_all();
+}
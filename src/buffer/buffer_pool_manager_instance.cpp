@@ -0,0 +1,885 @@
+#include "buffer/buffer_pool_manager_instance.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+#include <unordered_map>
+
+#include "glog/logging.h"
+#include "page/bitmap_page.h"
+
+static const char EMPTY_PAGE_DATA[PAGE_SIZE] = {0};
+
+BufferPoolManagerInstance::FrameChunk::FrameChunk()
+    : metas_(std::make_unique<PageMeta[]>(FRAMES_PER_CHUNK)),
+      pages_(static_cast<Page *>(::operator new[](FRAMES_PER_CHUNK * sizeof(Page)))),
+      dirty_bits_(std::make_unique<std::atomic<uint64_t>[]>(DIRTY_WORDS_PER_CHUNK)) {
+  for (size_t i = 0; i < FRAMES_PER_CHUNK; i++) {
+    new (&pages_[i]) Page(nullptr, &metas_[i]);
+  }
+}
+
+BufferPoolManagerInstance::FrameChunk::~FrameChunk() {
+  for (size_t i = 0; i < FRAMES_PER_CHUNK; i++) {
+    pages_[i].~Page();
+  }
+  ::operator delete[](pages_);
+}
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
+                                                     size_t clean_frame_target, ReplacerPolicy policy)
+    : pool_size_(pool_size),
+      chunks_(std::make_unique<std::unique_ptr<FrameChunk>[]>(MAX_CHUNKS)),
+      disk_manager_(disk_manager),
+      replacer_(Replacer::Create(policy, pool_size)),
+      hits_record_access_(replacer_->ConcurrentRecordAccess()),
+      read_only_(disk_manager->IsReadOnly()),
+      clean_frame_target_(std::min(clean_frame_target, pool_size)) {
+  ASSERT(pool_size > 0 && pool_size <= MAX_CHUNKS * FRAMES_PER_CHUNK, "Invalid buffer pool size.");
+  page_tables_.emplace_back(std::make_unique<ConcurrentPageTable>(pool_size_));
+  page_table_.store(page_tables_.back().get());
+  AddFrames(0, pool_size_);
+  access_log_ = std::make_unique<std::atomic<frame_id_t>[]>(ACCESS_LOG_SIZE);
+  for (size_t i = 0; i < ACCESS_LOG_SIZE; i++) {
+    access_log_[i].store(INVALID_FRAME_ID, std::memory_order_relaxed);
+  }
+  // a read-only pool never has dirty pages
+  if (clean_frame_target_ > 0 && !read_only_) {
+    cleaner_ = std::thread(&BufferPoolManagerInstance::CleanerLoop, this);
+  }
+}
+
+BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  if (cleaner_.joinable()) {
+    {
+      std::scoped_lock<std::mutex> lock(cleaner_latch_);
+      stop_cleaner_ = true;
+    }
+    cleaner_cv_.notify_one();
+    cleaner_.join();
+  }
+  CompletePrefetches(true);
+  FlushAllPages();
+}
+
+/**
+ * TODO: Student Implement
+ */
+Page *BufferPoolManagerInstance::FetchPage(page_id_t page_id, BufferAccessStrategy *strategy) {
+  // 1.     Search the page table for the requested page (P).
+  // 1.1    If P exists, pin it and return it immediately.
+  // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
+  //        Note that pages are always found from the free list first.
+  // 2.     If R is dirty, write it back to the disk.
+  // 3.     Delete R from the page table and insert P.
+  // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
+  // 1.1 命中时不加锁
+  Page *page = TryPinResident(page_id);
+  if (page != nullptr) {
+    return page;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  // 加锁后再查一次，其他线程可能已经读入了 P
+  page = TryPinResident(page_id);
+  if (page != nullptr) {
+    return page;
+  }
+  // P 正在被预读
+  if (prefetching_.count(page_id) != 0) {
+    page = FinishPrefetch(page_id, 1);
+    if (page != nullptr) {
+      return page;
+    }
+  }
+  CompletePrefetches(false);
+  // 1.2 & 2 & 3
+  frame_id_t frame_id;
+  if (!FindFrame(&frame_id, strategy)) {
+    return nullptr;
+  }
+  page = GetPage(frame_id);
+  // 4
+  AssignFrame(frame_id, page_id, strategy);
+  if (read_only_) {
+    page->data_ = GetMappedData(page_id);
+  } else if (!TakeCompressed(page_id, page->data_)) {
+    disk_manager_->ReadPage(page_id, page->data_);
+  }
+  PublishFrame(frame_id, 1);
+  return page;
+}
+
+std::vector<Page *> BufferPoolManagerInstance::FetchPages(const std::vector<page_id_t> &page_ids) {
+  PendingFetch fetch;
+  SubmitFetches(page_ids, &fetch);
+  return CompleteFetches(&fetch);
+}
+
+void BufferPoolManagerInstance::SubmitFetches(const std::vector<page_id_t> &page_ids, PendingFetch *fetch) {
+  fetch->lock_ = std::unique_lock<std::recursive_mutex>(latch_);
+  std::vector<Page *> &pages = fetch->pages_;
+  pages.assign(page_ids.size(), nullptr);
+  auto &loading = fetch->loading_;
+  CompletePrefetches(false);
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    page_id_t page_id = page_ids[i];
+    auto it = loading.find(page_id);
+    if (it != loading.end()) {
+      it->second.second++;
+      pages[i] = GetPage(it->second.first);
+      continue;
+    }
+    pages[i] = TryPinResident(page_id);
+    if (pages[i] == nullptr && prefetching_.count(page_id) != 0) {
+      pages[i] = FinishPrefetch(page_id, 1);
+    }
+    if (pages[i] != nullptr) {
+      continue;
+    }
+    frame_id_t frame_id;
+    if (!FindFrame(&frame_id)) {
+      continue;
+    }
+    // the frame stays locked while its read is in flight, so it can neither be pinned nor picked as a victim
+    Page *page = GetPage(frame_id);
+    AssignFrame(frame_id, page_id, nullptr);
+    if (read_only_) {
+      page->data_ = GetMappedData(page_id);
+    } else if (!TakeCompressed(page_id, page->data_)) {
+      fetch->reads_.emplace_back(disk_manager_->ReadPageAsync(page_id, page->data_));
+    }
+    loading.emplace(page_id, std::make_pair(frame_id, 1));
+    pages[i] = page;
+  }
+}
+
+std::vector<Page *> BufferPoolManagerInstance::CompleteFetches(PendingFetch *fetch) {
+  for (auto &read : fetch->reads_) {
+    read.get();
+  }
+  for (auto &load : fetch->loading_) {
+    PublishFrame(load.second.first, load.second.second);
+  }
+  fetch->lock_.unlock();
+  return std::move(fetch->pages_);
+}
+
+void BufferPoolManagerInstance::Prefetch(const std::vector<page_id_t> &page_ids, BufferAccessStrategy *strategy) {
+  // pages of a read-only pool are served from the mapping of the db file, there is nothing to read
+  if (read_only_ || page_ids.empty()) {
+    return;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  CompletePrefetches(false);
+  for (auto page_id : page_ids) {
+    if (prefetching_.size() >= std::max<size_t>(pool_size_ / 4, 1)) {
+      break;
+    }
+    frame_id_t frame_id;
+    if (page_id == INVALID_PAGE_ID || GetPageTable()->Find(page_id, &frame_id) || prefetching_.count(page_id) != 0 ||
+        disk_manager_->IsPageFree(page_id)) {
+      continue;
+    }
+    if (!FindFrame(&frame_id, strategy)) {
+      break;
+    }
+    // the frame stays locked until the read is completed and the frame is published
+    Page *page = GetPage(frame_id);
+    AssignFrame(frame_id, page_id, strategy);
+    if (TakeCompressed(page_id, page->data_)) {
+      PublishFrame(frame_id, 0);
+      continue;
+    }
+    prefetching_.emplace(page_id, std::make_pair(frame_id, disk_manager_->ReadPageAsync(page_id, page->data_)));
+  }
+}
+
+Page *BufferPoolManagerInstance::FinishPrefetch(page_id_t page_id, int pin_count) {
+  auto it = prefetching_.find(page_id);
+  frame_id_t frame_id = it->second.first;
+  bool success = it->second.second.get();
+  prefetching_.erase(it);
+  if (!success) {
+    GetMeta(frame_id)->page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+    free_list_.push_back(frame_id);
+    return nullptr;
+  }
+  PublishFrame(frame_id, pin_count);
+  return GetPage(frame_id);
+}
+
+void BufferPoolManagerInstance::CompletePrefetches(bool wait) {
+  std::vector<page_id_t> completed;
+  for (auto &prefetch : prefetching_) {
+    if (wait || prefetch.second.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      completed.push_back(prefetch.first);
+    }
+  }
+  for (auto page_id : completed) {
+    FinishPrefetch(page_id, 0);
+  }
+}
+
+void BufferPoolManagerInstance::ReleaseReservation(ExtentReservation *reservation) {
+  disk_manager_->ReleaseReservation(reservation);
+}
+
+/**
+ * TODO: Student Implement
+ */
+Page *BufferPoolManagerInstance::NewPage(page_id_t &page_id, ExtentReservation *reservation,
+                                         BufferAccessStrategy *strategy) {
+  if (read_only_) {
+    LOG(ERROR) << "Unable to create page: buffer pool is read-only";
+    page_id = INVALID_PAGE_ID;
+    return nullptr;
+  }
+  // 0.   Make sure you call AllocatePage!
+  // 1.   If all the pages in the buffer pool are pinned, return nullptr.
+  // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
+  // 3.   Update P's metadata, zero out memory and add P to the page table.
+  // 4.   Set the page ID output parameter. Return a pointer to P.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  CompletePrefetches(false);
+  frame_id_t frame_id;
+  if (!FindFrame(&frame_id, strategy)) {
+    page_id = INVALID_PAGE_ID;
+    return nullptr;
+  }
+  // 分配新的 page_id
+  page_id = reservation == nullptr ? AllocatePage() : disk_manager_->AllocatePage(reservation);
+  if (page_id == INVALID_PAGE_ID) {
+    free_list_.push_back(frame_id);
+    return nullptr;
+  }
+  if (!DropStaleCopy(page_id)) {
+    free_list_.push_back(frame_id);
+    DeallocatePage(page_id);
+    page_id = INVALID_PAGE_ID;
+    return nullptr;
+  }
+  Page *page = GetPage(frame_id);
+  page->ResetMemory();
+  AssignFrame(frame_id, page_id, strategy);
+  PublishFrame(frame_id, 1);
+  return page;
+}
+
+Page *BufferPoolManagerInstance::CreatePage(page_id_t page_id, BufferAccessStrategy *strategy) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  CompletePrefetches(false);
+  frame_id_t frame_id;
+  if (!FindFrame(&frame_id, strategy)) {
+    return nullptr;
+  }
+  if (!DropStaleCopy(page_id)) {
+    free_list_.push_back(frame_id);
+    return nullptr;
+  }
+  Page *page = GetPage(frame_id);
+  page->ResetMemory();
+  AssignFrame(frame_id, page_id, strategy);
+  PublishFrame(frame_id, 1);
+  return page;
+}
+
+Page *BufferPoolManagerInstance::TryPinResident(page_id_t page_id) {
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id)) {
+    return nullptr;
+  }
+  Page *page = GetPage(frame_id);
+  PageMeta *meta = GetMeta(frame_id);
+  int pin_count = meta->pin_count_.load(std::memory_order_relaxed);
+  do {
+    if (pin_count < 0) {  // the frame is free or being evicted
+      return nullptr;
+    }
+  } while (!meta->pin_count_.compare_exchange_weak(pin_count, pin_count + 1, std::memory_order_acquire));
+  // the frame may have been given to another page between the lookup and the pin
+  if (meta->page_id_.load(std::memory_order_relaxed) != page_id) {
+    meta->pin_count_.fetch_sub(1, std::memory_order_release);
+    return nullptr;
+  }
+  if (hits_record_access_) {
+    // e.g. CLOCK only sets the reference bit of the frame
+    replacer_->RecordAccess(frame_id);
+  } else if (!meta->ref_.load(std::memory_order_relaxed) && !meta->ref_.exchange(true, std::memory_order_relaxed)) {
+    // only the first hit after the replacer has seen the frame is logged, a full log is retried by the next hit
+    if (!LogAccess(frame_id)) {
+      meta->ref_.store(false, std::memory_order_relaxed);
+    }
+  }
+  return page;
+}
+
+bool BufferPoolManagerInstance::LogAccess(frame_id_t frame_id) {
+  size_t tail = access_log_tail_.load(std::memory_order_relaxed);
+  do {
+    if (tail - access_log_head_.load(std::memory_order_acquire) >= ACCESS_LOG_SIZE) {
+      return false;
+    }
+  } while (!access_log_tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed));
+  access_log_[tail % ACCESS_LOG_SIZE].store(frame_id, std::memory_order_release);
+  return true;
+}
+
+void BufferPoolManagerInstance::DrainAccessLog() {
+  size_t head = access_log_head_.load(std::memory_order_relaxed);
+  size_t tail = access_log_tail_.load(std::memory_order_acquire);
+  for (; head != tail; head++) {
+    auto &slot = access_log_[head % ACCESS_LOG_SIZE];
+    frame_id_t frame_id;
+    // the slot is claimed, but the hit may not have written it yet
+    while ((frame_id = slot.exchange(INVALID_FRAME_ID, std::memory_order_acquire)) == INVALID_FRAME_ID) {
+      std::this_thread::yield();
+    }
+    // the frame may hold another page by now, which then gets the access, the replacer only loses a little precision
+    GetMeta(frame_id)->ref_.store(false, std::memory_order_relaxed);
+    replacer_->RecordAccess(frame_id);
+  }
+  access_log_head_.store(head, std::memory_order_release);
+}
+
+bool BufferPoolManagerInstance::FindFrame(frame_id_t *frame_id, BufferAccessStrategy *strategy) {
+  if (strategy != nullptr) {
+    page_id_t ring_page_id;
+    frame_id_t ring_frame_id = strategy->GetCurrentFrame(this, pool_size_, &ring_page_id);
+    // the frame may have been evicted and given to another page since the ring used it
+    int unpinned = 0;
+    if (ring_frame_id != INVALID_FRAME_ID &&
+        GetMeta(ring_frame_id)->page_id_.load(std::memory_order_relaxed) == ring_page_id &&
+        !IsWritingBack(ring_frame_id) &&
+        GetMeta(ring_frame_id)->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire)) {
+      replacer_->Pin(ring_frame_id);
+      EvictFrame(ring_frame_id, false);
+      *frame_id = ring_frame_id;
+      return true;
+    }
+  }
+  if (free_list_.size() <= clean_frame_target_ && cleaner_.joinable()) {
+    cleaner_cv_.notify_one();
+  }
+  DrainAccessLog();
+  if (!free_list_.empty()) {  // 内存还空着
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    num_misses_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  // the victim is locked as soon as it is picked, pinned frames and the frames being written back are skipped
+  auto evictable = [this](frame_id_t candidate) {
+    int unpinned = 0;
+    return !IsWritingBack(candidate) &&
+           GetMeta(candidate)->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire);
+  };
+  if (!replacer_->VictimIf(frame_id, evictable)) {
+    return false;  // 所有页都被 pin 住
+  }
+  EvictFrame(*frame_id);
+  num_misses_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void BufferPoolManagerInstance::AssignFrame(frame_id_t frame_id, page_id_t page_id, BufferAccessStrategy *strategy) {
+  PageMeta *meta = GetMeta(frame_id);
+  meta->page_id_.store(page_id, std::memory_order_relaxed);
+  TakeDirty(frame_id);
+  if (strategy != nullptr) {
+    strategy->Remember(this, frame_id, page_id);
+  }
+}
+
+void BufferPoolManagerInstance::EvictFrame(frame_id_t frame_id, bool keep_compressed) {
+  PageMeta *meta = GetMeta(frame_id);
+  page_id_t old_page_id = meta->page_id_.load(std::memory_order_relaxed);
+  bool written = TakeDirty(frame_id);
+  if (written) {  // 有可能是脏页
+    disk_manager_->WritePage(old_page_id, GetPage(frame_id)->data_);
+  }
+  // the page matches the db file now, a later miss can take it from the second tier
+  if (keep_compressed && compressed_cache_ != nullptr) {
+    compressed_cache_->Put(old_page_id, GetPage(frame_id)->data_, written, this);
+  }
+  GetPageTable()->Erase(old_page_id);  // 善后
+  meta->page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+}
+
+bool BufferPoolManagerInstance::DropStaleCopy(page_id_t page_id) {
+  if (compressed_cache_ != nullptr) {
+    compressed_cache_->Erase(page_id);
+  }
+  if (prefetching_.count(page_id) != 0) {
+    FinishPrefetch(page_id, 0);
+  }
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id)) {
+    return true;
+  }
+  // only the warmer may still pin a page that was free, the wait for it or for a write back is left to the caller
+  PageMeta *meta = GetMeta(frame_id);
+  int unpinned = 0;
+  if (IsWritingBack(frame_id) ||
+      !meta->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire)) {
+    LOG(WARNING) << "Stale copy of page " << page_id << " is still in use";
+    return false;
+  }
+  replacer_->Pin(frame_id);
+  GetPageTable()->Erase(page_id);
+  meta->page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+  TakeDirty(frame_id);
+  free_list_.push_back(frame_id);
+  return true;
+}
+
+void BufferPoolManagerInstance::PublishFrame(frame_id_t frame_id, int pin_count) {
+  PageMeta *meta = GetMeta(frame_id);
+  meta->ref_.store(false, std::memory_order_relaxed);
+  // the release store makes page id and data visible to the hits that pin the frame
+  meta->pin_count_.store(pin_count, std::memory_order_release);
+  page_id_t page_id = meta->page_id_.load(std::memory_order_relaxed);
+  GetPageTable()->Insert(page_id, frame_id);
+  replacer_->Admit(frame_id, page_id);
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::DeletePage(page_id_t page_id) {
+  if (read_only_) {
+    LOG(ERROR) << "Unable to delete page " << page_id << ": buffer pool is read-only";
+    return false;
+  }
+  // 0.   Make sure you call DeallocatePage!
+  // 1.   Search the page table for the requested page (P).
+  // 1.   If P does not exist, return true.
+  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+  // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  if (compressed_cache_ != nullptr) {
+    compressed_cache_->Erase(page_id);
+  }
+  if (prefetching_.count(page_id) != 0) {
+    FinishPrefetch(page_id, 0);
+  }
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id)) {
+    DeallocatePage(page_id);  // 说明已经被替换掉，那就直接删除
+    return true;
+  }
+  PageMeta *meta = GetMeta(frame_id);
+  // the cleaner or a checkpoint may be writing the page, they do not need the latch to finish
+  while (IsWritingBack(frame_id)) {
+    std::this_thread::yield();
+  }
+  int unpinned = 0;
+  if (!meta->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire)) {
+    LOG(ERROR) << "Unable to delete page " << page_id << ": pin count = " << unpinned << endl;
+    return false;
+  }
+  replacer_->Pin(frame_id);    // 需要将其从 replacer 中删除
+  GetPageTable()->Erase(page_id);  // 删除元信息
+  meta->page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+  TakeDirty(frame_id);
+  free_list_.push_back(frame_id);  // 释放内存，空闲帧保持锁定
+  DeallocatePage(page_id);
+  return true;
+}
+
+bool BufferPoolManagerInstance::EvictPage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  if (compressed_cache_ != nullptr) {
+    compressed_cache_->Erase(page_id);
+  }
+  if (prefetching_.count(page_id) != 0) {
+    FinishPrefetch(page_id, 0);
+  }
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id)) {
+    return true;
+  }
+  PageMeta *meta = GetMeta(frame_id);
+  while (IsWritingBack(frame_id)) {
+    std::this_thread::yield();
+  }
+  int unpinned = 0;
+  if (!meta->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire)) {
+    LOG(ERROR) << "Unable to evict page " << page_id << ": pin count = " << unpinned << endl;
+    return false;
+  }
+  replacer_->Pin(frame_id);
+  EvictFrame(frame_id, false);
+  free_list_.push_back(frame_id);  // the free frame stays locked
+  return true;
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::UnpinPage(page_id_t page_id, bool is_dirty) {
+  // the caller holds a pin, so the frame cannot change its page, only the lookup may need the latch
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id) ||
+      GetMeta(frame_id)->page_id_.load(std::memory_order_relaxed) != page_id) {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    if (!GetPageTable()->Find(page_id, &frame_id)) {
+      LOG(ERROR) << "Page not in buffer pool: " << page_id << endl;
+      return false;
+    }
+  }
+  PageMeta *meta = GetMeta(frame_id);
+  // LOG(INFO) << "Unpin page: " << page_id << ", pin count: " << meta->pin_count_ << endl;
+  bool modified_read_only = read_only_ && is_dirty;
+  if (modified_read_only) {
+    LOG(ERROR) << "Page " << page_id << " modified in read-only buffer pool";
+  }
+  // the dirty flag has to be set before the pin is dropped, an evicting thread checks it right after
+  if (is_dirty && !read_only_) {
+    MarkDirty(frame_id);
+  }
+  int pin_count = meta->pin_count_.load(std::memory_order_relaxed);
+  do {
+    if (pin_count <= 0) {
+      LOG(ERROR) << "Unable to unpin page " << page_id << ": pin count = " << pin_count << endl;
+      return false;
+    }
+  } while (!meta->pin_count_.compare_exchange_weak(pin_count, pin_count - 1, std::memory_order_release));
+  return !modified_read_only;
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::FlushPage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  frame_id_t frame_id;
+  if (!GetPageTable()->Find(page_id, &frame_id)) {
+    // LOG(ERROR) << "Cannot flush page " << page_id << ": not found" << endl;
+    return false;
+  }
+  Page *page = GetPage(frame_id);
+  if (TakeDirty(frame_id)) {
+    disk_manager_->WritePage(page_id, page->data_);
+  }
+  return true;
+}
+
+void BufferPoolManagerInstance::FlushAllPages() { FlushDirtyPages({this}); }
+
+size_t BufferPoolManagerInstance::FlushDirtyPages(const std::vector<BufferPoolManagerInstance *> &instances) {
+  if (instances.empty() || instances.front()->read_only_) {
+    return 0;
+  }
+  // page id, instance and frame of the frames whose bit is set
+  std::vector<std::tuple<page_id_t, size_t, frame_id_t>> dirty_frames;
+  for (size_t instance_id = 0; instance_id < instances.size(); instance_id++) {
+    auto *instance = instances[instance_id];
+    std::scoped_lock<std::recursive_mutex> lock(instance->latch_);
+    size_t pool_size = instance->pool_size_.load(std::memory_order_relaxed);
+    for (size_t chunk_id = 0; chunk_id * FRAMES_PER_CHUNK < pool_size; chunk_id++) {
+      for (size_t word = 0; word < DIRTY_WORDS_PER_CHUNK; word++) {
+        uint64_t bits = instance->chunks_[chunk_id]->dirty_bits_[word].load(std::memory_order_acquire);
+        for (; bits != 0; bits &= bits - 1) {
+          size_t frame_id = chunk_id * FRAMES_PER_CHUNK + word * 64 + __builtin_ctzll(bits);
+          if (frame_id >= pool_size) {
+            break;
+          }
+          page_id_t page_id = instance->GetMeta(frame_id)->page_id_.load(std::memory_order_relaxed);
+          if (page_id != INVALID_PAGE_ID) {
+            dirty_frames.emplace_back(page_id, instance_id, frame_id);
+          }
+        }
+      }
+    }
+  }
+  // page ids map to offsets in the same order, so every batch covers a stretch of the db file, whichever instances
+  // its pages are in
+  std::sort(dirty_frames.begin(), dirty_frames.end());
+  DiskManager *disk_manager = instances.front()->disk_manager_;
+  size_t num_written = 0;
+  AlignedPageBuffer copies(DiskManager::AllocateAlignedPages(CHECKPOINT_BATCH_SIZE));
+  std::vector<std::pair<page_id_t, const char *>> batch;
+  std::vector<size_t> marked;
+  for (size_t begin = 0; begin < dirty_frames.size(); begin += CHECKPOINT_BATCH_SIZE) {
+    size_t end = std::min(begin + CHECKPOINT_BATCH_SIZE, dirty_frames.size());
+    // the frames of the batch are marked first, with one short hold of the latch of each instance. A marked frame is
+    // not evicted or resized away until its copy is on disk, otherwise a miss could read the old page back.
+    marked.clear();
+    for (size_t instance_id = 0; instance_id < instances.size(); instance_id++) {
+      auto *instance = instances[instance_id];
+      std::scoped_lock<std::recursive_mutex> lock(instance->latch_);
+      for (size_t i = begin; i < end; i++) {
+        auto [page_id, frame_instance_id, frame_id] = dirty_frames[i];
+        // a page evicted in the meantime has been written by the eviction
+        if (frame_instance_id == instance_id &&
+            instance->GetMeta(frame_id)->page_id_.load(std::memory_order_relaxed) == page_id) {
+          instance->GetMeta(frame_id)->write_back_.store(true, std::memory_order_relaxed);
+          marked.push_back(i);
+        }
+      }
+    }
+    // the read latch keeps writers out while a page is copied, so no half-updated page is written and reported clean
+    batch.clear();
+    for (auto i : marked) {
+      auto [page_id, instance_id, frame_id] = dirty_frames[i];
+      auto *instance = instances[instance_id];
+      Page *page = instance->GetPage(frame_id);
+      page->RLatch();
+      if (instance->TakeDirty(frame_id)) {
+        char *copy = copies.get() + batch.size() * PAGE_SIZE;
+        memcpy(copy, page->data_, PAGE_SIZE);
+        batch.emplace_back(page_id, copy);
+      }
+      page->RUnlatch();
+    }
+    // no latch of the pools is held during the write, misses only skip the marked frames
+    disk_manager->WritePages(batch);
+    for (auto i : marked) {
+      auto [page_id, instance_id, frame_id] = dirty_frames[i];
+      instances[instance_id]->GetMeta(frame_id)->write_back_.store(false, std::memory_order_release);
+    }
+    num_written += batch.size();
+  }
+  // a page taken by a cleaner is still being written, it has to be on disk before the caller syncs
+  for (auto *instance : instances) {
+    while (instance->cleaning_frame_.load() != INVALID_FRAME_ID) {
+      std::this_thread::yield();
+    }
+  }
+  return num_written;
+}
+
+void BufferPoolManagerInstance::Sync() {
+  FlushAllPages();
+  // the pages allocated since the last checkpoint are only marked in the bitmaps in memory
+  disk_manager_->Checkpoint();
+  disk_manager_->Sync();
+}
+
+size_t BufferPoolManagerInstance::Checkpoint() {
+  size_t num_written = FlushDirtyPages({this});
+  disk_manager_->Checkpoint();
+  disk_manager_->Sync();
+  return num_written;
+}
+
+size_t BufferPoolManagerInstance::CleanFrames() {
+  std::vector<frame_id_t> dirty_frames;
+  {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    size_t ready = free_list_.size();
+    if (ready >= clean_frame_target_) {
+      return 0;
+    }
+    DrainAccessLog();
+    std::vector<frame_id_t> victims;
+    replacer_->PeekVictims(4 * clean_frame_target_, &victims);
+    for (auto frame_id : victims) {
+      if (ready + dirty_frames.size() >= clean_frame_target_) {
+        break;
+      }
+      // pinned frames and frames with an access not drained yet are not evicted next
+      PageMeta *meta = GetMeta(frame_id);
+      if (meta->pin_count_.load(std::memory_order_relaxed) != 0 || meta->ref_.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      if (meta->is_dirty_.load(std::memory_order_relaxed)) {
+        dirty_frames.push_back(frame_id);
+      } else {
+        ready++;
+      }
+    }
+  }
+  // pages are written one at a time outside of the latch, so misses never wait for the cleaner
+  size_t num_written = 0;
+  for (auto frame_id : dirty_frames) {
+    Page *page = GetPage(frame_id);
+    page_id_t page_id;
+    {
+      std::scoped_lock<std::recursive_mutex> lock(latch_);
+      page_id = page->GetPageId();
+      if (page_id == INVALID_PAGE_ID || page->GetPinCount() < 0 || !page->IsDirty()) {
+        continue;
+      }
+      cleaning_frame_.store(frame_id);
+    }
+    // the read latch keeps writers out while the page is copied to disk
+    page->RLatch();
+    if (TakeDirty(frame_id)) {
+      disk_manager_->WritePage(page_id, page->data_);
+      num_written++;
+    }
+    page->RUnlatch();
+    cleaning_frame_.store(INVALID_FRAME_ID);
+  }
+  return num_written;
+}
+
+void BufferPoolManagerInstance::CleanerLoop() {
+  std::unique_lock<std::mutex> lock(cleaner_latch_);
+  while (!stop_cleaner_) {
+    lock.unlock();
+    CleanFrames();
+    lock.lock();
+    // woken up early by a miss that finds too few free frames
+    cleaner_cv_.wait_for(lock, CLEANER_INTERVAL);
+  }
+}
+
+bool BufferPoolManagerInstance::Resize(size_t pool_size) {
+  if (pool_size == 0 || pool_size > MAX_CHUNKS * FRAMES_PER_CHUNK) {
+    LOG(ERROR) << "Invalid buffer pool size: " << pool_size;
+    return false;
+  }
+  std::unique_lock<std::recursive_mutex> lock(latch_);
+  size_t old_size = pool_size_.load(std::memory_order_relaxed);
+  if (pool_size > old_size) {
+    if (pool_size > GetPageTable()->GetMaxFrames()) {
+      // hits that already loaded the old table still find the pages there, the frame is checked after pinning anyway
+      auto page_table = std::make_unique<ConcurrentPageTable>(pool_size);
+      GetPageTable()->CopyTo(page_table.get());
+      page_table_.store(page_table.get(), std::memory_order_release);
+      page_tables_.push_back(std::move(page_table));
+    }
+    replacer_->Resize(pool_size);
+    AddFrames(old_size, pool_size);
+  } else if (pool_size < old_size) {
+    std::vector<frame_id_t> taken;
+    auto deadline = std::chrono::steady_clock::now() + RESIZE_TIMEOUT;
+    while (true) {
+      // frames of prefetched pages stay locked until they are published
+      CompletePrefetches(true);
+      if (TakeFrames(pool_size, old_size, &taken)) {
+        break;
+      }
+      if (std::chrono::steady_clock::now() >= deadline) {
+        free_list_.insert(free_list_.end(), taken.begin(), taken.end());
+        LOG(ERROR) << "Unable to shrink buffer pool to " << pool_size << " frames: pages are pinned";
+        return false;
+      }
+      // the threads holding the pins may need the latch before they can drop them
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      lock.lock();
+    }
+    replacer_->Resize(pool_size);
+    // the data of chunks without frames is given back, their descriptors stay for hits that still look at them
+    for (size_t chunk_id = (pool_size + FRAMES_PER_CHUNK - 1) / FRAMES_PER_CHUNK;
+         chunk_id * FRAMES_PER_CHUNK < old_size; chunk_id++) {
+      FrameChunk *chunk = chunks_[chunk_id].get();
+      for (size_t i = 0; i < FRAMES_PER_CHUNK; i++) {
+        chunk->pages_[i].data_ = nullptr;
+      }
+      chunk->arena_.reset();
+    }
+  }
+  if (clean_frame_target_ > 0) {
+    clean_frame_target_ = std::max<size_t>(clean_frame_target_ * pool_size / old_size, 1);
+  }
+  pool_size_.store(pool_size, std::memory_order_relaxed);
+  return true;
+}
+
+void BufferPoolManagerInstance::GetResidentPages(std::vector<page_id_t> *page_ids) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  DrainAccessLog();
+  std::vector<frame_id_t> victims;
+  replacer_->PeekVictims(pool_size_, &victims);
+  for (auto it = victims.rbegin(); it != victims.rend(); ++it) {
+    page_id_t page_id = GetMeta(*it)->page_id_.load(std::memory_order_relaxed);
+    if (page_id != INVALID_PAGE_ID) {
+      page_ids->push_back(page_id);
+    }
+  }
+}
+
+void BufferPoolManagerInstance::AddFrames(size_t begin, size_t end) {
+  for (size_t chunk_id = begin / FRAMES_PER_CHUNK; chunk_id * FRAMES_PER_CHUNK < end; chunk_id++) {
+    auto &chunk = chunks_[chunk_id];
+    if (chunk == nullptr) {
+      chunk = std::make_unique<FrameChunk>();
+    }
+    // a read-only pool only needs the page descriptors, their data points into the mapping of the db file
+    if (chunk->arena_ == nullptr && !read_only_) {
+      chunk->arena_ = std::make_unique<FrameArena>(FRAMES_PER_CHUNK);
+      for (size_t i = 0; i < FRAMES_PER_CHUNK; i++) {
+        chunk->pages_[i].data_ = chunk->arena_->GetFrame(i);
+      }
+    }
+  }
+  for (size_t i = begin; i < end; i++) {
+    PageMeta *meta = GetMeta(i);
+    meta->pin_count_.store(FRAME_LOCKED, std::memory_order_relaxed);
+    meta->page_id_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+    TakeDirty(i);
+    meta->ref_.store(false, std::memory_order_relaxed);
+    free_list_.emplace_back(i);
+  }
+}
+
+bool BufferPoolManagerInstance::TakeFrames(size_t begin, size_t end, std::vector<frame_id_t> *taken) {
+  for (auto it = free_list_.begin(); it != free_list_.end();) {
+    if (static_cast<size_t>(*it) >= begin) {
+      taken->push_back(*it);
+      it = free_list_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  bool all_taken = true;
+  for (size_t i = begin; i < end; i++) {
+    auto frame_id = static_cast<frame_id_t>(i);
+    PageMeta *meta = GetMeta(frame_id);
+    // frames taken before are locked without a page
+    page_id_t page_id = meta->page_id_.load(std::memory_order_relaxed);
+    if (page_id == INVALID_PAGE_ID) {
+      continue;
+    }
+    // the cleaner or a checkpoint may be writing the page, they do not need the latch to finish
+    while (IsWritingBack(frame_id)) {
+      std::this_thread::yield();
+    }
+    int unpinned = 0;
+    if (!meta->pin_count_.compare_exchange_strong(unpinned, FRAME_LOCKED, std::memory_order_acquire)) {
+      all_taken = false;
+      continue;
+    }
+    replacer_->Pin(frame_id);
+    EvictFrame(frame_id);
+    taken->push_back(frame_id);
+  }
+  return all_taken;
+}
+
+char *BufferPoolManagerInstance::GetMappedData(page_id_t page_id) {
+  const char *data = disk_manager_->GetPageAddress(page_id);
+  // pages beyond the end of file read as zeros, the shared empty page is read-only as well
+  return const_cast<char *>(data != nullptr ? data : EMPTY_PAGE_DATA);
+}
+
+page_id_t BufferPoolManagerInstance::AllocatePage() {
+  page_id_t next_page_id = disk_manager_->AllocatePage();
+  return next_page_id;
+}
+
+void BufferPoolManagerInstance::DeallocatePage(__attribute__((unused)) page_id_t page_id) {
+  disk_manager_->DeAllocatePage(page_id);
+}
+
+bool BufferPoolManagerInstance::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
+
+// Only used for debug
+bool BufferPoolManagerInstance::CheckAllUnpinned() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  bool res = true;
+  for (size_t i = 0; i < pool_size_; i++) {
+    int pin_count = GetMeta(i)->pin_count_.load(std::memory_order_relaxed);
+    if (pin_count > 0) {
+      res = false;
+      LOG(ERROR) << "page " << GetMeta(i)->page_id_.load(std::memory_order_relaxed) << " pin count:" << pin_count
+                 << endl;
+    }
+  }
+  return res;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "buffer/buffer_pool_set.h"
+
+#include <algorithm>
+
+BufferPoolSet::BufferPoolSet(BufferPoolManager *default_pool, BufferPoolManager *keep_pool,
+                             BufferPoolManager *recycle_pool)
+    : pools_{default_pool, keep_pool == nullptr ? default_pool : keep_pool,
+             recycle_pool == nullptr ? default_pool : recycle_pool} {}
+
+bool BufferPoolSet::EvictPages(const std::vector<page_id_t> &page_ids) {
+  bool res = true;
+  for (auto pool : GetDistinctPools()) {
+    for (auto page_id : page_ids) {
+      res &= pool->EvictPage(page_id);
+    }
+  }
+  return res;
+}
+
+void BufferPoolSet::Sync() {
+  // the pools share the db file, one sync after the last write covers all of them
+  auto pools = GetDistinctPools();
+  for (size_t i = 1; i < pools.size(); i++) {
+    pools[i]->FlushAllPages();
+  }
+  pools[0]->Sync();
+}
+
+size_t BufferPoolSet::Checkpoint() {
+  size_t num_written = 0;
+  for (auto pool : GetDistinctPools()) {
+    num_written += pool->Checkpoint();
+  }
+  return num_written;
+}
+
+void BufferPoolSet::SetCompressedCache(CompressedPageCache *cache) {
+  for (auto pool : GetDistinctPools()) {
+    pool->SetCompressedCache(cache);
+  }
+}
+
+bool BufferPoolSet::ParsePoolName(const std::string &name, BufferPoolId *pool_id) {
+  for (uint32_t i = 0; i < NUM_POOLS; i++) {
+    if (name == GetPoolName(static_cast<BufferPoolId>(i))) {
+      *pool_id = static_cast<BufferPoolId>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+const char *BufferPoolSet::GetPoolName(BufferPoolId pool_id) {
+  static const char *names[NUM_POOLS] = {"default", "keep", "recycle"};
+  return names[static_cast<uint32_t>(pool_id)];
+}
+
+std::vector<BufferPoolManager *> BufferPoolSet::GetDistinctPools() const {
+  std::vector<BufferPoolManager *> pools;
+  for (auto pool : pools_) {
+    if (std::find(pools.begin(), pools.end(), pool) == pools.end()) {
+      pools.push_back(pool);
+    }
+  }
+  return pools;
+}
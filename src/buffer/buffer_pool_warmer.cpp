@@ -0,0 +1,130 @@
+#include "buffer/buffer_pool_warmer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "glog/logging.h"
+
+BufferPoolWarmer::BufferPoolWarmer(BufferPoolManager *bpm, std::string file_name,
+                                   std::chrono::milliseconds save_interval)
+    : bpm_(bpm), file_name_(std::move(file_name)), save_interval_(save_interval) {
+  thread_ = std::thread(&BufferPoolWarmer::Run, this);
+}
+
+BufferPoolWarmer::~BufferPoolWarmer() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+  Save();
+}
+
+bool BufferPoolWarmer::Save() {
+  std::vector<page_id_t> page_ids;
+  bpm_->GetResidentPages(&page_ids);
+  return WritePageList(file_name_, page_ids);
+}
+
+size_t BufferPoolWarmer::WaitForLoad() {
+  std::unique_lock<std::mutex> lock(latch_);
+  cv_.wait(lock, [this] { return loaded_; });
+  return num_loaded_;
+}
+
+void BufferPoolWarmer::Run() {
+  size_t num_loaded = Load();
+  std::unique_lock<std::mutex> lock(latch_);
+  loaded_ = true;
+  num_loaded_ = num_loaded;
+  cv_.notify_all();
+  while (!cv_.wait_for(lock, save_interval_, [this] { return stop_; })) {
+    lock.unlock();
+    if (!Save()) {
+      LOG(WARNING) << "Unable to write page list " << file_name_;
+    }
+    lock.lock();
+  }
+}
+
+size_t BufferPoolWarmer::Load() {
+  std::vector<page_id_t> page_ids;
+  if (!ReadPageList(file_name_, &page_ids)) {
+    return 0;
+  }
+  // the list starts with the pages worth keeping most, only as many as fit are loaded
+  size_t pool_size = bpm_->GetPoolSize();
+  if (page_ids.size() > pool_size) {
+    page_ids.resize(pool_size);
+  }
+  // pages freed after the list was written are skipped, the others are read in file order
+  page_ids.erase(std::remove_if(page_ids.begin(), page_ids.end(),
+                                [this](page_id_t page_id) { return page_id < 0 || bpm_->IsPageFree(page_id); }),
+                 page_ids.end());
+  std::sort(page_ids.begin(), page_ids.end());
+  page_ids.erase(std::unique(page_ids.begin(), page_ids.end()), page_ids.end());
+  size_t batch_size = std::max<size_t>(std::min(LOAD_BATCH_SIZE, pool_size / 4), 1);
+  size_t num_loaded = 0;
+  for (size_t begin = 0; begin < page_ids.size(); begin += batch_size) {
+    {
+      std::scoped_lock<std::mutex> lock(latch_);
+      if (stop_) {
+        break;
+      }
+    }
+    std::vector<page_id_t> batch(page_ids.begin() + begin,
+                                 page_ids.begin() + std::min(begin + batch_size, page_ids.size()));
+    auto pages = bpm_->FetchPages(batch);
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (pages[i] != nullptr) {
+        bpm_->UnpinPage(batch[i], false);
+        num_loaded++;
+      }
+    }
+  }
+  return num_loaded;
+}
+
+std::string BufferPoolWarmer::GetFileName(const std::string &db_file_name) {
+  size_t slash = db_file_name.find_last_of('/');
+  size_t name_begin = slash == std::string::npos ? 0 : slash + 1;
+  return db_file_name.substr(0, name_begin) + "." + db_file_name.substr(name_begin) + ".warmup";
+}
+
+bool BufferPoolWarmer::WritePageList(const std::string &file_name, const std::vector<page_id_t> &page_ids) {
+  // the list is written to a temporary file first, a crash in between leaves the old list
+  std::string tmp_file_name = file_name + ".tmp";
+  {
+    std::ofstream out(tmp_file_name, std::ios::binary | std::ios::trunc);
+    uint32_t header[2] = {MAGIC, static_cast<uint32_t>(page_ids.size())};
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(page_ids.data()),
+              static_cast<std::streamsize>(page_ids.size() * sizeof(page_id_t)));
+    if (!out.good()) {
+      out.close();
+      remove(tmp_file_name.c_str());
+      return false;
+    }
+  }
+  return rename(tmp_file_name.c_str(), file_name.c_str()) == 0;
+}
+
+bool BufferPoolWarmer::ReadPageList(const std::string &file_name, std::vector<page_id_t> *page_ids) {
+  std::ifstream in(file_name, std::ios::binary | std::ios::ate);
+  auto file_size = static_cast<size_t>(std::max<std::streamoff>(in.tellg(), 0));
+  in.seekg(0);
+  uint32_t header[2];
+  if (!in.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != MAGIC ||
+      file_size != sizeof(header) + header[1] * sizeof(page_id_t)) {
+    return false;
+  }
+  page_ids->resize(header[1]);
+  if (!in.read(reinterpret_cast<char *>(page_ids->data()),
+               static_cast<std::streamsize>(page_ids->size() * sizeof(page_id_t)))) {
+    page_ids->clear();
+    return false;
+  }
+  return true;
+}
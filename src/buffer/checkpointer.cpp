@@ -0,0 +1,30 @@
+#include "buffer/checkpointer.h"
+
+Checkpointer::Checkpointer(BufferPoolSet *pools, std::chrono::milliseconds interval)
+    : pools_(pools), interval_(interval) {
+  thread_ = std::thread(&Checkpointer::Run, this);
+}
+
+Checkpointer::~Checkpointer() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+size_t Checkpointer::GetNumCheckpoints() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return num_checkpoints_;
+}
+
+void Checkpointer::Run() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (!cv_.wait_for(lock, interval_, [this] { return stop_; })) {
+    lock.unlock();
+    pools_->Checkpoint();
+    lock.lock();
+    num_checkpoints_++;
+  }
+}
@@ -1,100 +1,123 @@
-#include "buffer/clock_replacer.h"
-#include <ostream>
-#include "glog/logging.h"
-
-CLOCKReplacer::CLOCKReplacer(size_t num_pages)
-    : capacity(0), clock_list_(num_pages, make_pair(false, false)), clock_hand_(0) {}
-
-CLOCKReplacer::~CLOCKReplacer() = default;
-
-/**
- * TODO: Student Implement
- */
-bool CLOCKReplacer::Victim(frame_id_t *frame_id) {
-  // 空表，直接返回
-  if (capacity == 0) {
-    LOG(INFO) << "CLOCKReplacer is empty" << std::endl;
-    return false;
-  }
-
-  // 确保时钟指针有效（若无效则重置到数组头部）
-  if (clock_hand_ == clock_list_.size()) {
-    clock_hand_ = 0;
-  }
-
-  // 循环查找可替换的页帧
-  while (true) {
-    auto &it = clock_list_[clock_hand_];
-    if (!it.second) {
-      // if not valid
-      clock_hand_++;
-    } else if (it.first) {
-      // valid and ref bit = 1
-      it.first = false;
-      clock_hand_++;
-    } else {
-      *frame_id = clock_map_[clock_hand_];
-      // 删除该页帧，但不必移动指针
-      it.second = false;
-      clock_map_.erase(clock_hand_);
-      capacity--;
-      return true;
-    }
-    if (clock_hand_ == clock_list_.size()) {
-      clock_hand_ = 0;
-    }
-  }
-}
-
-/**
- * TODO: Student Implement
- */
-void CLOCKReplacer::Pin(frame_id_t frame_id) {
-  for (auto &it : clock_map_) {
-    if (it.second == frame_id) {
-      clock_list_[it.first] = make_pair(false, false);
-      clock_map_.erase(it.first);
-      capacity--;
-      break;
-    }
-  }
-}
-
-/**
- * TODO: Student Implement
- */
-void CLOCKReplacer::Unpin(frame_id_t frame_id) {
-  // 若页帧已在Clock中
-  for (auto &it : clock_map_) {
-    if (it.second == frame_id) {
-      // 按照算法：unpin ---> ref bit <= true
-      // 但应该不会这样用（
-      clock_list_[it.first].first = true;
-      return;
-    }
-  }
-
-  // 若list已满
-  if (capacity >= clock_list_.size()) {
-    LOG(ERROR) << "CLOCKReplacer is full" << std::endl;
-    frame_id_t *t;
-    Victim(t);
-  }
-
-  // 添加新页帧到一个原先invalid的位置，并移动指针
-  while (clock_list_[clock_hand_].first) {
-    clock_hand_++;
-    if (clock_hand_ == clock_list_.size()) clock_hand_ = 0;
-  }
-  clock_list_[clock_hand_] = make_pair(false, true);
-  clock_map_[clock_hand_] = frame_id;
-  clock_hand_++;
-  capacity++;
-}
-
-/**
- * TODO: Student Implement
- */
-size_t CLOCKReplacer::Size() {
-  return capacity;  // 返回链表的大小
-}
\ No newline at end of file
+#include "buffer/clock_replacer.h"
+#include <algorithm>
+#include <ostream>
+#include "glog/logging.h"
+
+CLOCKReplacer::RefBits::RefBits(size_t size) : size_(size), bits_(new std::atomic<bool>[size]) {
+  for (size_t i = 0; i < size_; i++) {
+    bits_[i].store(false, std::memory_order_relaxed);
+  }
+}
+
+CLOCKReplacer::CLOCKReplacer(size_t num_pages)
+    : num_frames_(num_pages), in_clock_(num_pages, false), ref_bits_(std::make_unique<RefBits>(num_pages)) {
+  ref_.store(ref_bits_.get());
+}
+
+CLOCKReplacer::~CLOCKReplacer() = default;
+
+bool CLOCKReplacer::VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) {
+  FreeRetiredRefBits();
+
+  // 空表，直接返回
+  if (size_ == 0) {
+    LOG(INFO) << "CLOCKReplacer is empty" << std::endl;
+    return false;
+  }
+
+  // 转过两圈后所有 ref bit 都已清零，仍找不到说明没有可以淘汰的页帧
+  auto &ref = ref_.load(std::memory_order_relaxed)->bits_;
+  for (size_t steps = 0; steps < 2 * num_frames_; steps++) {
+    size_t pos = clock_hand_;
+    clock_hand_ = (clock_hand_ + 1) % num_frames_;
+    if (!in_clock_[pos]) {
+      continue;
+    }
+    if (ref[pos].exchange(false, std::memory_order_relaxed)) {
+      // valid and ref bit = 1, give it a second chance
+      continue;
+    }
+    if (evictable(static_cast<frame_id_t>(pos))) {
+      *frame_id = static_cast<frame_id_t>(pos);
+      in_clock_[pos] = false;
+      size_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void CLOCKReplacer::Pin(frame_id_t frame_id) {
+  if (!IsValidFrame(frame_id) || !in_clock_[frame_id]) {
+    return;
+  }
+  in_clock_[frame_id] = false;
+  size_--;
+}
+
+void CLOCKReplacer::Unpin(frame_id_t frame_id) {
+  if (!IsValidFrame(frame_id)) {
+    LOG(ERROR) << "Frame id out of range: " << frame_id << std::endl;
+    return;
+  }
+  // 若页帧已在Clock中，按照算法：unpin ---> ref bit <= true
+  auto &ref = ref_.load(std::memory_order_relaxed)->bits_;
+  if (in_clock_[frame_id]) {
+    ref[frame_id].store(true, std::memory_order_relaxed);
+    return;
+  }
+  in_clock_[frame_id] = true;
+  ref[frame_id].store(false, std::memory_order_relaxed);
+  size_++;
+}
+
+void CLOCKReplacer::RecordAccess(frame_id_t frame_id) {
+  // frames that are not in the clock get their ref bit reset when they are unpinned
+  // 先登记再读取 ref_，Resize 换下数组后看到 accessors_ 为 0 即说明没有命中还持有旧数组
+  accessors_.fetch_add(1, std::memory_order_seq_cst);
+  RefBits *ref = ref_.load(std::memory_order_seq_cst);
+  if (frame_id >= 0 && static_cast<size_t>(frame_id) < ref->size_) {
+    ref->bits_[frame_id].store(true, std::memory_order_relaxed);
+  }
+  accessors_.fetch_sub(1, std::memory_order_release);
+}
+
+size_t CLOCKReplacer::Size() { return size_; }
+
+void CLOCKReplacer::PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) {
+  // 第一圈依次淘汰 ref bit 为 0 的页帧，第二圈淘汰第一圈中被清除 ref bit 的页帧
+  auto &bits = ref_.load(std::memory_order_relaxed)->bits_;
+  for (bool ref : {false, true}) {
+    for (size_t i = 0; i < num_frames_ && frame_ids->size() < max_frames; i++) {
+      size_t pos = (clock_hand_ + i) % num_frames_;
+      if (in_clock_[pos] && bits[pos].load(std::memory_order_relaxed) == ref) {
+        frame_ids->push_back(static_cast<frame_id_t>(pos));
+      }
+    }
+  }
+}
+
+void CLOCKReplacer::Resize(size_t num_frames) {
+  auto ref = std::make_unique<RefBits>(num_frames);
+  for (size_t i = 0; i < std::min(num_frames, ref_bits_->size_); i++) {
+    ref->bits_[i].store(ref_bits_->bits_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  // 之后才设置到旧数组中的 ref bit 会丢失，只影响淘汰的精度
+  ref_.store(ref.get(), std::memory_order_seq_cst);
+  retired_ref_bits_.push_back(std::move(ref_bits_));
+  ref_bits_ = std::move(ref);
+  FreeRetiredRefBits();
+  num_frames_ = num_frames;
+  in_clock_.resize(num_frames, false);
+  if (clock_hand_ >= num_frames_) {
+    clock_hand_ = 0;
+  }
+}
+
+void CLOCKReplacer::FreeRetiredRefBits() {
+  // 新数组已发布，此后开始的 RecordAccess 不会再读到旧数组
+  if (retired_ref_bits_.empty() || accessors_.load(std::memory_order_seq_cst) != 0) {
+    return;
+  }
+  retired_ref_bits_.clear();
+}
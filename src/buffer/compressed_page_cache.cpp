@@ -0,0 +1,112 @@
+#include "buffer/compressed_page_cache.h"
+
+#include <cstring>
+
+#include "buffer/page_codec.h"
+
+CompressedPageCache::CompressedPageCache(size_t capacity) : capacity_(capacity) {}
+
+bool CompressedPageCache::Put(page_id_t page_id, const char *data, bool written, const void *pool) {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (capacity_ == 0) {
+      return false;
+    }
+  }
+  // the page is compressed without the latch, only the bookkeeping is serialized
+  char buf[MAX_COMPRESSED_SIZE];
+  size_t size = PageCodec::Compress(data, PAGE_SIZE, buf, MAX_COMPRESSED_SIZE);
+  std::unique_ptr<char[]> compressed;
+  if (size != 0) {
+    compressed = std::make_unique<char[]>(size);
+    memcpy(compressed.get(), buf, size);
+  }
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto it = index_.find(page_id);
+  if (it != index_.end()) {
+    EraseEntry(it->second);
+    if (!written) {
+      return false;
+    }
+  }
+  if (size == 0 || size + ENTRY_OVERHEAD > capacity_) {
+    return false;
+  }
+  entries_.push_front({page_id, pool, size, std::move(compressed)});
+  index_[page_id] = entries_.begin();
+  size_ += size + ENTRY_OVERHEAD;
+  EvictToCapacity();
+  return true;
+}
+
+bool CompressedPageCache::Take(page_id_t page_id, char *data, const void *pool) {
+  std::unique_ptr<char[]> compressed;
+  size_t size;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    // the copy of another pool may be older than the page on disk, e.g. when the copy written back by the owner of
+    // the page has been dropped for capacity
+    auto it = index_.find(page_id);
+    if (it == index_.end() || it->second->pool_ != pool) {
+      num_misses_++;
+      return false;
+    }
+    compressed = std::move(it->second->data_);
+    size = it->second->size_;
+    EraseEntry(it->second);
+    num_hits_++;
+  }
+  // a page that cannot be decompressed is read from disk instead
+  return PageCodec::Decompress(compressed.get(), size, data, PAGE_SIZE);
+}
+
+void CompressedPageCache::Erase(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto it = index_.find(page_id);
+  if (it != index_.end()) {
+    EraseEntry(it->second);
+  }
+}
+
+void CompressedPageCache::SetCapacity(size_t capacity) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  capacity_ = capacity;
+  EvictToCapacity();
+}
+
+size_t CompressedPageCache::GetCapacity() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return capacity_;
+}
+
+size_t CompressedPageCache::GetSize() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return size_;
+}
+
+size_t CompressedPageCache::GetNumPages() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return entries_.size();
+}
+
+size_t CompressedPageCache::GetNumHits() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return num_hits_;
+}
+
+size_t CompressedPageCache::GetNumMisses() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return num_misses_;
+}
+
+void CompressedPageCache::EvictToCapacity() {
+  while (size_ > capacity_) {
+    EraseEntry(std::prev(entries_.end()));
+  }
+}
+
+void CompressedPageCache::EraseEntry(std::list<Entry>::iterator it) {
+  size_ -= it->size_ + ENTRY_OVERHEAD;
+  index_.erase(it->page_id_);
+  entries_.erase(it);
+}
@@ -0,0 +1,73 @@
+#include "buffer/concurrent_page_table.h"
+
+ConcurrentPageTable::ConcurrentPageTable(size_t num_frames) {
+  size_t capacity = 16;
+  while (capacity < 2 * num_frames) {
+    capacity <<= 1;
+  }
+  slots_ = std::make_unique<Slot[]>(capacity);
+  mask_ = capacity - 1;
+}
+
+bool ConcurrentPageTable::Find(page_id_t page_id, frame_id_t *frame_id) const {
+  // the table is never full, but a concurrent Erase may shift entries around, so the probe length is bounded as well
+  for (size_t i = GetHomeSlot(page_id), probes = 0; probes <= mask_; i = (i + 1) & mask_, probes++) {
+    page_id_t slot_page_id = slots_[i].page_id_.load(std::memory_order_acquire);
+    if (slot_page_id == INVALID_PAGE_ID) {
+      return false;
+    }
+    if (slot_page_id == page_id) {
+      *frame_id = slots_[i].frame_id_.load(std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ConcurrentPageTable::Insert(page_id_t page_id, frame_id_t frame_id) {
+  size_t i = GetHomeSlot(page_id);
+  while (slots_[i].page_id_.load(std::memory_order_relaxed) != INVALID_PAGE_ID) {
+    i = (i + 1) & mask_;
+  }
+  // the frame id is published together with the page id
+  slots_[i].frame_id_.store(frame_id, std::memory_order_relaxed);
+  slots_[i].page_id_.store(page_id, std::memory_order_release);
+}
+
+void ConcurrentPageTable::Erase(page_id_t page_id) {
+  size_t hole = GetHomeSlot(page_id);
+  while (true) {
+    page_id_t slot_page_id = slots_[hole].page_id_.load(std::memory_order_relaxed);
+    if (slot_page_id == INVALID_PAGE_ID) {
+      return;
+    }
+    if (slot_page_id == page_id) {
+      break;
+    }
+    hole = (hole + 1) & mask_;
+  }
+  // backward shift deletion: move every following entry whose home slot is not in (hole, i] into the hole
+  for (size_t i = (hole + 1) & mask_;; i = (i + 1) & mask_) {
+    page_id_t slot_page_id = slots_[i].page_id_.load(std::memory_order_relaxed);
+    if (slot_page_id == INVALID_PAGE_ID) {
+      break;
+    }
+    size_t home = GetHomeSlot(slot_page_id);
+    bool stays = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (!stays) {
+      slots_[hole].frame_id_.store(slots_[i].frame_id_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      slots_[hole].page_id_.store(slot_page_id, std::memory_order_release);
+      hole = i;
+    }
+  }
+  slots_[hole].page_id_.store(INVALID_PAGE_ID, std::memory_order_release);
+}
+
+void ConcurrentPageTable::CopyTo(ConcurrentPageTable *other) const {
+  for (size_t i = 0; i <= mask_; i++) {
+    page_id_t page_id = slots_[i].page_id_.load(std::memory_order_relaxed);
+    if (page_id != INVALID_PAGE_ID) {
+      other->Insert(page_id, slots_[i].frame_id_.load(std::memory_order_relaxed));
+    }
+  }
+}
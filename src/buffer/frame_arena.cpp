@@ -0,0 +1,43 @@
+#include "buffer/frame_arena.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+FrameArena::FrameArena(size_t num_frames) {
+  size_t size = std::max<size_t>(num_frames, 1) * PAGE_SIZE;
+  bool huge = size >= HUGE_PAGE_SIZE;
+#ifdef MAP_HUGETLB
+  if (huge) {
+    // fails right away if the system has not reserved enough huge pages, e.g. in /proc/sys/vm/nr_hugepages
+    size_t huge_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    void *ptr = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+      mapping_ = data_ = static_cast<char *>(ptr);
+      mapping_size_ = huge_size;
+      huge_tlb_ = true;
+      return;
+    }
+  }
+#endif
+  // the mapping is only aligned to the 4 KB system page, the frames start at the next aligned address inside of it
+  size_t alignment = huge ? std::max<size_t>(HUGE_PAGE_SIZE, PAGE_SIZE) : PAGE_SIZE;
+  mapping_size_ = size + alignment;
+  void *ptr = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  mapping_ = static_cast<char *>(ptr);
+  auto start = reinterpret_cast<uintptr_t>(mapping_);
+  data_ = reinterpret_cast<char *>((start + alignment - 1) / alignment * alignment);
+#ifdef MADV_HUGEPAGE
+  if (huge) {
+    // only a hint, transparent huge pages may be disabled
+    madvise(data_, size, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+FrameArena::~FrameArena() { munmap(mapping_, mapping_size_); }
@@ -0,0 +1,74 @@
+#include "buffer/lru_k_replacer.h"
+
+#include "glog/logging.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(k), history_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+bool LRUKReplacer::VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) {
+  for (auto *frames : {&young_, &old_}) {
+    for (auto it = frames->begin(); it != frames->end(); ++it) {
+      if (evictable(it->second)) {
+        *frame_id = it->second;
+        history_[*frame_id].clear();
+        frames->erase(it);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  if (!IsTracked(frame_id)) {
+    return;
+  }
+  GetSet(frame_id).erase({history_[frame_id].front(), frame_id});
+  history_[frame_id].clear();
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= history_.size()) {
+    LOG(ERROR) << "Frame id out of range: " << frame_id;
+    return;
+  }
+  if (IsTracked(frame_id)) {
+    return;
+  }
+  history_[frame_id].push_back(current_timestamp_++);
+  GetSet(frame_id).emplace(history_[frame_id].front(), frame_id);
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id) {
+  if (!IsTracked(frame_id)) {
+    return;
+  }
+  auto &history = history_[frame_id];
+  GetSet(frame_id).erase({history.front(), frame_id});
+  history.push_back(current_timestamp_++);
+  if (history.size() > k_) {
+    history.pop_front();
+  }
+  GetSet(frame_id).emplace(history.front(), frame_id);
+}
+
+size_t LRUKReplacer::Size() { return young_.size() + old_.size(); }
+
+void LRUKReplacer::PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) {
+  for (auto *frames : {&young_, &old_}) {
+    for (auto it = frames->begin(); it != frames->end() && frame_ids->size() < max_frames; ++it) {
+      frame_ids->push_back(it->second);
+    }
+  }
+}
+
+std::set<LRUKReplacer::Key> &LRUKReplacer::GetSet(frame_id_t frame_id) {
+  return history_[frame_id].size() < k_ ? young_ : old_;
+}
+
+bool LRUKReplacer::IsTracked(frame_id_t frame_id) {
+  return frame_id >= 0 && static_cast<size_t>(frame_id) < history_.size() && !history_[frame_id].empty();
+}
+
+void LRUKReplacer::Resize(size_t num_frames) { history_.resize(num_frames); }
@@ -9,17 +9,21 @@ LRUReplacer::~LRUReplacer() = default;
 /**
  * TODO: Student Implement
  */
-bool LRUReplacer::Victim(frame_id_t *frame_id) {
-  // 返回双向链表的最后一个元素
+bool LRUReplacer::VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) {
+  // 从双向链表的尾部开始，返回第一个可以淘汰的元素
   if (lru_list_.empty()) {
     LOG(INFO) << "LRUReplacer is empty" << std::endl;
-    frame_id = nullptr;
     return false;
   }
-  *frame_id = lru_list_.back();
-  lru_map_.erase(*frame_id);
-  lru_list_.pop_back();
-  return true;
+  for (auto it = lru_list_.rbegin(); it != lru_list_.rend(); ++it) {
+    if (evictable(*it)) {
+      *frame_id = *it;
+      lru_map_.erase(*frame_id);
+      lru_list_.erase(std::next(it).base());
+      return true;
+    }
+  }
+  return false;
 }
 
 /**
@@ -52,9 +56,26 @@ void LRUReplacer::Unpin(frame_id_t frame_id) {
   lru_map_[frame_id] = lru_list_.begin();  // 插入哈希表
 }
 
+void LRUReplacer::RecordAccess(frame_id_t frame_id) {
+  auto it = lru_map_.find(frame_id);
+  if (it == lru_map_.end()) {
+    return;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, it->second);  // 移到链表头部，迭代器仍然有效
+}
+
 /**
  * TODO: Student Implement
  */
 size_t LRUReplacer::Size() {
   return lru_list_.size();  // 返回链表的大小
-}
\ No newline at end of file
+}
+
+void LRUReplacer::PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) {
+  // 从链表尾部开始，即最久未使用的页帧
+  for (auto it = lru_list_.rbegin(); it != lru_list_.rend() && frame_ids->size() < max_frames; ++it) {
+    frame_ids->push_back(*it);
+  }
+}
+
+void LRUReplacer::Resize(size_t num_frames) { max_size_ = num_frames; }
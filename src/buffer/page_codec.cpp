@@ -0,0 +1,170 @@
+#include "buffer/page_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+static inline uint32_t Read32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * Write the length beyond what fits into the token, as a run of 255 and a last byte below 255
+ * @return false if the output is full
+ */
+static inline bool WriteLength(size_t length, uint8_t *&op, const uint8_t *oend) {
+  for (; length >= 255; length -= 255) {
+    if (op >= oend) {
+      return false;
+    }
+    *op++ = 255;
+  }
+  if (op >= oend) {
+    return false;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return true;
+}
+
+/**
+ * Read the length beyond what fits into the token
+ * @return false if the input ends before the length
+ */
+static inline bool ReadLength(size_t *length, const uint8_t *&ip, const uint8_t *iend) {
+  uint8_t byte;
+  do {
+    if (ip >= iend) {
+      return false;
+    }
+    byte = *ip++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+/**
+ * Write a sequence of literals followed by a match, match_length 0 for the last sequence which has no match
+ */
+static bool WriteSequence(const uint8_t *literals, size_t literal_length, size_t offset, size_t match_length,
+                          uint8_t *&op, const uint8_t *oend) {
+  if (op >= oend) {
+    return false;
+  }
+  uint8_t *token = op++;
+  *token = static_cast<uint8_t>((literal_length < 15 ? literal_length : 15) << 4);
+  if (literal_length >= 15 && !WriteLength(literal_length - 15, op, oend)) {
+    return false;
+  }
+  if (static_cast<size_t>(oend - op) < literal_length) {
+    return false;
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if (match_length == 0) {
+    return true;
+  }
+  if (oend - op < 2) {
+    return false;
+  }
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  size_t length = match_length - 4;
+  *token |= static_cast<uint8_t>(length < 15 ? length : 15);
+  return length < 15 || WriteLength(length - 15, op, oend);
+}
+
+size_t PageCodec::Compress(const char *src, size_t size, char *dst, size_t capacity) {
+  const auto *base = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *ip = base;
+  const uint8_t *anchor = base;
+  const uint8_t *iend = base + size;
+  auto *op = reinterpret_cast<uint8_t *>(dst);
+  const uint8_t *oend = op + capacity;
+  if (size > MATCH_FIND_LIMIT) {
+    // positions are kept plus one, 0 is an empty slot
+    uint32_t table[1 << HASH_LOG] = {0};
+    const uint8_t *match_limit = iend - LAST_LITERALS;
+    const uint8_t *find_limit = iend - MATCH_FIND_LIMIT;
+    while (ip < find_limit) {
+      uint32_t sequence = Read32(ip);
+      uint32_t hash = (sequence * 2654435761U) >> (32 - HASH_LOG);
+      uint32_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(ip - base) + 1;
+      if (candidate == 0) {
+        ip++;
+        continue;
+      }
+      const uint8_t *match = base + candidate - 1;
+      if (static_cast<size_t>(ip - match) > MAX_OFFSET || Read32(match) != sequence) {
+        ip++;
+        continue;
+      }
+      // the match may start before the position that was hashed
+      while (ip > anchor && match > base && ip[-1] == match[-1]) {
+        ip--;
+        match--;
+      }
+      size_t match_length = MIN_MATCH;
+      while (ip + match_length < match_limit && ip[match_length] == match[match_length]) {
+        match_length++;
+      }
+      if (!WriteSequence(anchor, ip - anchor, ip - match, match_length, op, oend)) {
+        return 0;
+      }
+      ip += match_length;
+      anchor = ip;
+    }
+  }
+  if (!WriteSequence(anchor, iend - anchor, 0, 0, op, oend)) {
+    return 0;
+  }
+  return op - reinterpret_cast<uint8_t *>(dst);
+}
+
+bool PageCodec::Decompress(const char *src, size_t src_size, char *dst, size_t size) {
+  const auto *ip = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *iend = ip + src_size;
+  auto *base = reinterpret_cast<uint8_t *>(dst);
+  uint8_t *op = base;
+  const uint8_t *oend = base + size;
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !ReadLength(&literal_length, ip, iend)) {
+      return false;
+    }
+    if (static_cast<size_t>(iend - ip) < literal_length || static_cast<size_t>(oend - op) < literal_length) {
+      return false;
+    }
+    memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if (ip == iend) {
+      break;  // the last sequence has no match
+    }
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - base)) {
+      return false;
+    }
+    size_t match_length = token & 15;
+    if (match_length == 15 && !ReadLength(&match_length, ip, iend)) {
+      return false;
+    }
+    match_length += MIN_MATCH;
+    if (static_cast<size_t>(oend - op) < match_length) {
+      return false;
+    }
+    // the match may overlap the output it produces, e.g. a run of one byte has offset 1
+    const uint8_t *match = op - offset;
+    for (size_t i = 0; i < match_length; i++) {
+      op[i] = match[i];
+    }
+    op += match_length;
+  }
+  return op == oend;
+}
@@ -0,0 +1,198 @@
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+#include "glog/logging.h"
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size,
+                                                     DiskManager *disk_manager, size_t clean_frame_target,
+                                                     ReplacerPolicy policy)
+    : disk_manager_(disk_manager) {
+  ASSERT(num_instances > 0 && pool_size >= num_instances, "Every instance needs at least one frame.");
+  for (size_t i = 0; i < num_instances; i++) {
+    // the first pool_size % num_instances instances get one more frame
+    size_t instance_size = pool_size / num_instances + (i < pool_size % num_instances ? 1 : 0);
+    size_t instance_target = (clean_frame_target + num_instances - 1) / num_instances;
+    instances_.emplace_back(new BufferPoolManagerInstance(instance_size, disk_manager, instance_target, policy));
+  }
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() {
+  // written here in one go, the instances alone could not coalesce pages spread over several of them
+  FlushAllPages();
+  for (auto instance : instances_) {
+    delete instance;
+  }
+}
+
+Page *ParallelBufferPoolManager::FetchPage(page_id_t page_id, BufferAccessStrategy *strategy) {
+  return GetInstance(page_id)->FetchPage(page_id, strategy);
+}
+
+std::vector<Page *> ParallelBufferPoolManager::FetchPages(const std::vector<page_id_t> &page_ids) {
+  // group the pages by instance so that every instance issues its reads in one batch
+  std::vector<std::vector<page_id_t>> instance_page_ids(instances_.size());
+  std::vector<std::vector<size_t>> positions(instances_.size());
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    size_t instance_id = static_cast<size_t>(page_ids[i]) % instances_.size();
+    instance_page_ids[instance_id].push_back(page_ids[i]);
+    positions[instance_id].push_back(i);
+  }
+  // the reads of all instances are issued before any of them is waited for, so the misses of the batch are in flight
+  // together. The latches are taken in the order of the instances.
+  std::vector<BufferPoolManagerInstance::PendingFetch> fetches(instances_.size());
+  for (size_t i = 0; i < instances_.size(); i++) {
+    if (!instance_page_ids[i].empty()) {
+      instances_[i]->SubmitFetches(instance_page_ids[i], &fetches[i]);
+    }
+  }
+  std::vector<Page *> pages(page_ids.size(), nullptr);
+  for (size_t i = 0; i < instances_.size(); i++) {
+    if (instance_page_ids[i].empty()) {
+      continue;
+    }
+    std::vector<Page *> instance_pages = instances_[i]->CompleteFetches(&fetches[i]);
+    for (size_t j = 0; j < instance_pages.size(); j++) {
+      pages[positions[i][j]] = instance_pages[j];
+    }
+  }
+  return pages;
+}
+
+void ParallelBufferPoolManager::Prefetch(const std::vector<page_id_t> &page_ids, BufferAccessStrategy *strategy) {
+  std::vector<std::vector<page_id_t>> instance_page_ids(instances_.size());
+  for (auto page_id : page_ids) {
+    if (page_id != INVALID_PAGE_ID) {
+      instance_page_ids[static_cast<size_t>(page_id) % instances_.size()].push_back(page_id);
+    }
+  }
+  for (size_t i = 0; i < instances_.size(); i++) {
+    if (!instance_page_ids[i].empty()) {
+      instances_[i]->Prefetch(instance_page_ids[i], strategy);
+    }
+  }
+}
+
+bool ParallelBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  return GetInstance(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+bool ParallelBufferPoolManager::FlushPage(page_id_t page_id) { return GetInstance(page_id)->FlushPage(page_id); }
+
+void ParallelBufferPoolManager::FlushAllPages() { BufferPoolManagerInstance::FlushDirtyPages(instances_); }
+
+void ParallelBufferPoolManager::Sync() {
+  FlushAllPages();
+  // the pages allocated since the last checkpoint are only marked in the bitmaps in memory
+  disk_manager_->Checkpoint();
+  disk_manager_->Sync();
+}
+
+size_t ParallelBufferPoolManager::Checkpoint() {
+  size_t num_written = BufferPoolManagerInstance::FlushDirtyPages(instances_);
+  disk_manager_->Checkpoint();
+  disk_manager_->Sync();
+  return num_written;
+}
+
+Page *ParallelBufferPoolManager::NewPage(page_id_t &page_id, ExtentReservation *reservation,
+                                         BufferAccessStrategy *strategy) {
+  if (disk_manager_->IsReadOnly()) {
+    LOG(ERROR) << "Unable to create page: buffer pool is read-only";
+    page_id = INVALID_PAGE_ID;
+    return nullptr;
+  }
+  page_id = reservation == nullptr ? disk_manager_->AllocatePage() : disk_manager_->AllocatePage(reservation);
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  Page *page = GetInstance(page_id)->CreatePage(page_id, strategy);
+  if (page == nullptr) {
+    disk_manager_->DeAllocatePage(page_id);
+    page_id = INVALID_PAGE_ID;
+  }
+  return page;
+}
+
+void ParallelBufferPoolManager::ReleaseReservation(ExtentReservation *reservation) {
+  disk_manager_->ReleaseReservation(reservation);
+}
+
+bool ParallelBufferPoolManager::DeletePage(page_id_t page_id) { return GetInstance(page_id)->DeletePage(page_id); }
+
+bool ParallelBufferPoolManager::EvictPage(page_id_t page_id) { return GetInstance(page_id)->EvictPage(page_id); }
+
+bool ParallelBufferPoolManager::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
+
+size_t ParallelBufferPoolManager::GetNumMisses() {
+  size_t num_misses = 0;
+  for (auto instance : instances_) {
+    num_misses += instance->GetNumMisses();
+  }
+  return num_misses;
+}
+
+void ParallelBufferPoolManager::SetCompressedCache(CompressedPageCache *cache) {
+  for (auto instance : instances_) {
+    instance->SetCompressedCache(cache);
+  }
+}
+
+bool ParallelBufferPoolManager::CheckAllUnpinned() {
+  bool res = true;
+  for (auto instance : instances_) {
+    res &= instance->CheckAllUnpinned();
+  }
+  return res;
+}
+
+size_t ParallelBufferPoolManager::GetPoolSize() {
+  size_t pool_size = 0;
+  for (auto instance : instances_) {
+    pool_size += instance->GetPoolSize();
+  }
+  return pool_size;
+}
+
+bool ParallelBufferPoolManager::Resize(size_t pool_size) {
+  if (pool_size < instances_.size()) {
+    LOG(ERROR) << "Unable to resize buffer pool to " << pool_size << " frames: every instance needs at least one frame";
+    return false;
+  }
+  // instances are resized one by one, the others keep serving pages meanwhile
+  std::vector<size_t> old_sizes;
+  for (auto instance : instances_) {
+    old_sizes.push_back(instance->GetPoolSize());
+  }
+  for (size_t i = 0; i < instances_.size(); i++) {
+    size_t instance_size = pool_size / instances_.size() + (i < pool_size % instances_.size() ? 1 : 0);
+    if (instances_[i]->Resize(instance_size)) {
+      continue;
+    }
+    // the instances resized already go back, so that the pool keeps its old size as a whole
+    for (size_t j = 0; j < i; j++) {
+      if (!instances_[j]->Resize(old_sizes[j])) {
+        LOG(ERROR) << "Unable to resize instance " << j << " back to " << old_sizes[j] << " frames";
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+void ParallelBufferPoolManager::GetResidentPages(std::vector<page_id_t> *page_ids) {
+  std::vector<std::vector<page_id_t>> instance_page_ids(instances_.size());
+  size_t max_pages = 0;
+  for (size_t i = 0; i < instances_.size(); i++) {
+    instances_[i]->GetResidentPages(&instance_page_ids[i]);
+    max_pages = std::max(max_pages, instance_page_ids[i].size());
+  }
+  for (size_t j = 0; j < max_pages; j++) {
+    for (auto &ids : instance_page_ids) {
+      if (j < ids.size()) {
+        page_ids->push_back(ids[j]);
+      }
+    }
+  }
+}
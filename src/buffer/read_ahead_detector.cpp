@@ -0,0 +1,31 @@
+#include "buffer/read_ahead_detector.h"
+
+#include <algorithm>
+
+std::vector<page_id_t> ReadAheadDetector::OnAccess(page_id_t page_id, page_id_t next_page_id, page_id_t owned_end) {
+  std::vector<page_id_t> page_ids;
+  if (last_page_id_ != INVALID_PAGE_ID && page_id == last_page_id_ + 1) {
+    run_length_++;
+  } else {
+    run_length_ = 1;
+    prefetched_until_ = page_id;
+  }
+  last_page_id_ = page_id;
+  if (run_length_ >= trigger_) {
+    page_id_t window_end = page_id + static_cast<page_id_t>(window_);
+    if (owned_end != INVALID_PAGE_ID) {
+      window_end = std::min(window_end, owned_end - 1);
+    }
+    if (prefetched_until_ < page_id + static_cast<page_id_t>(window_ / 2)) {
+      for (page_id_t i = std::max(prefetched_until_, page_id) + 1; i <= window_end; i++) {
+        page_ids.push_back(i);
+      }
+      prefetched_until_ = std::max(prefetched_until_, window_end);
+    }
+  }
+  // e.g. the chain goes on in another run of the object, past the end of the window
+  if (next_page_id != INVALID_PAGE_ID && (next_page_id <= page_id || next_page_id > prefetched_until_)) {
+    page_ids.push_back(next_page_id);
+  }
+  return page_ids;
+}
@@ -0,0 +1,34 @@
+#include "buffer/replacer.h"
+
+#include "buffer/arc_replacer.h"
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+
+std::unique_ptr<Replacer> Replacer::Create(ReplacerPolicy policy, size_t num_frames) {
+  switch (policy) {
+    case ReplacerPolicy::kClock:
+      return std::make_unique<CLOCKReplacer>(num_frames);
+    case ReplacerPolicy::kLRUK:
+      return std::make_unique<LRUKReplacer>(num_frames);
+    case ReplacerPolicy::kARC:
+      return std::make_unique<ARCReplacer>(num_frames);
+    case ReplacerPolicy::kLRU:
+    default:
+      return std::make_unique<LRUReplacer>(num_frames);
+  }
+}
+
+bool Replacer::ParsePolicy(const std::string &name, ReplacerPolicy *policy) {
+  static const std::pair<const char *, ReplacerPolicy> policies[] = {{"lru", ReplacerPolicy::kLRU},
+                                                                     {"clock", ReplacerPolicy::kClock},
+                                                                     {"lru-k", ReplacerPolicy::kLRUK},
+                                                                     {"arc", ReplacerPolicy::kARC}};
+  for (auto &it : policies) {
+    if (name == it.first) {
+      *policy = it.second;
+      return true;
+    }
+  }
+  return false;
+}
@@ -12,13 +12,13 @@ void CatalogMeta::SerializeTo(char *buf) const {
     MACH_WRITE_TO(table_id_t, buf, iter.first);
     buf += 4;
     MACH_WRITE_TO(page_id_t, buf, iter.second);
-    buf += 4;
+    buf += sizeof(page_id_t);
   }
   for (auto iter : index_meta_pages_) {
     MACH_WRITE_TO(index_id_t, buf, iter.first);
     buf += 4;
     MACH_WRITE_TO(page_id_t, buf, iter.second);
-    buf += 4;
+    buf += sizeof(page_id_t);
   }
 }
 
@@ -38,14 +38,14 @@ CatalogMeta *CatalogMeta::DeserializeFrom(char *buf) {
     auto table_id = MACH_READ_FROM(table_id_t, buf);
     buf += 4;
     auto table_heap_page_id = MACH_READ_FROM(page_id_t, buf);
-    buf += 4;
+    buf += sizeof(page_id_t);
     meta->table_meta_pages_.emplace(table_id, table_heap_page_id);
   }
   for (uint32_t i = 0; i < index_nums; i++) {
     auto index_id = MACH_READ_FROM(index_id_t, buf);
     buf += 4;
     auto index_page_id = MACH_READ_FROM(page_id_t, buf);
-    buf += 4;
+    buf += sizeof(page_id_t);
     meta->index_meta_pages_.emplace(index_id, index_page_id);
   }
   return meta;
@@ -56,13 +56,13 @@ CatalogMeta *CatalogMeta::DeserializeFrom(char *buf) {
  */
 uint32_t CatalogMeta::GetSerializedSize() const {
   // total size = magic num(4) + size of table meta pages(4) + size of index meta pages(4)
-  //              + size of table meta pages * (table_id(4) + table_heap_page_id(4))
-  //              + size of index meta pages * (index_id(4) + index_heap_page_id(4))
+  //              + size of table meta pages * (table_id(4) + table_heap_page_id(4 or 8))
+  //              + size of index meta pages * (index_id(4) + index_heap_page_id(4 or 8))
   uint32_t serialized_size = 12;
   uint32_t table_meta_pages_size = table_meta_pages_.size();
   uint32_t index_meta_pages_size = index_meta_pages_.size();
 
-  serialized_size += 8 * (table_meta_pages_size + index_meta_pages_size);
+  serialized_size += (4 + sizeof(page_id_t)) * (table_meta_pages_size + index_meta_pages_size);
 
   return serialized_size;
 }
@@ -76,8 +76,11 @@ CatalogMeta::CatalogMeta() : table_meta_pages_(), index_meta_pages_() {
  * TODO: Student Implement
  */
 CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager,
-                               LogManager *log_manager, bool init)
-    : buffer_pool_manager_(buffer_pool_manager), lock_manager_(lock_manager), log_manager_(log_manager) {
+                               LogManager *log_manager, bool init, BufferPoolSet *pools)
+    : buffer_pool_manager_(buffer_pool_manager),
+      pools_(pools == nullptr ? BufferPoolSet(buffer_pool_manager) : *pools),
+      lock_manager_(lock_manager),
+      log_manager_(log_manager) {
   table_names_.clear();
   tables_.clear();
   index_names_.clear();
@@ -140,7 +143,8 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
     table_schema = table_schema->DeepCopySchema(schema);
 
     // create and initialize new table info
-    table_heap = table_heap->Create(buffer_pool_manager_, table_schema, txn, log_manager_, lock_manager_);
+    table_heap = table_heap->Create(pools_.GetPool(BufferPoolId::kDefault), table_schema, txn, log_manager_,
+                                    lock_manager_);
     table_page_id = table_heap->GetFirstPageId();
     table_meta = table_meta->Create(table_id, table_name, table_page_id, table_schema);
     table_meta->SerializeTo(table_meta_page->GetData());
@@ -244,11 +248,12 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
     index_meta->SerializeTo(index_meta_page->GetData());
     buffer_pool_manager_->UnpinPage(page_id, true);
     index_info = index_info->Create();
-    index_info->Init(index_meta, table_info, buffer_pool_manager_);
+    index_info->Init(index_meta, table_info, pools_.GetPool(BufferPoolId::kDefault), buffer_pool_manager_);
 
-    // Get the table iterator for all records in the table
+    // Get the table iterator for all records in the table, the pages are read into a ring of frames
     key_schema = index_info->GetIndexKeySchema();
-    for (TableIterator it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+    BufferAccessStrategy strategy(BufferAccessType::kBulkRead);
+    for (TableIterator it = table_heap->Begin(nullptr, &strategy); it != table_heap->End(); ++it) {
       // Get the current row and insert its key into the index
       Row row = *it;
       Row key_row;
@@ -379,6 +384,57 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::SetTablePool(const std::string &table_name, BufferPoolId pool_id) {
+  if (table_names_.count(table_name) == 0) return DB_TABLE_NOT_EXIST;
+
+  table_id_t table_id = table_names_[table_name];
+  TableInfo *table_info = tables_[table_id];
+  TableMetadata *table_meta = table_info->GetTableMeta();
+  if (table_meta->GetPoolId() == pool_id) return DB_SUCCESS;
+
+  // a page is resident in the pool of its object only, so the pages are dropped before the pool changes
+  std::vector<page_id_t> page_ids;
+  table_info->GetTableHeap()->GetPageIds(&page_ids);
+  if (!pools_.EvictPages(page_ids)) return DB_FAILED;
+  table_info->GetTableHeap()->SetBufferPoolManager(pools_.GetPool(pool_id));
+
+  // rewrite the table meta page
+  table_meta->SetPoolId(pool_id);
+  page_id_t page_id = catalog_meta_->table_meta_pages_[table_id];
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) return DB_FAILED;
+  table_meta->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::SetIndexPool(const std::string &table_name, const std::string &index_name,
+                                     BufferPoolId pool_id) {
+  IndexInfo *index_info = nullptr;
+  dberr_t res = GetIndex(table_name, index_name, index_info);
+  if (res != DB_SUCCESS) return res;
+
+  IndexMetadata *index_meta = index_info->GetIndexMeta();
+  if (index_meta->GetPoolId() == pool_id) return DB_SUCCESS;
+
+  // a page is resident in the pool of its object only, so the pages are dropped before the pool changes
+  std::vector<page_id_t> page_ids;
+  index_info->GetIndex()->GetPageIds(&page_ids);
+  if (!pools_.EvictPages(page_ids)) return DB_FAILED;
+  index_info->GetIndex()->SetBufferPoolManager(pools_.GetPool(pool_id));
+
+  // rewrite the index meta page
+  index_meta->SetPoolId(pool_id);
+  page_id_t page_id = catalog_meta_->index_meta_pages_[index_meta->GetIndexId()];
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) return DB_FAILED;
+  index_meta->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+
+  return DB_SUCCESS;
+}
+
 /**
  * TODO: Student Implement
  */
@@ -414,7 +470,8 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
     // create table info
     table_page_id = table_meta->GetFirstPageId();
     table_schema = table_meta->GetSchema();
-    table_heap = table_heap->Create(buffer_pool_manager_, table_page_id, table_schema, log_manager_, lock_manager_);
+    table_heap = table_heap->Create(pools_.GetPool(table_meta->GetPoolId()), table_page_id, table_schema, log_manager_,
+                                    lock_manager_);
     table_info = table_info->Create();
     table_info->Init(table_meta, table_heap);
 
@@ -459,7 +516,7 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
     table_id = index_meta->GetTableId();
     table_info = tables_[table_id];
     index_info = index_info->Create();
-    index_info->Init(index_meta, table_info, buffer_pool_manager_);
+    index_info->Init(index_meta, table_info, pools_.GetPool(index_meta->GetPoolId()), buffer_pool_manager_);
 
     // update catalog manager
     std::string index_name = index_meta->GetIndexName();
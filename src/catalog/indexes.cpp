@@ -35,6 +35,11 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     MACH_WRITE_UINT32(buf, col_index);
     buf += 4;
   }
+  // buffer pool binding
+  MACH_WRITE_UINT32(buf, POOL_ID_MAGIC_NUM);
+  buf += 4;
+  MACH_WRITE_UINT32(buf, static_cast<uint32_t>(pool_id_));
+  buf += 4;
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
@@ -44,8 +49,8 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
  */
 uint32_t IndexMetadata::GetSerializedSize() const {
   // total size = magic num(4) + index id(4) + table id(4) + key count(4)
-  //              + index name(calculated by macro) + key mapping(size * 4)
-  uint32_t serialized_size = 16 + MACH_STR_SERIALIZED_SIZE(index_name_);
+  //              + index name(calculated by macro) + key mapping(size * 4) + pool magic num(4) + pool id(4)
+  uint32_t serialized_size = 24 + MACH_STR_SERIALIZED_SIZE(index_name_);
   uint32_t key_map_size = key_map_.size();
   serialized_size += 4 * key_map_size;
 
@@ -84,10 +89,20 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
   }
   // allocate space for index meta data
   index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  // buffer pool binding, missing in the meta pages of older files
+  if (MACH_READ_UINT32(buf) == POOL_ID_MAGIC_NUM) {
+    buf += 4;
+    uint32_t pool_id = MACH_READ_UINT32(buf);
+    buf += 4;
+    if (pool_id < BufferPoolSet::NUM_POOLS) {
+      index_meta->pool_id_ = static_cast<BufferPoolId>(pool_id);
+    }
+  }
   return buf - p;
 }
 
-Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
+Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, BufferPoolManager *roots_pool,
+                              const string &index_type) {
   size_t max_size = 0;
   uint32_t column_cnt = key_schema_->GetColumns().size();
   size_t size_bitmap = (column_cnt % 8) ? column_cnt / 8 + 1 : column_cnt / 8;
@@ -117,5 +132,5 @@ Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const stri
   } else {
     return nullptr;
   }
-  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
+  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager, roots_pool);
 }
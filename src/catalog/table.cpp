@@ -17,9 +17,14 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   buf += table_name_.length();
   // table heap root page id
   MACH_WRITE_TO(page_id_t, buf, root_page_id_);
-  buf += 4;
+  buf += sizeof(page_id_t);
   // table schema
   buf += schema_->SerializeTo(buf);
+  // buffer pool binding
+  MACH_WRITE_UINT32(buf, POOL_ID_MAGIC_NUM);
+  buf += 4;
+  MACH_WRITE_UINT32(buf, static_cast<uint32_t>(pool_id_));
+  buf += 4;
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
@@ -29,8 +34,9 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
  */
 uint32_t TableMetadata::GetSerializedSize() const {
   // total size = magic num(4) + table id(4) + table name(calculated by macro)
-  //              + table heap root page id(4) + table schema(calculated by its method)
-  return 4 + 4 + MACH_STR_SERIALIZED_SIZE(table_name_) + 4 + schema_->GetSerializedSize();
+  //              + table heap root page id(4 or 8) + table schema(calculated by its method)
+  //              + pool magic num(4) + pool id(4)
+  return 4 + 4 + MACH_STR_SERIALIZED_SIZE(table_name_) + sizeof(page_id_t) + schema_->GetSerializedSize() + 8;
 }
 
 /**
@@ -56,12 +62,21 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   buf += len;
   // table heap root page id
   page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
-  buf += 4;
+  buf += sizeof(page_id_t);
   // table schema
   TableSchema *schema = nullptr;
   buf += TableSchema::DeserializeFrom(buf, schema);
   // allocate space for table metadata
   table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+  // buffer pool binding, missing in the meta pages of older files
+  if (MACH_READ_UINT32(buf) == POOL_ID_MAGIC_NUM) {
+    buf += 4;
+    uint32_t pool_id = MACH_READ_UINT32(buf);
+    buf += 4;
+    if (pool_id < BufferPoolSet::NUM_POOLS) {
+      table_meta->pool_id_ = static_cast<BufferPoolId>(pool_id);
+    }
+  }
   return buf - p;
 }
 
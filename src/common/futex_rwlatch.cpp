@@ -0,0 +1,91 @@
+#include "common/futex_rwlatch.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+
+// the kernel looks at the word itself
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+static inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+void FutexReaderWriterLatch::WLockSlow() {
+  int spins = 0;
+  uint32_t state = state_.load(std::memory_order_relaxed);
+  while (true) {
+    if ((state & (READER_MASK | WRITER)) == 0) {
+      // the other writers waiting set WRITER_WAITING again before they sleep
+      if (state_.compare_exchange_weak(state, (state | WRITER) & ~WRITER_WAITING, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return;
+      }
+      continue;
+    }
+    if ((state & WRITER_WAITING) == 0) {
+      if (!state_.compare_exchange_weak(state, state | WRITER_WAITING, std::memory_order_relaxed)) {
+        continue;
+      }
+      state |= WRITER_WAITING;
+    }
+    if (spins < SPIN_LIMIT) {
+      spins++;
+      CpuRelax();
+      state = state_.load(std::memory_order_relaxed);
+      continue;
+    }
+    if ((state & SLEEPERS) == 0) {
+      if (!state_.compare_exchange_weak(state, state | SLEEPERS, std::memory_order_relaxed)) {
+        continue;
+      }
+      state |= SLEEPERS;
+    }
+    Wait(state);
+    state = state_.load(std::memory_order_relaxed);
+  }
+}
+
+void FutexReaderWriterLatch::RLockSlow() {
+  int spins = 0;
+  uint32_t state = state_.load(std::memory_order_relaxed);
+  while (true) {
+    if ((state & (WRITER | WRITER_WAITING)) == 0 && (state & READER_MASK) != READER_MASK) {
+      if (state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+      }
+      continue;
+    }
+    if (spins < SPIN_LIMIT) {
+      spins++;
+      CpuRelax();
+      state = state_.load(std::memory_order_relaxed);
+      continue;
+    }
+    if ((state & SLEEPERS) == 0) {
+      if (!state_.compare_exchange_weak(state, state | SLEEPERS, std::memory_order_relaxed)) {
+        continue;
+      }
+      state |= SLEEPERS;
+    }
+    Wait(state);
+    state = state_.load(std::memory_order_relaxed);
+  }
+}
+
+void FutexReaderWriterLatch::WakeAll() {
+  // a thread that sets SLEEPERS again after this is woken by the next release
+  state_.fetch_and(~SLEEPERS, std::memory_order_relaxed);
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&state_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void FutexReaderWriterLatch::Wait(uint32_t state) {
+  // returns right away if the word is no longer state, spurious wake-ups are handled by the callers
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&state_), FUTEX_WAIT_PRIVATE, state, nullptr, nullptr, 0);
+}
@@ -3,16 +3,38 @@
 //
 #include "common/instance.h"
 
-DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size)
+DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size, DurabilityMode durability,
+                                 DiskIOMode io_mode, ReplacerPolicy replacer_policy, uint32_t keep_pool_size,
+                                 uint32_t recycle_pool_size, uint32_t compressed_cache_size)
     : db_file_name_(std::move(db_name)), init_(init) {
   // Init database file if needed
   db_file_name_ = "./databases/" + db_file_name_;
+  if (init_ && io_mode == DiskIOMode::kMmapReadOnly) {
+    throw logic_error("Cannot initialize a read-only database.");
+  }
   if (init_) {
     remove(db_file_name_.c_str());
+    remove(BufferPoolWarmer::GetFileName(db_file_name_).c_str());
   }
   // Initialize components
-  disk_mgr_ = new DiskManager(db_file_name_);
-  bpm_ = new BufferPoolManager(buffer_pool_size, disk_mgr_);
+  disk_mgr_ = new DiskManager(db_file_name_, io_mode, durability);
+  size_t clean_frame_target = buffer_pool_size * DEFAULT_CLEAN_FRAME_PERCENT / 100;
+  if (buffer_pool_size >= DEFAULT_BUFFER_POOL_INSTANCES * 64) {
+    bpm_ = new ParallelBufferPoolManager(DEFAULT_BUFFER_POOL_INSTANCES, buffer_pool_size, disk_mgr_,
+                                         clean_frame_target, replacer_policy);
+  } else {
+    // small pools stay in one piece, otherwise a single instance runs out of frames too early
+    bpm_ = new BufferPoolManagerInstance(buffer_pool_size, disk_mgr_, clean_frame_target, replacer_policy);
+  }
+  keep_bpm_ = new BufferPoolManagerInstance(keep_pool_size, disk_mgr_,
+                                            keep_pool_size * DEFAULT_CLEAN_FRAME_PERCENT / 100, replacer_policy);
+  // the pages of a recycled object are rarely hit again, a clock is cheap enough
+  recycle_bpm_ = new BufferPoolManagerInstance(recycle_pool_size, disk_mgr_,
+                                               recycle_pool_size * DEFAULT_CLEAN_FRAME_PERCENT / 100,
+                                               ReplacerPolicy::kClock);
+  pools_ = new BufferPoolSet(bpm_, keep_bpm_, recycle_bpm_);
+  compressed_cache_ = new CompressedPageCache(static_cast<size_t>(compressed_cache_size) * PAGE_SIZE);
+  pools_->SetCompressedCache(compressed_cache_);
 
   // Allocate static page for db storage engine
   if (init) {
@@ -23,27 +45,42 @@ DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer
     if (!bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
       throw logic_error("Header page not free.");
     }
-    if (bpm_->NewPage(id) == nullptr || id != CATALOG_META_PAGE_ID) {
+    // the catalog pages live in the keep pool, scans of the default pool cannot push them out
+    if (keep_bpm_->NewPage(id) == nullptr || id != CATALOG_META_PAGE_ID) {
       throw logic_error("Failed to allocate catalog meta page.");
     }
-    if (bpm_->NewPage(id) == nullptr || id != INDEX_ROOTS_PAGE_ID) {
+    if (keep_bpm_->NewPage(id) == nullptr || id != INDEX_ROOTS_PAGE_ID) {
       throw logic_error("Failed to allocate header page.");
     }
     if (bpm_->IsPageFree(CATALOG_META_PAGE_ID) || bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
       exit(1);
     }
-    bpm_->UnpinPage(CATALOG_META_PAGE_ID, false);
-    bpm_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+    keep_bpm_->UnpinPage(CATALOG_META_PAGE_ID, false);
+    keep_bpm_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
   } else {
     ASSERT(!bpm_->IsPageFree(CATALOG_META_PAGE_ID), "Invalid catalog meta page.");
     ASSERT(!bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID), "Invalid header page.");
   }
-  catalog_mgr_ = new CatalogManager(bpm_, nullptr, nullptr, init);
+  // the pages of the list are reloaded alongside the first queries
+  warmer_ = new BufferPoolWarmer(bpm_, BufferPoolWarmer::GetFileName(db_file_name_));
+  checkpointer_ = new Checkpointer(pools_);
+  catalog_mgr_ = new CatalogManager(keep_bpm_, nullptr, nullptr, init, pools_);
+}
+
+size_t DBStorageEngine::GetFixedFrames() const {
+  return keep_bpm_->GetPoolSize() + recycle_bpm_->GetPoolSize() +
+         (compressed_cache_->GetCapacity() + PAGE_SIZE - 1) / PAGE_SIZE;
 }
 
 DBStorageEngine::~DBStorageEngine() {
+  delete checkpointer_;
+  delete warmer_;
   delete catalog_mgr_;
+  delete pools_;
+  delete recycle_bpm_;
+  delete keep_bpm_;
   delete bpm_;
+  delete compressed_cache_;
   delete disk_mgr_;
 }
 
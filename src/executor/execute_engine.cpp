@@ -16,7 +16,6 @@
 #include "executor/executors/update_executor.h"
 #include "executor/executors/values_executor.h"
 #include "glog/logging.h"
-#include "parser/minisql_yacc.h"
 #include "parser/syntax_tree_printer.h"
 #include "planner/planner.h"
 #include "utils/tree_file_mgr.h"
@@ -26,10 +25,14 @@ extern "C" {
 int yyparse(void);
 extern FILE *yyin;
 #include "parser/minisql_lex.h"
+#include "parser/minisql_yacc.h"
 #include "parser/parser.h"
 }
 
-ExecuteEngine::ExecuteEngine() {
+ExecuteEngine::ExecuteEngine(uint32_t buffer_pool_size, ReplacerPolicy replacer_policy)
+    : buffer_pool_size_(buffer_pool_size),
+      budget_(new BufferPoolBudget(buffer_pool_size)),
+      replacer_policy_(replacer_policy) {
   char path[] = "./databases";
   DIR *dir;
   if ((dir = opendir(path)) == nullptr) {
@@ -42,8 +45,13 @@ ExecuteEngine::ExecuteEngine() {
   struct dirent *stdir;
   while ((stdir = readdir(dir)) != nullptr) {
     if (strcmp(stdir->d_name, ".") == 0 || strcmp(stdir->d_name, "..") == 0 || stdir->d_name[0] == '.') continue;
-    dbs_[stdir->d_name] = new DBStorageEngine(stdir->d_name, false);
+    auto *db = new DBStorageEngine(stdir->d_name, false, budget_->GetInitialSize(), DurabilityMode::kWriteThrough,
+                                   DiskIOMode::kPositional, replacer_policy_, keep_pool_size_, recycle_pool_size_,
+                                   compressed_cache_size_);
+    budget_->Register(db->bpm_);
+    dbs_[stdir->d_name] = db;
   }
+  ReserveFixedFrames();
 
   closedir(dir);
 }
@@ -124,6 +132,16 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteShowDatabases(ast, context.get());
     case kNodeUseDB:
       return ExecuteUseDatabase(ast, context.get());
+    case kNodeShrinkDB:
+      return ExecuteShrinkDatabase(ast, context.get());
+    case kNodeSetVariable:
+      return ExecuteSetVariable(ast, context.get());
+    case kNodeCheckpoint:
+      return ExecuteCheckpoint(ast, context.get());
+    case kNodeAlterTable:
+      return ExecuteAlterTable(ast, context.get());
+    case kNodeAlterIndex:
+      return ExecuteAlterIndex(ast, context.get());
     case kNodeShowTables:
       return ExecuteShowTables(ast, context.get());
     case kNodeCreateTable:
@@ -255,7 +273,12 @@ dberr_t ExecuteEngine::ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *co
   if (dbs_.find(db_name) != dbs_.end()) {
     return DB_ALREADY_EXIST;
   }
-  dbs_.insert(make_pair(db_name, new DBStorageEngine(db_name, true)));
+  auto *db = new DBStorageEngine(db_name, true, budget_->GetInitialSize(), DurabilityMode::kWriteThrough,
+                                 DiskIOMode::kPositional, replacer_policy_, keep_pool_size_, recycle_pool_size_,
+                                 compressed_cache_size_);
+  budget_->Register(db->bpm_);
+  dbs_.insert(make_pair(db_name, db));
+  ReserveFixedFrames();
   return DB_SUCCESS;
 }
 
@@ -267,9 +290,12 @@ dberr_t ExecuteEngine::ExecuteDropDatabase(pSyntaxNode ast, ExecuteContext *cont
   if (dbs_.find(db_name) == dbs_.end()) {
     return DB_NOT_EXIST;
   }
+  budget_->Unregister(dbs_[db_name]->bpm_);
   delete dbs_[db_name];
   remove(("./databases/" + db_name).c_str());
+  remove(BufferPoolWarmer::GetFileName("./databases/" + db_name).c_str());
   dbs_.erase(db_name);
+  ReserveFixedFrames();
   if (db_name == current_db_) current_db_ = "";
   return DB_SUCCESS;
 }
@@ -313,6 +339,184 @@ dberr_t ExecuteEngine::ExecuteUseDatabase(pSyntaxNode ast, ExecuteContext *conte
   return DB_NOT_EXIST;
 }
 
+// execute sql statement "shrink database;"
+dberr_t ExecuteEngine::ExecuteShrinkDatabase(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteShrinkDatabase" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected" << endl;
+    return DB_FAILED;
+  }
+  uint32_t released = dbs_[current_db_]->disk_mgr_->Shrink();
+  cout << "Database shrunk, " << released << " extent(s) released" << endl;
+  return DB_SUCCESS;
+}
+
+/**
+ * Only the sizes of the buffer pools can be set for now: buffer_pool_size, the frames all pools and compressed caches
+ * share, keep_pool_size and recycle_pool_size, which are taken from it first, and compressed_cache_size, the pages of
+ * memory of the compressed second tier
+ */
+dberr_t ExecuteEngine::ExecuteSetVariable(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteSetVariable" << std::endl;
+#endif
+  std::string name = ast->child_->val_;
+  std::string value = ast->child_->next_->val_;
+  if (name == "compressed_cache_size") {
+    // 0 turns the second tier off
+    if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos) {
+      cout << "Invalid compressed cache size " << value << endl;
+      return DB_FAILED;
+    }
+    compressed_cache_size_ = static_cast<uint32_t>(std::stoul(value));
+    for (const auto &itr : dbs_) {
+      itr.second->compressed_cache_->SetCapacity(static_cast<size_t>(compressed_cache_size_) * PAGE_SIZE);
+    }
+    ReserveFixedFrames();
+    cout << "Compressed cache size set to " << compressed_cache_size_ << " pages" << endl;
+    return DB_SUCCESS;
+  }
+  uint32_t *pool_size;
+  BufferPoolId pool_id;
+  if (name == "buffer_pool_size") {
+    pool_size = &buffer_pool_size_;
+    pool_id = BufferPoolId::kDefault;
+  } else if (name == "keep_pool_size") {
+    pool_size = &keep_pool_size_;
+    pool_id = BufferPoolId::kKeep;
+  } else if (name == "recycle_pool_size") {
+    pool_size = &recycle_pool_size_;
+    pool_id = BufferPoolId::kRecycle;
+  } else {
+    cout << "Unknown variable " << name << endl;
+    return DB_FAILED;
+  }
+  if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos ||
+      std::stoul(value) == 0) {
+    cout << "Invalid buffer pool size " << value << endl;
+    return DB_FAILED;
+  }
+  auto buffer_pool_size = static_cast<uint32_t>(std::stoul(value));
+  if (pool_id == BufferPoolId::kDefault) {
+    // the default pools grow into a larger budget as they miss
+    budget_->SetBudget(buffer_pool_size);
+    *pool_size = buffer_pool_size;
+    cout << "Buffer pool size set to " << buffer_pool_size << " pages" << endl;
+    return DB_SUCCESS;
+  }
+  // every database has buffer pools of its own, the databases opened later get the new size as well
+  std::vector<std::pair<BufferPoolManager *, size_t>> resized;
+  for (const auto &itr : dbs_) {
+    BufferPoolManager *bpm = itr.second->pools_->GetPool(pool_id);
+    size_t old_size = bpm->GetPoolSize();
+    if (!bpm->Resize(buffer_pool_size)) {
+      cout << "Unable to resize the " << BufferPoolSet::GetPoolName(pool_id) << " buffer pool of database "
+           << itr.first << endl;
+      // the pools resized so far go back to their old size, so that all databases keep the same one
+      for (auto &pool : resized) {
+        if (!pool.first->Resize(pool.second)) {
+          LOG(ERROR) << "Unable to restore buffer pool to " << pool.second << " frames";
+        }
+      }
+      return DB_FAILED;
+    }
+    resized.emplace_back(bpm, old_size);
+  }
+  // the default pools make room for larger keep or recycle pools
+  ReserveFixedFrames();
+  *pool_size = buffer_pool_size;
+  cout << "Size of the " << BufferPoolSet::GetPoolName(pool_id) << " pool set to " << buffer_pool_size << " pages"
+       << endl;
+  return DB_SUCCESS;
+}
+
+/**
+ * Checkpoint every open database, not only the current one
+ */
+dberr_t ExecuteEngine::ExecuteCheckpoint(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteCheckpoint" << std::endl;
+#endif
+  size_t num_written = 0;
+  for (const auto &itr : dbs_) {
+    num_written += itr.second->pools_->Checkpoint();
+  }
+  cout << "Checkpoint done, " << num_written << " page(s) written" << endl;
+  return DB_SUCCESS;
+}
+
+// execute sql statement "alter table <table> set pool <pool>;"
+dberr_t ExecuteEngine::ExecuteAlterTable(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAlterTable" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected" << endl;
+    return DB_FAILED;
+  }
+  string table_name = ast->child_->val_;
+  string pool_name = ast->child_->next_->val_;
+  BufferPoolId pool_id;
+  if (!BufferPoolSet::ParsePoolName(pool_name, &pool_id)) {
+    cout << "Unknown buffer pool " << pool_name << endl;
+    return DB_FAILED;
+  }
+  dberr_t res = context->GetCatalog()->SetTablePool(table_name, pool_id);
+  if (res == DB_TABLE_NOT_EXIST) {
+    return res;
+  }
+  if (res != DB_SUCCESS) {
+    cout << "Unable to move table " << table_name << " to the " << pool_name << " pool" << endl;
+    return res;
+  }
+  cout << "Table " << table_name << " moved to the " << pool_name << " pool" << endl;
+  return DB_SUCCESS;
+}
+
+// execute sql statement "alter index <index> set pool <pool>;"
+dberr_t ExecuteEngine::ExecuteAlterIndex(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAlterIndex" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected" << endl;
+    return DB_FAILED;
+  }
+  string index_name = ast->child_->val_;
+  string pool_name = ast->child_->next_->val_;
+  BufferPoolId pool_id;
+  if (!BufferPoolSet::ParsePoolName(pool_name, &pool_id)) {
+    cout << "Unknown buffer pool " << pool_name << endl;
+    return DB_FAILED;
+  }
+  // find the table of the index like drop index does
+  auto catalog = context->GetCatalog();
+  string table_name;
+  vector<TableInfo *> tables;
+  if (catalog->GetTables(tables) == DB_FAILED) return DB_FAILED;
+  for (const auto &table : tables) {
+    vector<IndexInfo *> indexes;
+    if (catalog->GetTableIndexes(table->GetTableName(), indexes) != DB_SUCCESS) continue;
+    for (const auto &index : indexes) {
+      if (index->GetIndexName() == index_name) {
+        table_name = table->GetTableName();
+      }
+    }
+  }
+  dberr_t res = catalog->SetIndexPool(table_name, index_name, pool_id);
+  if (res == DB_TABLE_NOT_EXIST || res == DB_INDEX_NOT_FOUND) {
+    return DB_INDEX_NOT_FOUND;
+  }
+  if (res != DB_SUCCESS) {
+    cout << "Unable to move index " << index_name << " to the " << pool_name << " pool" << endl;
+    return res;
+  }
+  cout << "Index " << index_name << " moved to the " << pool_name << " pool" << endl;
+  return DB_SUCCESS;
+}
+
 dberr_t ExecuteEngine::ExecuteShowTables(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteShowTables" << std::endl;
@@ -661,8 +865,9 @@ dberr_t ExecuteEngine::ExecuteTrxCommit(pSyntaxNode ast, ExecuteContext *context
     cout << "No database selected" << endl;
     return DB_FAILED;
   }
-
-  return DB_FAILED;
+  // commit barrier: everything written so far is on disk once this returns
+  dbs_[current_db_]->pools_->Sync();
+  return DB_SUCCESS;
 }
 
 dberr_t ExecuteEngine::ExecuteTrxRollback(pSyntaxNode ast, ExecuteContext *context) {
@@ -767,3 +972,11 @@ dberr_t ExecuteEngine::ExecuteQuit(pSyntaxNode ast, ExecuteContext *context) {
   current_db_ = "";
   return DB_QUIT;
 }
+
+void ExecuteEngine::ReserveFixedFrames() {
+  size_t reserved = 0;
+  for (const auto &itr : dbs_) {
+    reserved += itr.second->GetFixedFrames();
+  }
+  budget_->SetReserved(reserved);
+}
@@ -2,7 +2,7 @@
 
 class RowidCompare {
  public:
-  bool operator()(RowId rid1, RowId rid2) { return rid1.Get() < rid2.Get(); }
+  bool operator()(RowId rid1, RowId rid2) { return rid1 < rid2; }
 };
 
 IndexScanExecutor::IndexScanExecutor(ExecuteContext *exec_ctx, const IndexScanPlanNode *plan)
@@ -29,7 +29,7 @@ bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
         return false;
       }
     }
-    if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction())) {
+    if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction(), &strategy_)) {
       Row key_row;
       for (auto info : index_info_) {  // 更新索引
         insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
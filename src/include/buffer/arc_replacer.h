@@ -0,0 +1,83 @@
+#ifndef MINISQL_ARC_REPLACER_H
+#define MINISQL_ARC_REPLACER_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+/**
+ * ARCReplacer implements the adaptive replacement cache. Frames whose page was accessed once are kept in the recent
+ * list, frames accessed again move to the frequent list. The pages evicted from each list are remembered in a ghost
+ * list, a page that is loaded again while it is in a ghost list grows the share of that list. A scan only fills the
+ * recent list, so it evicts the frequent pages only once the frequent list has proven less useful.
+ */
+class ARCReplacer : public Replacer {
+ public:
+  /**
+   * @param num_pages the maximum number of pages the ARCReplacer will be required to store
+   */
+  explicit ARCReplacer(size_t num_pages);
+
+  ~ARCReplacer() override;
+
+  bool VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  /**
+   * Like Admit, without looking at the ghost lists
+   */
+  void Unpin(frame_id_t frame_id) override;
+
+  void Admit(frame_id_t frame_id, page_id_t page_id) override;
+
+  void RecordAccess(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+  void PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) override;
+
+  void Resize(size_t num_frames) override;
+
+ private:
+  enum class ListType { kNone, kRecent, kFrequent };
+
+  struct FrameEntry {
+    ListType list_{ListType::kNone};
+    std::list<frame_id_t>::iterator pos_;
+    page_id_t page_id_{INVALID_PAGE_ID};
+  };
+
+  /**
+   * @return the list victims are taken from first, the other list is only used if it has no evictable frame
+   */
+  ListType PreferredList() const;
+
+  std::list<frame_id_t> &GetList(ListType type) { return type == ListType::kRecent ? recent_ : frequent_; }
+
+  /**
+   * Remember the page of a frame evicted from list type, the oldest ghosts are dropped to keep the directory at twice
+   * the number of frames
+   */
+  void AddGhost(ListType type, page_id_t page_id);
+
+  /**
+   * Drop the oldest ghosts until the directory fits the capacity
+   */
+  void TrimGhosts();
+
+  size_t capacity_;
+  size_t recent_target_{0};  // share of the frames the recent list is allowed to take before it is evicted first
+  std::vector<FrameEntry> frames_;
+  std::list<frame_id_t> recent_;            // T1, most recently used at the front
+  std::list<frame_id_t> frequent_;          // T2, most recently used at the front
+  std::list<page_id_t> recent_ghosts_;      // B1, pages evicted from T1, most recent at the front
+  std::list<page_id_t> frequent_ghosts_;    // B2, pages evicted from T2, most recent at the front
+  std::unordered_map<page_id_t, std::pair<ListType, std::list<page_id_t>::iterator>> ghosts_;
+};
+
+#endif  // MINISQL_ARC_REPLACER_H
@@ -0,0 +1,79 @@
+#ifndef MINISQL_BUFFER_ACCESS_STRATEGY_H
+#define MINISQL_BUFFER_ACCESS_STRATEGY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+
+class BufferPoolManager;
+
+/**
+ * Kind of bulk operation a BufferAccessStrategy is made for.
+ */
+enum class BufferAccessType {
+  kBulkRead, /** sequential scans and index builds, which read each page once */
+  kBulkWrite /** bulk inserts, whose pages are dirty when the ring comes around */
+};
+
+/**
+ * BufferAccessStrategy gives a bulk operation a small ring of frames of its own. A miss of the operation reuses the
+ * frame the ring holds at its current position, if that frame still holds the page the operation put there and is not
+ * pinned, instead of evicting the victim of the replacer. A scan of a table larger than the buffer pool then only
+ * takes the frames of its ring, and the pages other sessions work on stay resident. Pages the operation finds
+ * resident are used as they are.
+ *
+ * The ring starts empty and is filled by misses that go through the replacer. A strategy belongs to one operation and
+ * must not be shared between threads. The frames of a ParallelBufferPoolManager are split over the instances, so the
+ * strategy keeps one ring per instance.
+ */
+class BufferAccessStrategy {
+ public:
+  explicit BufferAccessStrategy(BufferAccessType type);
+
+  /**
+   * Look at the current position of the ring of pool
+   * @param max_frames number of frames the ring of pool may hold at most
+   * @param[out] page_id page the frame was given by the operation
+   * @return frame at the current position, INVALID_FRAME_ID if the ring is not full yet
+   */
+  frame_id_t GetCurrentFrame(const BufferPoolManager *pool, size_t max_frames, page_id_t *page_id);
+
+  /**
+   * Put the frame that now holds page_id at the current position of the ring of pool and move to the next position
+   */
+  void Remember(const BufferPoolManager *pool, frame_id_t frame_id, page_id_t page_id);
+
+  // a read ring must hold the pages read ahead by a scan, with room to spare
+  static constexpr size_t BULK_READ_RING_SIZE = std::max(256 * 1024 / PAGE_SIZE, 32);
+  static constexpr size_t BULK_WRITE_RING_SIZE = std::max(4 * 1024 * 1024 / PAGE_SIZE, 32);
+  // a ring takes at most this share of the frames of a pool
+  static constexpr size_t MAX_RING_SHARE = 8;
+
+ private:
+  struct Slot {
+    frame_id_t frame_id_{INVALID_FRAME_ID};
+    page_id_t page_id_{INVALID_PAGE_ID};
+  };
+
+  struct Ring {
+    std::vector<Slot> slots_;
+    size_t next_{0};
+  };
+
+  /**
+   * @return ring of pool, cut down if the pool got smaller since its last use
+   */
+  Ring &GetRing(const BufferPoolManager *pool, size_t max_frames);
+
+  inline size_t GetRingSize(size_t max_frames) const {
+    return std::min(ring_size_, std::max<size_t>(max_frames / MAX_RING_SHARE, 1));
+  }
+
+  size_t ring_size_;
+  std::unordered_map<const BufferPoolManager *, Ring> rings_;
+};
+
+#endif  // MINISQL_BUFFER_ACCESS_STRATEGY_H
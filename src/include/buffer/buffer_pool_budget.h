@@ -0,0 +1,139 @@
+#ifndef MINISQL_BUFFER_POOL_BUDGET_H
+#define MINISQL_BUFFER_POOL_BUDGET_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * BufferPoolBudget shares one number of frames between the buffer pools of all open databases, so that the memory of
+ * the buffer pools does not grow with the number of databases.
+ *
+ * Every interval a background thread looks at the misses of each pool since the last pass. Pools that miss split the
+ * budget in proportion to their misses, pools that do not miss keep their frames until another pool needs them, and
+ * then give back half of what they hold above MIN_POOL_SIZE each pass. The pages of an idle database thus leave the
+ * memory through the replacer of its pool like any other eviction. Pools are shrunk before others grow, and the sum of
+ * their sizes is kept within the budget.
+ *
+ * Memory of fixed size that sits beside the registered pools, e.g. the keep and recycle pools and the compressed caches
+ * of the databases, is reserved from the budget, the registered pools share what is left.
+ */
+class BufferPoolBudget {
+ public:
+  /**
+   * @param budget number of frames the registered pools have together
+   * @param interval how often the frames are split again
+   */
+  explicit BufferPoolBudget(size_t budget, std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+  /**
+   * Stop the thread, the registered pools must still be alive
+   */
+  ~BufferPoolBudget();
+
+  /**
+   * @return number of frames a pool about to be registered should be created with
+   */
+  size_t GetInitialSize();
+
+  /**
+   * Share the budget with bpm, the other pools are shrunk right away if the budget is exceeded
+   */
+  void Register(BufferPoolManager *bpm);
+
+  /**
+   * Stop sharing the budget with bpm, must be called before bpm is deleted. Waits if bpm is being resized.
+   */
+  void Unregister(BufferPoolManager *bpm);
+
+  void SetBudget(size_t budget);
+
+  size_t GetBudget();
+
+  /**
+   * Set the number of frames held outside the registered pools, they are shrunk right away if the rest is exceeded
+   */
+  void SetReserved(size_t reserved);
+
+  size_t GetReserved();
+
+  /**
+   * Split the budget between the registered pools now
+   */
+  void Rebalance();
+
+  static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{1000};
+  // a pool is not shrunk below this number of frames, unless the budget is too small for it
+  static constexpr size_t MIN_POOL_SIZE = 64;
+  // a pool is only resized if its size changes by at least 1/RESIZE_SHARE, resizing takes the latch of the pool
+  static constexpr size_t RESIZE_SHARE = 16;
+
+ private:
+  struct Member {
+    BufferPoolManager *bpm_;
+    size_t last_misses_;
+    size_t demand_{0};  // misses per pass, halved every pass
+  };
+
+  using Targets = std::vector<std::pair<BufferPoolManager *, size_t>>;
+
+  void Run();
+
+  /**
+   * Split the budget by the misses of the pools since the last pass, latch_ must be held
+   */
+  Targets ComputeTargets();
+
+  /**
+   * Cut sizes, one per member, down to fit in the budget, latch_ must be held
+   */
+  Targets FitTargets(std::vector<size_t> sizes);
+
+  /**
+   * Resize the pools towards targets, shrinks first, then grows within the budget. latch_ must not be held, pools are
+   * resized without it so that a resize waiting for pinned pages does not hold up the others.
+   */
+  void ApplyTargets(const Targets &targets, bool grow);
+
+  /**
+   * Decide how far bpm is resized towards target, with the sizes of all pools at this point, and mark it as being
+   * resized. Unregister waits for a pool that is being resized.
+   * @param[out] pool_size size bpm is to be resized to
+   * @return false if bpm is not resized, e.g. because it is unregistered or resized by another thread
+   */
+  bool BeginResize(BufferPoolManager *bpm, size_t target, bool grow, size_t *pool_size);
+
+  void EndResize(BufferPoolManager *bpm);
+
+  /**
+   * @return number of frames the registered pools share, latch_ must be held
+   */
+  inline size_t GetShared() const { return budget_ > reserved_ ? budget_ - reserved_ : 0; }
+
+  inline size_t GetFloor() const {
+    return std::max<size_t>(std::min(MIN_POOL_SIZE, GetShared() / std::max<size_t>(members_.size(), 1)), 1);
+  }
+
+  inline size_t GetMinStep(size_t pool_size) const { return std::max<size_t>(pool_size / RESIZE_SHARE, 1); }
+
+ private:
+  size_t budget_;
+  size_t reserved_{0};
+  std::chrono::milliseconds interval_;
+  std::vector<Member> members_;
+  std::unordered_set<BufferPoolManager *> resizing_;  // pools being resized, outside of latch_
+  std::thread thread_;
+  std::mutex latch_;
+  std::mutex pass_latch_;  // one rebalancing pass at a time, only passes grow pools
+  std::condition_variable cv_;
+  bool stop_{false};
+};
+
+#endif  // MINISQL_BUFFER_POOL_BUDGET_H
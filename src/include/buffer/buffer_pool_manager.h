@@ -1,58 +1,126 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
-#include <list>
-#include <mutex>
-#include <unordered_map>
+#include <vector>
 
-#include "buffer/lru_replacer.h"
-#include "page/disk_file_meta_page.h"
+#include "buffer/buffer_access_strategy.h"
+#include "buffer/compressed_page_cache.h"
 #include "page/page.h"
 #include "storage/disk_manager.h"
 
 using namespace std;
 
+/**
+ * BufferPoolManager is the interface the catalog, table heaps and indexes use to access pages. It is implemented by
+ * BufferPoolManagerInstance, a single pool of frames, and ParallelBufferPoolManager, which spreads the pages over
+ * several instances so that threads working on different pages do not contend on one latch.
+ */
 class BufferPoolManager {
  public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  BufferPoolManager() = default;
 
-  ~BufferPoolManager();
+  virtual ~BufferPoolManager() = default;
 
-  Page *FetchPage(page_id_t page_id);
+  Page *FetchPage(page_id_t page_id) { return FetchPage(page_id, nullptr); }
 
-  bool UnpinPage(page_id_t page_id, bool is_dirty);
+  /**
+   * @param strategy ring of frames of a bulk operation, a miss takes its frame from there, nullptr for none
+   * @return the page pinned, nullptr if every frame is pinned
+   */
+  virtual Page *FetchPage(page_id_t page_id, BufferAccessStrategy *strategy) = 0;
+
+  /**
+   * Fetch several pages at once, the reads of all pages that miss are in flight at the same time
+   * @return pinned pages in the order of page_ids, nullptr for the pages that could not get a frame
+   */
+  virtual std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) = 0;
+
+  void Prefetch(const std::vector<page_id_t> &page_ids) { Prefetch(page_ids, nullptr); }
+
+  /**
+   * Start reading pages that are not in the buffer pool yet and return without waiting. The pages are not pinned, a
+   * later FetchPage of such a page waits for its read if it is still in flight.
+   * @param strategy ring of frames of a bulk operation the pages are read into, nullptr for none
+   */
+  virtual void Prefetch(const std::vector<page_id_t> &page_ids, BufferAccessStrategy *strategy) = 0;
+
+  virtual bool UnpinPage(page_id_t page_id, bool is_dirty) = 0;
+
+  virtual bool FlushPage(page_id_t page_id) = 0;
+
+  /**
+   * Write back all dirty pages without making them durable
+   */
+  virtual void FlushAllPages() = 0;
+
+  /**
+   * Write back all dirty pages and the page allocation state and make them durable, used as the commit barrier
+   */
+  virtual void Sync() = 0;
+
+  /**
+   * Write back all dirty pages in the order of their offset in the db file, together with the page allocation state
+   * of the disk manager, and make everything durable
+   * @return number of pages written
+   */
+  virtual size_t Checkpoint() = 0;
+
+  Page *NewPage(page_id_t &page_id) { return NewPage(page_id, nullptr, nullptr); }
+
+  Page *NewPage(page_id_t &page_id, ExtentReservation *reservation) { return NewPage(page_id, reservation, nullptr); }
+
+  /**
+   * Create a new page whose id comes from the reservation of a table heap or index, or from the disk manager if
+   * reservation is nullptr
+   * @param strategy ring of frames of a bulk operation, the page takes its frame from there, nullptr for none
+   */
+  virtual Page *NewPage(page_id_t &page_id, ExtentReservation *reservation, BufferAccessStrategy *strategy) = 0;
+
+  /**
+   * Give the pages of the reservation that were not used yet back to the disk manager
+   */
+  virtual void ReleaseReservation(ExtentReservation *reservation) = 0;
 
-  bool FlushPage(page_id_t page_id);
+  virtual bool DeletePage(page_id_t page_id) = 0;
 
-  Page *NewPage(page_id_t &page_id);
+  /**
+   * Drop a page from the buffer pool without deallocating it, a dirty page is written back first
+   * @return false if the page is pinned, true if it is not resident (anymore)
+   */
+  virtual bool EvictPage(page_id_t page_id) = 0;
 
-  bool DeletePage(page_id_t page_id);
+  virtual bool IsPageFree(page_id_t page_id) = 0;
 
-  bool IsPageFree(page_id_t page_id);
+  virtual bool CheckAllUnpinned() = 0;
 
-  bool CheckAllUnpinned();
+  /**
+   * @return number of frames
+   */
+  virtual size_t GetPoolSize() = 0;
 
- private:
   /**
-   * Allocate new page (operations like create index/table) For now just keep an increasing counter
+   * Change the number of frames while the pool is in use. Growing adds free frames. Shrinking evicts the pages of the
+   * frames that go away, dirty pages are written back, and waits a while for pinned ones to be unpinned.
+   * @return false if the pool keeps its old size, e.g. because pages stayed pinned
    */
-  page_id_t AllocatePage();
+  virtual bool Resize(size_t pool_size) = 0;
 
   /**
-   * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
+   * @return number of frames taken for pages that were not resident, by misses, reads ahead and new pages, since the
+   * pool was created. Frames reused from the ring of a bulk operation are not counted.
    */
-  void DeallocatePage(page_id_t page_id);
+  virtual size_t GetNumMisses() = 0;
 
-  // frame_id_t TryToFindFreePage();
+  /**
+   * Append the ids of the resident pages, the pages the replacer would evict last come first
+   */
+  virtual void GetResidentPages(std::vector<page_id_t> *page_ids) = 0;
 
- private:
-  size_t pool_size_;                                 // number of pages in buffer pool
-  Page *pages_;                                      // array of pages
-  DiskManager *disk_manager_;                        // pointer to the disk manager.
-  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
-  Replacer *replacer_;                               // to find an unpinned page for replacement
-  list<frame_id_t> free_list_;                       // to find a free page for replacement
-  recursive_mutex latch_;                            // to protect shared data structure
+  /**
+   * Put the evicted pages into cache and look for missing pages there before reading them, nullptr for no second
+   * tier. Must be set before the pool is used, the cache has to outlive the pool.
+   */
+  virtual void SetCompressedCache(CompressedPageCache *cache) = 0;
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
@@ -0,0 +1,351 @@
+#ifndef MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+#define MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/concurrent_page_table.h"
+#include "buffer/frame_arena.h"
+#include "buffer/replacer.h"
+#include "page/disk_file_meta_page.h"
+#include "page/page.h"
+#include "storage/disk_manager.h"
+
+/**
+ * A single pool of frames. Fetching a resident page and unpinning a page only use atomic operations on the page table
+ * and the page, everything else holds the latch of the pool.
+ *
+ * Resident frames stay in the replacer while they are pinned, the replacer skips pinned frames when it picks a victim.
+ * Unless the replacer takes accesses without the latch, a hit appends the frame to a lock-free access log instead, at
+ * most once until the log is drained. Whoever holds the latch next drains the log into the replacer before picking a
+ * victim.
+ *
+ * With a clean frame target, a cleaner thread writes back dirty pages ahead of the victim order of the replacer, so
+ * that a miss finds a clean frame and does not wait for a write.
+ *
+ * Every chunk of frames keeps a bitmap of its dirty frames, so that a checkpoint only looks at the frames it has to
+ * write. It writes them in batches sorted by page id, which the disk manager turns into runs of contiguous pages.
+ *
+ * Frames are allocated in chunks of one huge page, so that the pool can be resized without moving the frames that
+ * stay. A frame that is taken away by shrinking stays locked and its descriptor is kept, hits racing with the resize
+ * may still look at it. The data of a chunk is released once all of its frames are gone.
+ */
+class BufferPoolManagerInstance : public BufferPoolManager {
+ public:
+  /**
+   * @param clean_frame_target number of frames the cleaner thread keeps free or clean, 0 runs no cleaner
+   * @param policy replacement policy of the pool
+   */
+  explicit BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager, size_t clean_frame_target = 0,
+                                     ReplacerPolicy policy = ReplacerPolicy::kLRU);
+
+  ~BufferPoolManagerInstance() override;
+
+  using BufferPoolManager::FetchPage;
+
+  Page *FetchPage(page_id_t page_id, BufferAccessStrategy *strategy) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  /**
+   * A FetchPages call whose reads are in flight, the latch of the instance is held until they are completed
+   */
+  struct PendingFetch {
+    std::unique_lock<std::recursive_mutex> lock_;
+    std::vector<Page *> pages_;
+    std::vector<IOHandle> reads_;
+    // frames being read, with the number of times their page is requested
+    std::unordered_map<page_id_t, std::pair<frame_id_t, int>> loading_;
+  };
+
+  /**
+   * First half of FetchPages: pin the resident pages and issue the reads of the others. Used by
+   * ParallelBufferPoolManager, which issues the reads of all instances before it waits for any of them.
+   */
+  void SubmitFetches(const std::vector<page_id_t> &page_ids, PendingFetch *fetch);
+
+  /**
+   * Second half of FetchPages: wait for the reads and publish their frames
+   * @return pinned pages in the order of page_ids, nullptr for the pages that could not get a frame
+   */
+  std::vector<Page *> CompleteFetches(PendingFetch *fetch);
+
+  /**
+   * Reads in flight never take more than a quarter of the frames, the remaining pages are skipped
+   */
+  using BufferPoolManager::Prefetch;
+
+  void Prefetch(const std::vector<page_id_t> &page_ids, BufferAccessStrategy *strategy) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  void FlushAllPages() override;
+
+  void Sync() override;
+
+  size_t Checkpoint() override;
+
+  /**
+   * Write back the dirty pages found in the dirty bitmaps of instances without making them durable. The pages of all
+   * instances are written together, so that runs of contiguous pages spread over several instances are coalesced.
+   * @param instances pools sharing one disk manager
+   * @return number of pages written
+   */
+  static size_t FlushDirtyPages(const std::vector<BufferPoolManagerInstance *> &instances);
+
+  using BufferPoolManager::NewPage;
+
+  Page *NewPage(page_id_t &page_id, ExtentReservation *reservation, BufferAccessStrategy *strategy) override;
+
+  /**
+   * Put a page that was just allocated on disk into a frame, used by ParallelBufferPoolManager which has to know the
+   * page id to pick the instance
+   * @return the zeroed page pinned, nullptr if every frame is pinned or an old copy of the page is still in use
+   */
+  Page *CreatePage(page_id_t page_id, BufferAccessStrategy *strategy = nullptr);
+
+  void ReleaseReservation(ExtentReservation *reservation) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool EvictPage(page_id_t page_id) override;
+
+  bool IsPageFree(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  size_t GetPoolSize() override { return pool_size_.load(std::memory_order_relaxed); }
+
+  /**
+   * Frames are added and removed at the end, so shrinking evicts the pages of the last frames
+   */
+  bool Resize(size_t pool_size) override;
+
+  size_t GetNumMisses() override { return num_misses_.load(std::memory_order_relaxed); }
+
+  void GetResidentPages(std::vector<page_id_t> *page_ids) override;
+
+  /**
+   * A read-only pool serves its pages from the mapping of the db file and uses no second tier
+   */
+  void SetCompressedCache(CompressedPageCache *cache) override { compressed_cache_ = read_only_ ? nullptr : cache; }
+
+  /**
+   * Write back dirty unpinned pages in victim order until clean_frame_target frames can be taken without a write,
+   * run by the cleaner thread
+   * @return number of pages written
+   */
+  size_t CleanFrames();
+
+ private:
+  /**
+   * Allocate new page (operations like create index/table) For now just keep an increasing counter
+   */
+  page_id_t AllocatePage();
+
+  /**
+   * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
+   */
+  void DeallocatePage(page_id_t page_id);
+
+  /**
+   * Pin page_id if it is resident, takes no latch
+   * @return nullptr if the page is not resident or the lookup raced with an eviction
+   */
+  Page *TryPinResident(page_id_t page_id);
+
+  /**
+   * Append an access to frame_id to the access log, takes no latch
+   * @return false if the log is full
+   */
+  bool LogAccess(frame_id_t frame_id);
+
+  /**
+   * Pass the logged accesses to the replacer, the latch must be held
+   */
+  void DrainAccessLog();
+
+  /**
+   * Take a frame from the free list, or evict the victim of the replacer. The frame is returned locked, i.e. with
+   * FRAME_LOCKED as its pin count, so that no hit can pin it before it holds its new page.
+   * @param strategy if not nullptr, the current frame of its ring is taken instead if it still holds the page the
+   * ring put there and is not pinned
+   * @return false if every frame is pinned
+   */
+  bool FindFrame(frame_id_t *frame_id, BufferAccessStrategy *strategy = nullptr);
+
+  /**
+   * Give a frame taken by FindFrame to page_id, the strategy puts the frame into its ring
+   */
+  void AssignFrame(frame_id_t frame_id, page_id_t page_id, BufferAccessStrategy *strategy);
+
+  /**
+   * Write back the page of a locked frame if it is dirty and remove the page from the page table
+   * @param keep_compressed whether the page goes to the compressed cache, pages of a bulk operation do not
+   */
+  void EvictFrame(frame_id_t frame_id, bool keep_compressed = true);
+
+  /**
+   * Fill the frame of a miss from the compressed cache
+   * @return false if the page has to be read from disk
+   */
+  inline bool TakeCompressed(page_id_t page_id, char *data) {
+    return compressed_cache_ != nullptr && compressed_cache_->Take(page_id, data, this);
+  }
+
+  /**
+   * Drop the copy of a page that was just allocated, left in the pool from before the page was freed. With several
+   * pools on one db file, e.g. the warmer may have read a page of an object bound to another pool into this one.
+   * @return false if the copy is still pinned or being written back, the page cannot be used until it is released
+   */
+  bool DropStaleCopy(page_id_t page_id);
+
+  /**
+   * Make a frame filled by FindFrame visible to hits, with pin_count pins held by the caller
+   */
+  void PublishFrame(frame_id_t frame_id, int pin_count);
+
+  /**
+   * Wait for the prefetch of page_id and publish its frame with pin_count pins
+   * @return the page, nullptr if the read failed
+   */
+  Page *FinishPrefetch(page_id_t page_id, int pin_count);
+
+  /**
+   * Publish the prefetched pages whose read has completed, unpinned
+   * @param wait wait for the reads still in flight as well
+   */
+  void CompletePrefetches(bool wait);
+
+  /**
+   * @return data of specific page in the mapping of the db file, only used by a read-only buffer pool
+   */
+  char *GetMappedData(page_id_t page_id);
+
+  void CleanerLoop();
+
+  /**
+   * Make frames [begin, end) available and put them into the free list, allocating their chunks if needed
+   */
+  void AddFrames(size_t begin, size_t end);
+
+  /**
+   * Evict the pages of frames [begin, end) and take the frames out of the free list, the latch must be held. Frames
+   * that are taken stay locked and are appended to taken, pinned frames are left alone.
+   * @return true if all frames were taken
+   */
+  bool TakeFrames(size_t begin, size_t end, std::vector<frame_id_t> *taken);
+
+  inline Page *GetPage(frame_id_t frame_id) const {
+    return &chunks_[frame_id / FRAMES_PER_CHUNK]->pages_[frame_id % FRAMES_PER_CHUNK];
+  }
+
+  inline PageMeta *GetMeta(frame_id_t frame_id) const {
+    return &chunks_[frame_id / FRAMES_PER_CHUNK]->metas_[frame_id % FRAMES_PER_CHUNK];
+  }
+
+  inline ConcurrentPageTable *GetPageTable() const { return page_table_.load(std::memory_order_acquire); }
+
+  inline std::atomic<uint64_t> &GetDirtyWord(frame_id_t frame_id) const {
+    return chunks_[frame_id / FRAMES_PER_CHUNK]->dirty_bits_[frame_id % FRAMES_PER_CHUNK / 64];
+  }
+
+  /**
+   * @return whether the cleaner or a checkpoint is writing the page of the frame, the frame must not be evicted
+   */
+  inline bool IsWritingBack(frame_id_t frame_id) {
+    return cleaning_frame_.load() == frame_id || GetMeta(frame_id)->write_back_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Set the dirty flag of a frame, then its bit in the dirty bitmap
+   */
+  inline void MarkDirty(frame_id_t frame_id) {
+    GetMeta(frame_id)->is_dirty_.store(true, std::memory_order_relaxed);
+    GetDirtyWord(frame_id).fetch_or(uint64_t{1} << (frame_id % FRAMES_PER_CHUNK % 64), std::memory_order_release);
+  }
+
+  /**
+   * Clear the bit of a frame in the dirty bitmap, then its dirty flag. A page dirtied in between keeps both set, a bit
+   * without the flag is only skipped by the next checkpoint.
+   * @return whether the frame was dirty, i.e. its page has to be written
+   */
+  inline bool TakeDirty(frame_id_t frame_id) {
+    GetDirtyWord(frame_id).fetch_and(~(uint64_t{1} << (frame_id % FRAMES_PER_CHUNK % 64)), std::memory_order_relaxed);
+    return GetMeta(frame_id)->is_dirty_.exchange(false, std::memory_order_acquire);
+  }
+
+  /**
+   * Descriptors and data of FRAMES_PER_CHUNK frames
+   */
+  struct FrameChunk {
+    FrameChunk();
+
+    ~FrameChunk();
+
+    std::unique_ptr<PageMeta[]> metas_;  // page id, pin count and flags of the frames, dense
+    Page *pages_;                        // descriptors of the frames
+    std::unique_ptr<FrameArena> arena_;  // page data of the frames, not used by a read-only pool
+    std::unique_ptr<std::atomic<uint64_t>[]> dirty_bits_;  // one bit per frame that may be dirty
+  };
+
+  // one huge page of frames per chunk
+  static constexpr size_t FRAMES_PER_CHUNK = std::max<size_t>(FrameArena::HUGE_PAGE_SIZE / PAGE_SIZE, 1);
+  static constexpr size_t MAX_CHUNKS = 4096;
+  static constexpr size_t DIRTY_WORDS_PER_CHUNK = (FRAMES_PER_CHUNK + 63) / 64;
+
+ private:
+  std::atomic<size_t> pool_size_;                    // number of pages in buffer pool
+  // chunks of frames, chunks are never freed while the pool is alive, only the data of the chunks no longer used
+  std::unique_ptr<std::unique_ptr<FrameChunk>[]> chunks_;
+  DiskManager *disk_manager_;                        // pointer to the disk manager.
+  std::atomic<ConcurrentPageTable *> page_table_;    // to keep track of pages
+  // all page tables, the last one is in use, the others may still be read by hits that looked them up before a resize
+  std::vector<std::unique_ptr<ConcurrentPageTable>> page_tables_;
+  std::unique_ptr<Replacer> replacer_;               // to find an unpinned page for replacement
+  bool hits_record_access_;                          // hits pass their access to the replacer instead of the log
+  list<frame_id_t> free_list_;                       // to find a free page for replacement
+  recursive_mutex latch_;                            // to protect shared data structure
+  bool read_only_;                                   // pages are served from a read-only mapping of the db file
+  // prefetched pages whose frame is not published yet, the frames stay locked until then
+  std::unordered_map<page_id_t, std::pair<frame_id_t, IOHandle>> prefetching_;
+  CompressedPageCache *compressed_cache_{nullptr};  // second tier of the evicted pages
+  std::atomic<size_t> num_misses_{0};               // frames taken from the free list or the replacer
+
+  // accesses of hits not passed to the replacer yet, a ring of ACCESS_LOG_SIZE slots written without the latch
+  std::unique_ptr<std::atomic<frame_id_t>[]> access_log_;
+  std::atomic<size_t> access_log_head_{0};  // next entry to drain, only advanced under the latch
+  std::atomic<size_t> access_log_tail_{0};  // next entry to claim
+
+  // background cleaner
+  size_t clean_frame_target_;
+  std::atomic<frame_id_t> cleaning_frame_{INVALID_FRAME_ID};  // frame written by the cleaner, it must not be evicted
+  std::thread cleaner_;
+  std::mutex cleaner_latch_;
+  std::condition_variable cleaner_cv_;
+  bool stop_cleaner_{false};
+
+  // pin count of frames in the free list or being evicted, a hit only pins frames whose pin count is not negative
+  static constexpr int FRAME_LOCKED = -1;
+  // the cleaner also runs when a miss takes a frame and the target is not met
+  static constexpr std::chrono::milliseconds CLEANER_INTERVAL{10};
+  // the log does not grow with the pool, a hit that finds it full just does not tell the replacer
+  static constexpr size_t ACCESS_LOG_SIZE = 4096;
+  // how long shrinking waits for the pages of the frames that go away to be unpinned
+  static constexpr std::chrono::milliseconds RESIZE_TIMEOUT{1000};
+  // pages a checkpoint copies and writes together, their frames are not evicted until the batch is on disk
+  static constexpr size_t CHECKPOINT_BATCH_SIZE = 64;
+};
+
+#endif  // MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
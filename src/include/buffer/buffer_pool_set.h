@@ -0,0 +1,70 @@
+#ifndef MINISQL_BUFFER_POOL_SET_H
+#define MINISQL_BUFFER_POOL_SET_H
+
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * Buffer pool a table or index is bound to, stored in its metadata.
+ */
+enum class BufferPoolId : uint32_t {
+  kDefault, /** everything that is not bound elsewhere */
+  kKeep,    /** objects that should stay resident, e.g. small hot indexes, and the catalog pages */
+  kRecycle  /** objects that are scanned once in a while and should not push other pages out */
+};
+
+/**
+ * BufferPoolSet holds the buffer pools of one db file, each with its own size and replacer. Every table and index is
+ * bound to one of them and fetches and creates its pages through it only, so a page is resident in at most one pool.
+ * A pool that is not given falls back to the default pool. The pools are not owned by the set.
+ */
+class BufferPoolSet {
+ public:
+  explicit BufferPoolSet(BufferPoolManager *default_pool, BufferPoolManager *keep_pool = nullptr,
+                         BufferPoolManager *recycle_pool = nullptr);
+
+  BufferPoolManager *GetPool(BufferPoolId pool_id) const { return pools_[static_cast<uint32_t>(pool_id)]; }
+
+  /**
+   * Write back and drop the pages from every pool, used before an object is bound to another pool
+   * @return false if one of the pages is pinned
+   */
+  bool EvictPages(const std::vector<page_id_t> &page_ids);
+
+  /**
+   * Write back all dirty pages of every pool and make them durable
+   */
+  void Sync();
+
+  /**
+   * Checkpoint every pool
+   * @return number of pages written
+   */
+  size_t Checkpoint();
+
+  /**
+   * Give every pool the same second tier, the pools never hold the same page
+   */
+  void SetCompressedCache(CompressedPageCache *cache);
+
+  /**
+   * @return false if name is none of "default", "keep" and "recycle"
+   */
+  static bool ParsePoolName(const std::string &name, BufferPoolId *pool_id);
+
+  static const char *GetPoolName(BufferPoolId pool_id);
+
+  static constexpr uint32_t NUM_POOLS = 3;
+
+ private:
+  /**
+   * @return the pools without the fallbacks, the default pool first
+   */
+  std::vector<BufferPoolManager *> GetDistinctPools() const;
+
+  BufferPoolManager *pools_[NUM_POOLS];
+};
+
+#endif  // MINISQL_BUFFER_POOL_SET_H
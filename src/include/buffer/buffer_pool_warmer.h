@@ -0,0 +1,88 @@
+#ifndef MINISQL_BUFFER_POOL_WARMER_H
+#define MINISQL_BUFFER_POOL_WARMER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * BufferPoolWarmer keeps the list of resident pages of a buffer pool in a file next to the db file, so that a restart
+ * does not have to bring every hot page back through a miss.
+ *
+ * A background thread first reads the pages of the list back into the pool, in batches in page id order, while the
+ * first queries already run. It then writes the list again every save interval, and the destructor writes it a last
+ * time, so the list of a clean shutdown is exact and the one of a crash at most one interval old.
+ */
+class BufferPoolWarmer {
+ public:
+  /**
+   * Start reloading the pages listed in file_name into bpm
+   * @param save_interval how often the list of resident pages is written
+   */
+  BufferPoolWarmer(BufferPoolManager *bpm, std::string file_name,
+                   std::chrono::milliseconds save_interval = DEFAULT_SAVE_INTERVAL);
+
+  /**
+   * Stop reloading and write the list, the buffer pool must still be alive
+   */
+  ~BufferPoolWarmer();
+
+  /**
+   * Write the list of resident pages now
+   * @return false if the file could not be written
+   */
+  bool Save();
+
+  /**
+   * Wait until the pages of the list have been reloaded
+   * @return number of pages reloaded
+   */
+  size_t WaitForLoad();
+
+  /**
+   * @return name of the file that keeps the list of db_file_name, a hidden file in the same directory
+   */
+  static std::string GetFileName(const std::string &db_file_name);
+
+  /**
+   * @return false if the file could not be written, an old list is only replaced by a complete one
+   */
+  static bool WritePageList(const std::string &file_name, const std::vector<page_id_t> &page_ids);
+
+  /**
+   * @return false if the file is missing or not a page list
+   */
+  static bool ReadPageList(const std::string &file_name, std::vector<page_id_t> *page_ids);
+
+  static constexpr std::chrono::milliseconds DEFAULT_SAVE_INTERVAL{60000};
+  // pages read by one FetchPages, at most a quarter of the pool
+  static constexpr size_t LOAD_BATCH_SIZE = 64;
+
+ private:
+  void Run();
+
+  /**
+   * @return number of pages reloaded
+   */
+  size_t Load();
+
+ private:
+  BufferPoolManager *bpm_;
+  std::string file_name_;
+  std::chrono::milliseconds save_interval_;
+  std::thread thread_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  bool loaded_{false};
+  size_t num_loaded_{0};
+
+  static constexpr uint32_t MAGIC = 0x4d53574c;  // "MSWL"
+};
+
+#endif  // MINISQL_BUFFER_POOL_WARMER_H
@@ -0,0 +1,44 @@
+#ifndef MINISQL_CHECKPOINTER_H
+#define MINISQL_CHECKPOINTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "buffer/buffer_pool_set.h"
+
+/**
+ * Checkpointer runs a checkpoint of the buffer pools of a db file every interval in a background thread, so that the
+ * dirty pages of an open database reach the db file without waiting for eviction or shutdown.
+ */
+class Checkpointer {
+ public:
+  explicit Checkpointer(BufferPoolSet *pools, std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+  /**
+   * Stop the thread, a checkpoint in progress is finished first. The buffer pools must still be alive.
+   */
+  ~Checkpointer();
+
+  /**
+   * @return number of checkpoints run by the thread so far
+   */
+  size_t GetNumCheckpoints();
+
+  static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{30000};
+
+ private:
+  void Run();
+
+ private:
+  BufferPoolSet *pools_;
+  std::chrono::milliseconds interval_;
+  std::thread thread_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  size_t num_checkpoints_{0};
+};
+
+#endif  // MINISQL_CHECKPOINTER_H
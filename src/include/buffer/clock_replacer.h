@@ -1,10 +1,8 @@
 #ifndef MINISQL_CLOCK_REPLACER_H
 #define MINISQL_CLOCK_REPLACER_H
 
-#include <algorithm>
-#include <map>
-#include <mutex>
-#include <unordered_set>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "buffer/replacer.h"
@@ -13,7 +11,10 @@
 using namespace std;
 
 /**
- * CLOCKReplacer implements the clock replacement.
+ * CLOCKReplacer implements the clock replacement. The clock has one slot per frame, so Pin and Unpin are O(1) and the
+ * hand needs at most two turns to find a victim. The reference bits are atomic, RecordAccess may be called by hits
+ * that do not hold the buffer pool latch. Resize replaces the array of reference bits, an old array is freed by the
+ * next Resize or VictimIf that finds no RecordAccess in flight.
  */
 class CLOCKReplacer : public Replacer {
  public:
@@ -28,19 +29,45 @@ class CLOCKReplacer : public Replacer {
    */
   ~CLOCKReplacer() override;
 
-  bool Victim(frame_id_t *frame_id) override;
+  bool VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) override;
 
   void Pin(frame_id_t frame_id) override;
 
   void Unpin(frame_id_t frame_id) override;
 
+  void RecordAccess(frame_id_t frame_id) override;
+
+  bool ConcurrentRecordAccess() const override { return true; }
+
   size_t Size() override;
 
+  void PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) override;
+
+  void Resize(size_t num_frames) override;
+
  private:
-  size_t capacity;
-  vector<pair<bool, bool>> clock_list_;  // <ref bit, invalid bit>
-  map<size_t, frame_id_t> clock_map_;
-  size_t clock_hand_;
+  struct RefBits {
+    explicit RefBits(size_t size);
+
+    size_t size_;
+    unique_ptr<std::atomic<bool>[]> bits_;
+  };
+
+  inline bool IsValidFrame(frame_id_t frame_id) const {
+    return frame_id >= 0 && static_cast<size_t>(frame_id) < num_frames_;
+  }
+
+  /** Frees the retired ref bit arrays if no RecordAccess is running. */
+  void FreeRetiredRefBits();
+
+  size_t num_frames_;
+  size_t size_{0};
+  vector<bool> in_clock_;                 // 页帧是否在 clock 中，slot 即 frame id
+  unique_ptr<RefBits> ref_bits_;                  // 正在使用的 ref bit 数组
+  vector<unique_ptr<RefBits>> retired_ref_bits_;  // Resize 换下、可能仍有命中在访问的数组
+  std::atomic<RefBits *> ref_;                    // ref bit，命中时不加锁设置
+  std::atomic<size_t> accessors_{0};              // 正在执行的 RecordAccess 数
+  size_t clock_hand_{0};
 };
 
-#endif  // MINISQL_CLOCK_REPLACER_H
\ No newline at end of file
+#endif  // MINISQL_CLOCK_REPLACER_H
@@ -0,0 +1,105 @@
+#ifndef MINISQL_COMPRESSED_PAGE_CACHE_H
+#define MINISQL_COMPRESSED_PAGE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/config.h"
+
+/**
+ * CompressedPageCache is a second tier behind the buffer pools of a db file. The pools put the pages they evict into
+ * it, compressed with PageCodec, and a miss takes the page from here before it goes to disk. Memory that would hold N
+ * frames then holds two or three times as many pages of text heavy tables.
+ *
+ * A page is either in a buffer pool or in the cache, never in both: a hit takes the page out of the cache, and only
+ * pages whose data matches the db file are put in, i.e. clean pages and dirty pages after their write back. Pages
+ * that do not shrink to MAX_COMPRESSED_SIZE are not kept. Each page is tagged with the pool that put it and only
+ * that pool takes it again. The least recently put pages are dropped when the cache exceeds its capacity. All methods
+ * are thread-safe.
+ */
+class CompressedPageCache {
+ public:
+  /**
+   * @param capacity bytes the compressed pages may take, 0 keeps no page
+   */
+  explicit CompressedPageCache(size_t capacity);
+
+  /**
+   * Compress and keep a page that was evicted from a buffer pool.
+   *
+   * The pools of a db file share the cache, and a pool may hold a stale clean copy of a page another pool works on.
+   * A page the pool just wrote back is the content of the db file and replaces an older copy. A clean page may be such
+   * a stale copy: if the cache already has the page, the two cannot be told apart and both are dropped. A stale copy
+   * that is kept is never served to the pool owning the page, since it is tagged with the pool that put it.
+   * @param written whether the pool wrote the page back on eviction
+   * @param pool the pool the page is evicted from
+   * @return false if the page is not kept
+   */
+  bool Put(page_id_t page_id, const char *data, bool written, const void *pool);
+
+  /**
+   * Take a page out of the cache
+   * @param[out] data PAGE_SIZE bytes the page is decompressed into
+   * @param pool the pool the page is read into
+   * @return false if the page is not in the cache or was put by another pool
+   */
+  bool Take(page_id_t page_id, char *data, const void *pool);
+
+  /**
+   * Forget a page, e.g. because it was deleted
+   */
+  void Erase(page_id_t page_id);
+
+  /**
+   * Change the capacity, shrinking drops the least recently put pages
+   */
+  void SetCapacity(size_t capacity);
+
+  size_t GetCapacity();
+
+  /**
+   * @return bytes taken by the cached pages, including the bookkeeping of each page
+   */
+  size_t GetSize();
+
+  size_t GetNumPages();
+
+  size_t GetNumHits();
+
+  size_t GetNumMisses();
+
+  // a page that compresses to more than this is not worth the decompression of a hit
+  static constexpr size_t MAX_COMPRESSED_SIZE = PAGE_SIZE * 3 / 4;
+  // memory taken by each page in addition to its compressed data
+  static constexpr size_t ENTRY_OVERHEAD = 64;
+
+ private:
+  struct Entry {
+    page_id_t page_id_;
+    const void *pool_;  // the pool that put the page
+    size_t size_;
+    std::unique_ptr<char[]> data_;
+  };
+
+  /**
+   * Drop pages until the cache fits its capacity, the latch must be held
+   */
+  void EvictToCapacity();
+
+  /**
+   * Drop an entry, the latch must be held
+   */
+  void EraseEntry(std::list<Entry>::iterator it);
+
+  std::mutex latch_;
+  size_t capacity_;
+  size_t size_{0};
+  size_t num_hits_{0};
+  size_t num_misses_{0};
+  std::list<Entry> entries_;  // most recently put first
+  std::unordered_map<page_id_t, std::list<Entry>::iterator> index_;
+};
+
+#endif  // MINISQL_COMPRESSED_PAGE_CACHE_H
@@ -0,0 +1,71 @@
+#ifndef MINISQL_CONCURRENT_PAGE_TABLE_H
+#define MINISQL_CONCURRENT_PAGE_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "common/config.h"
+
+/**
+ * ConcurrentPageTable maps the resident pages of a buffer pool to their frames. It is an open addressing hash table
+ * with linear probing and a fixed capacity of at least twice the number of frames.
+ *
+ * Find never blocks. Insert and Erase must be serialized by the caller, the buffer pool does so with its latch. Erase
+ * moves entries back to close the gap it leaves, so a concurrent Find may miss a page that is resident, or return a
+ * frame that no longer holds the page. Callers have to check the page id of the frame after pinning it and retry
+ * under the latch on a miss.
+ *
+ * The table does not grow by itself. A buffer pool that gets more frames copies the entries into a larger table and
+ * keeps the old one alive, since lookups without the latch may still probe it.
+ */
+class ConcurrentPageTable {
+ public:
+  explicit ConcurrentPageTable(size_t num_frames);
+
+  ~ConcurrentPageTable() = default;
+
+  /**
+   * @return true if page_id is found, its frame is stored in frame_id
+   */
+  bool Find(page_id_t page_id, frame_id_t *frame_id) const;
+
+  /**
+   * Insert a page that is not in the table yet
+   */
+  void Insert(page_id_t page_id, frame_id_t frame_id);
+
+  /**
+   * Remove a page, does nothing if the page is not in the table
+   */
+  void Erase(page_id_t page_id);
+
+  /**
+   * Insert all entries into another table, Insert and Erase must be serialized with the copy
+   */
+  void CopyTo(ConcurrentPageTable *other) const;
+
+  /**
+   * @return number of frames the table is sized for
+   */
+  inline size_t GetMaxFrames() const { return (mask_ + 1) / 2; }
+
+ private:
+  struct Slot {
+    std::atomic<page_id_t> page_id_{INVALID_PAGE_ID};
+    std::atomic<frame_id_t> frame_id_{0};
+  };
+
+  /**
+   * Page ids of one buffer pool instance are often a fixed stride apart, so they are mixed before masking
+   */
+  inline size_t GetHomeSlot(page_id_t page_id) const {
+    return static_cast<size_t>((static_cast<uint64_t>(page_id) * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+  }
+
+ private:
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;  // capacity - 1, the capacity is a power of 2
+};
+
+#endif  // MINISQL_CONCURRENT_PAGE_TABLE_H
@@ -0,0 +1,38 @@
+#ifndef MINISQL_FRAME_ARENA_H
+#define MINISQL_FRAME_ARENA_H
+
+#include <cstddef>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * FrameArena holds the data of all frames of a buffer pool in one anonymous mapping, zeroed and aligned to PAGE_SIZE
+ * so that DiskIOMode::kDirect reads and writes the frames without a bounce buffer. An arena of at least one huge page
+ * is backed by explicit huge pages if the system has reserved enough of them, otherwise it starts at a huge page
+ * boundary and asks for transparent huge pages, so that the frames need a fraction of the TLB entries of 4 KB pages.
+ */
+class FrameArena {
+ public:
+  explicit FrameArena(size_t num_frames);
+
+  ~FrameArena();
+
+  DISALLOW_COPY(FrameArena)
+
+  /** @return data of frame frame_id */
+  inline char *GetFrame(size_t frame_id) const { return data_ + frame_id * PAGE_SIZE; }
+
+  /** @return true if the arena is backed by explicit huge pages, i.e. mapped with MAP_HUGETLB */
+  inline bool IsHugeTLB() const { return huge_tlb_; }
+
+  static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+ private:
+  char *mapping_{nullptr};
+  size_t mapping_size_{0};
+  char *data_{nullptr};  // first frame, inside of the mapping
+  bool huge_tlb_{false};
+};
+
+#endif  // MINISQL_FRAME_ARENA_H
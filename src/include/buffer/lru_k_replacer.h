@@ -0,0 +1,60 @@
+#ifndef MINISQL_LRU_K_REPLACER_H
+#define MINISQL_LRU_K_REPLACER_H
+
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+/**
+ * LRUKReplacer evicts the frame whose K-th most recent access is the oldest. Frames accessed less than K times have an
+ * infinite backward K-distance and go first, oldest first access first. A scan touches each page once, so its pages
+ * never push out pages that were accessed K times.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k number of accesses remembered per frame
+   */
+  explicit LRUKReplacer(size_t num_pages, size_t k = DEFAULT_K);
+
+  ~LRUKReplacer() override;
+
+  bool VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void RecordAccess(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+  void PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) override;
+
+  void Resize(size_t num_frames) override;
+
+  static constexpr size_t DEFAULT_K = 2;
+
+ private:
+  using Key = std::pair<size_t, frame_id_t>;
+
+  /**
+   * @return the set that holds frame_id, by the number of accesses it has
+   */
+  std::set<Key> &GetSet(frame_id_t frame_id);
+
+  bool IsTracked(frame_id_t frame_id);
+
+  size_t k_;
+  size_t current_timestamp_{0};
+  std::vector<std::deque<size_t>> history_;  // last k access timestamps of each frame, oldest first, empty if untracked
+  std::set<Key> young_;                      // frames accessed less than k times, by first access
+  std::set<Key> old_;                        // frames accessed k times or more, by k-th most recent access
+};
+
+#endif  // MINISQL_LRU_K_REPLACER_H
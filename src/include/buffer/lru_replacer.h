@@ -28,14 +28,20 @@ class LRUReplacer : public Replacer {
    */
   ~LRUReplacer() override;
 
-  bool Victim(frame_id_t *frame_id) override;
+  bool VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) override;
 
   void Pin(frame_id_t frame_id) override;
 
   void Unpin(frame_id_t frame_id) override;
 
+  void RecordAccess(frame_id_t frame_id) override;
+
   size_t Size() override;
 
+  void PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) override;
+
+  void Resize(size_t num_frames) override;
+
  private:
   // add your own private member variables here
   list<frame_id_t> lru_list_;                                      // 双向链表存储LRU队列
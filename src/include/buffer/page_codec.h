@@ -0,0 +1,36 @@
+#ifndef MINISQL_PAGE_CODEC_H
+#define MINISQL_PAGE_CODEC_H
+
+#include <cstddef>
+
+/**
+ * PageCodec compresses pages into the LZ4 block format: a sequence of literal runs, each followed by a back reference
+ * of at least four bytes into the last 64 KB of output. Compression uses a single hash table probe per position and no
+ * entropy coding, so a page is compressed in a few microseconds and decompressed in less. Text and sparse pages shrink
+ * to a half or a third, pages of random data do not shrink at all.
+ *
+ * The codec is written for this tree and has no dependencies, its output can be read by any LZ4 block decoder.
+ */
+class PageCodec {
+ public:
+  /**
+   * @param capacity size of dst, the compressed data is dropped if it does not fit
+   * @return size of the compressed data, 0 if it does not fit into capacity bytes
+   */
+  static size_t Compress(const char *src, size_t size, char *dst, size_t capacity);
+
+  /**
+   * @return false if src is not the compressed form of exactly size bytes
+   */
+  static bool Decompress(const char *src, size_t src_size, char *dst, size_t size);
+
+ private:
+  static constexpr int HASH_LOG = 12;
+  static constexpr size_t MIN_MATCH = 4;
+  // the format ends with at least five literals, and the last match starts twelve bytes before the end at the latest
+  static constexpr size_t LAST_LITERALS = 5;
+  static constexpr size_t MATCH_FIND_LIMIT = 12;
+  static constexpr size_t MAX_OFFSET = 65535;
+};
+
+#endif  // MINISQL_PAGE_CODEC_H
@@ -0,0 +1,97 @@
+#ifndef MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+#define MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+
+/**
+ * ParallelBufferPoolManager splits the frames over several BufferPoolManagerInstance, page page_id always lives in
+ * instance page_id % num_instances. Each instance has its own latch, page table, free list and replacer, so only
+ * threads working on pages of the same instance wait for each other.
+ */
+class ParallelBufferPoolManager : public BufferPoolManager {
+ public:
+  /**
+   * @param num_instances number of instances
+   * @param pool_size total number of frames, split evenly over the instances
+   * @param clean_frame_target total number of frames kept free or clean by the cleaners of the instances
+   * @param policy replacement policy of every instance
+   */
+  ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                            size_t clean_frame_target = 0, ReplacerPolicy policy = ReplacerPolicy::kLRU);
+
+  ~ParallelBufferPoolManager() override;
+
+  using BufferPoolManager::FetchPage;
+
+  Page *FetchPage(page_id_t page_id, BufferAccessStrategy *strategy) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  using BufferPoolManager::Prefetch;
+
+  void Prefetch(const std::vector<page_id_t> &page_ids, BufferAccessStrategy *strategy) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  void FlushAllPages() override;
+
+  void Sync() override;
+
+  size_t Checkpoint() override;
+
+  using BufferPoolManager::NewPage;
+
+  /**
+   * The page id is allocated first, the page then goes to the instance it belongs to. If that instance has no frame
+   * left the page is given back and nullptr is returned, even if other instances still have free frames.
+   */
+  Page *NewPage(page_id_t &page_id, ExtentReservation *reservation, BufferAccessStrategy *strategy) override;
+
+  void ReleaseReservation(ExtentReservation *reservation) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool EvictPage(page_id_t page_id) override;
+
+  bool IsPageFree(page_id_t page_id) override;
+
+  /**
+   * The instances share the cache, the pages are split over them by id anyway
+   */
+  void SetCompressedCache(CompressedPageCache *cache) override;
+
+  size_t GetNumMisses() override;
+
+  bool CheckAllUnpinned() override;
+
+  size_t GetPoolSize() override;
+
+  /**
+   * The frames are split over the instances like in the constructor. If an instance fails to shrink, the instances
+   * already resized go back to their old size.
+   */
+  bool Resize(size_t pool_size) override;
+
+  /**
+   * The lists of the instances are interleaved, so that the pages the instances value most come first
+   */
+  void GetResidentPages(std::vector<page_id_t> *page_ids) override;
+
+  inline size_t GetNumInstances() const { return instances_.size(); }
+
+ private:
+  inline BufferPoolManagerInstance *GetInstance(page_id_t page_id) {
+    return instances_[static_cast<size_t>(page_id) % instances_.size()];
+  }
+
+ private:
+  std::vector<BufferPoolManagerInstance *> instances_;
+  DiskManager *disk_manager_;
+};
+
+#endif  // MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
@@ -0,0 +1,42 @@
+#ifndef MINISQL_READ_AHEAD_DETECTOR_H
+#define MINISQL_READ_AHEAD_DETECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * ReadAheadDetector watches the pages a scan moves to and tells which pages to prefetch. Once the scan has moved
+ * through trigger pages with consecutive ids, the next window pages are prefetched, in batches whenever less than
+ * half of the window is left. The window stops at the end of the pages known to belong to the scanned object, so
+ * that the pages of other objects are not read into the pool of this one. Otherwise only the next page of the chain
+ * is prefetched if the caller knows it.
+ */
+class ReadAheadDetector {
+ public:
+  explicit ReadAheadDetector(uint32_t window = DEFAULT_WINDOW, uint32_t trigger = DEFAULT_TRIGGER)
+      : window_(window), trigger_(trigger) {}
+
+  /**
+   * Record that the scan moved to page_id
+   * @param next_page_id next page of the chain if known, INVALID_PAGE_ID otherwise
+   * @param owned_end the pages from page_id up to owned_end belong to the scanned object, see
+   * ExtentReservation::GetRunEnd. INVALID_PAGE_ID if every page after page_id does.
+   * @return pages to prefetch
+   */
+  std::vector<page_id_t> OnAccess(page_id_t page_id, page_id_t next_page_id = INVALID_PAGE_ID,
+                                  page_id_t owned_end = INVALID_PAGE_ID);
+
+  static constexpr uint32_t DEFAULT_WINDOW = 16;
+  static constexpr uint32_t DEFAULT_TRIGGER = 2;
+
+ private:
+  uint32_t window_;
+  uint32_t trigger_;
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+  uint32_t run_length_{0};  // number of consecutive page ids the scan moved through
+  page_id_t prefetched_until_{INVALID_PAGE_ID};
+};
+
+#endif  // MINISQL_READ_AHEAD_DETECTOR_H
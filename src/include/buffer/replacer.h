@@ -2,9 +2,23 @@
 #define MINISQL_REPLACER_H
 
 #include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "common/config.h"
 
+/**
+ * Replacement policy of the buffer pool.
+ */
+enum class ReplacerPolicy {
+  kLRU,   /** least recently used frame first, one scan evicts every hot page */
+  kClock, /** approximates LRU with one reference bit per frame, a hit only sets the bit */
+  kLRUK,  /** oldest K-th most recent access first, frames accessed less than K times before the others */
+  kARC    /** adaptive replacement cache, sizes the lists of pages seen once and seen again by their ghost hits */
+};
+
 /**
  * Replacer is an abstract class that tracks page usage.
  */
@@ -19,7 +33,17 @@ class Replacer {
    * @param[out] frame_id id of frame that was removed, nullptr if no victim was found
    * @return true if a victim frame was found, false otherwise
    */
-  virtual bool Victim(frame_id_t *frame_id) = 0;
+  virtual bool Victim(frame_id_t *frame_id) {
+    return VictimIf(frame_id, [](frame_id_t) { return true; });
+  }
+
+  /**
+   * Remove the first frame in victim order that evictable accepts. Frames that are rejected stay in the replacer and
+   * keep their history, e.g. frames that are pinned without the replacer being told.
+   * @param evictable called on candidates in victim order until it returns true
+   * @return true if a victim frame was found, false otherwise
+   */
+  virtual bool VictimIf(frame_id_t *frame_id, const std::function<bool(frame_id_t)> &evictable) = 0;
 
   /**
    * Pins a frame, indicating that it should not be victimized until it is unpinned.
@@ -33,8 +57,49 @@ class Replacer {
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * A page was loaded into frame_id, which is not in the replacer yet. Replacers that remember evicted pages need the
+   * page id, the others just unpin the frame.
+   */
+  virtual void Admit(frame_id_t frame_id, __attribute__((unused)) page_id_t page_id) { Unpin(frame_id); }
+
+  /**
+   * The page in frame_id was accessed, frames that are not in the replacer are ignored.
+   */
+  virtual void RecordAccess(frame_id_t frame_id) = 0;
+
+  /**
+   * @return true if RecordAccess may run concurrently with the other methods, so that a hit can call it without the
+   * latch of the buffer pool
+   */
+  virtual bool ConcurrentRecordAccess() const { return false; }
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
+
+  /**
+   * Look at the next victims without removing them, e.g. to write dirty pages back before they are evicted.
+   * @param max_frames the maximum number of frames to return
+   * @param[out] frame_ids frames in the order they would be victimized if nothing changes in between
+   */
+  virtual void PeekVictims(size_t max_frames, std::vector<frame_id_t> *frame_ids) = 0;
+
+  /**
+   * Change the maximum number of frames, called when the buffer pool is resized. When it shrinks, the frames beyond
+   * num_frames have been removed from the replacer already.
+   */
+  virtual void Resize(size_t num_frames) = 0;
+
+  /**
+   * @param num_frames the maximum number of frames the replacer will be required to store
+   */
+  static std::unique_ptr<Replacer> Create(ReplacerPolicy policy, size_t num_frames);
+
+  /**
+   * @param name one of lru, clock, lru-k and arc
+   * @return false if name is not a policy
+   */
+  static bool ParsePolicy(const std::string &name, ReplacerPolicy *policy);
 };
 
 #endif  // MINISQL_REPLACER_H
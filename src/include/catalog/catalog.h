@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 #include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_set.h"
 #include "catalog/indexes.h"
 #include "catalog/table.h"
 #include "common/config.h"
@@ -68,11 +69,16 @@ class CatalogMeta {
 /**
  * Catalog manager
  *
+ * The catalog meta page, the meta pages of tables and indexes and the index roots page go through buffer_pool_manager.
+ * Each table heap and index goes through the pool of pools it is bound to in its metadata.
  */
 class CatalogManager {
  public:
+  /**
+   * @param pools pools tables and indexes can be bound to, nullptr to keep everything in buffer_pool_manager
+   */
   explicit CatalogManager(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
-                          bool init);
+                          bool init, BufferPoolSet *pools = nullptr);
 
   ~CatalogManager();
 
@@ -94,6 +100,18 @@ class CatalogManager {
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Bind a table heap to another buffer pool, its resident pages are written back and dropped from the old one
+   * @return DB_FAILED if a page of the table is pinned
+   */
+  dberr_t SetTablePool(const std::string &table_name, BufferPoolId pool_id);
+
+  /**
+   * Bind an index to another buffer pool, its resident pages are written back and dropped from the old one
+   * @return DB_FAILED if a page of the index is pinned
+   */
+  dberr_t SetIndexPool(const std::string &table_name, const std::string &index_name, BufferPoolId pool_id);
+
  private:
   dberr_t DropTable(table_id_t table_id);
 
@@ -107,6 +125,7 @@ class CatalogManager {
 
  private:
   [[maybe_unused]] BufferPoolManager *buffer_pool_manager_;
+  BufferPoolSet pools_;
   [[maybe_unused]] LockManager *lock_manager_;
   [[maybe_unused]] LogManager *log_manager_;
   CatalogMeta *catalog_meta_;
@@ -33,6 +33,10 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  inline BufferPoolId GetPoolId() const { return pool_id_; }
+
+  inline void SetPoolId(BufferPoolId pool_id) { pool_id_ = pool_id; }
+
  private:
   IndexMetadata() = delete;
 
@@ -41,10 +45,13 @@ class IndexMetadata {
 
  private:
   static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
+  // marks the buffer pool binding after the key mapping, the meta pages of older files have zeros there
+  static constexpr uint32_t POOL_ID_MAGIC_NUM = 0x4c4f4f50;  // "POOL"
   index_id_t index_id_;
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  BufferPoolId pool_id_{BufferPoolId::kDefault};
 };
 
 /**
@@ -63,26 +70,33 @@ class IndexInfo {
   /**
    * TODO: Student Implement
    */
-  void Init(IndexMetadata *meta_data, TableInfo *table_info, BufferPoolManager *buffer_pool_manager) {
+  /**
+   * @param buffer_pool_manager pool the index is bound to
+   * @param roots_pool pool of the catalog, which the index roots page is fetched through
+   */
+  void Init(IndexMetadata *meta_data, TableInfo *table_info, BufferPoolManager *buffer_pool_manager,
+            BufferPoolManager *roots_pool = nullptr) {
     // Step1: init index metadata and table info
     // Step2: mapping index key to key schema
     // Step3: call CreateIndex to create the index
     // IndexInfo();
     this->meta_data_ = meta_data;
     key_schema_ = Schema::ShallowCopySchema(table_info->GetSchema(), meta_data_->GetKeyMapping());
-    index_ = CreateIndex(buffer_pool_manager, "bptree");
+    index_ = CreateIndex(buffer_pool_manager, roots_pool, "bptree");
   }
 
   inline Index *GetIndex() { return index_; }
 
   std::string GetIndexName() { return meta_data_->GetIndexName(); }
 
+  IndexMetadata *GetIndexMeta() { return meta_data_; }
+
   IndexSchema *GetIndexKeySchema() { return key_schema_; }
 
  private:
   explicit IndexInfo() : meta_data_{nullptr}, index_{nullptr}, key_schema_{nullptr} {}
 
-  Index *CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type);
+  Index *CreateIndex(BufferPoolManager *buffer_pool_manager, BufferPoolManager *roots_pool, const string &index_type);
 
  private:
   IndexMetadata *meta_data_;
@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "buffer/buffer_pool_set.h"
 #include "glog/logging.h"
 #include "record/schema.h"
 #include "storage/table_heap.h"
@@ -33,6 +34,10 @@ class TableMetadata {
 
   inline Schema *GetSchema() const { return schema_; }
 
+  inline BufferPoolId GetPoolId() const { return pool_id_; }
+
+  inline void SetPoolId(BufferPoolId pool_id) { pool_id_ = pool_id; }
+
  private:
   TableMetadata() = delete;
 
@@ -40,10 +45,13 @@ class TableMetadata {
 
  private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
+  // marks the buffer pool binding after the schema, the meta pages of older files have zeros there
+  static constexpr uint32_t POOL_ID_MAGIC_NUM = 0x4c4f4f50;  // "POOL"
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
   Schema *schema_;
+  BufferPoolId pool_id_{BufferPoolId::kDefault};
 };
 
 /**
@@ -73,6 +81,8 @@ class TableInfo {
 
   inline page_id_t GetRootPageId() const { return table_meta_->root_page_id_; }
 
+  inline TableMetadata *GetTableMeta() const { return table_meta_; }
+
  private:
   explicit TableInfo(){};
 
@@ -13,15 +13,30 @@ static constexpr int META_PAGE_ID = 0;          // physical page id of the disk
 static constexpr int CATALOG_META_PAGE_ID = 0;  // logical page id of the catalog meta data
 static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index roots
 
-static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
-static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
+#ifndef MINISQL_PAGE_SIZE
+#define MINISQL_PAGE_SIZE 4096
+#endif
+
+static constexpr int PAGE_SIZE = MINISQL_PAGE_SIZE;  // size of a data page in byte, set by cmake -DMINISQL_PAGE_SIZE
+static_assert(PAGE_SIZE == 4096 || PAGE_SIZE == 8192 || PAGE_SIZE == 16384 || PAGE_SIZE == 32768,
+              "Page size must be 4, 8, 16 or 32 KB.");
+static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480 * 4096 / PAGE_SIZE;  // default size of buffer pool, 80 MB
+static constexpr int DEFAULT_BUFFER_POOL_INSTANCES = 8;  // the default buffer pool is split by page id hash
+static constexpr int DEFAULT_CLEAN_FRAME_PERCENT = 5;    // share of frames the page cleaner keeps free or clean
+static constexpr int DEFAULT_KEEP_POOL_SIZE = 2048 * 4096 / PAGE_SIZE;     // catalog and objects bound to it, 8 MB
+static constexpr int DEFAULT_RECYCLE_POOL_SIZE = 1024 * 4096 / PAGE_SIZE;  // pool of objects scanned once, 4 MB
+static constexpr int DEFAULT_COMPRESSED_CACHE_SIZE = 0;  // pages of memory for compressed evicted pages, 0 for none
 
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
 static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
 
 // static std::string DB_META_FILE = "minisql.meta.db";
 
+#ifdef MINISQL_PAGE_ID_64
+using page_id_t = int64_t;
+#else
 using page_id_t = int32_t;
+#endif
 using frame_id_t = int32_t;
 using txn_id_t = int32_t;
 using lsn_t = int32_t;
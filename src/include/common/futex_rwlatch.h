@@ -0,0 +1,91 @@
+#ifndef MINISQL_FUTEX_RWLATCH_H
+#define MINISQL_FUTEX_RWLATCH_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/macros.h"
+
+/**
+ * Reader-writer latch in a single 32-bit word, for latches that are many and mostly uncontended like the ones of the
+ * pages. Taking and releasing it without contention is one atomic operation each.
+ *
+ * A thread that cannot take the latch spins for a while, then sleeps on the word with a futex. Writers are preferred:
+ * a waiting writer keeps new readers out, so a stream of readers cannot starve it. As with ReaderWriterLatch, a thread
+ * that holds the read latch must not take it again while a writer may be waiting.
+ */
+class FutexReaderWriterLatch {
+ public:
+  FutexReaderWriterLatch() = default;
+
+  ~FutexReaderWriterLatch() = default;
+
+  DISALLOW_COPY(FutexReaderWriterLatch);
+
+  /**
+   * Acquire a write latch.
+   */
+  inline void WLock() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    if ((state & (READER_MASK | WRITER)) != 0 ||
+        !state_.compare_exchange_weak(state, (state | WRITER) & ~WRITER_WAITING, std::memory_order_acquire,
+                                      std::memory_order_relaxed)) {
+      WLockSlow();
+    }
+  }
+
+  /**
+   * Release a write latch.
+   */
+  inline void WUnlock() { Release(WRITER); }
+
+  /**
+   * Acquire a read latch.
+   */
+  inline void RLock() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    if ((state & (WRITER | WRITER_WAITING)) != 0 || (state & READER_MASK) == READER_MASK ||
+        !state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+      RLockSlow();
+    }
+  }
+
+  /**
+   * Release a read latch.
+   */
+  inline void RUnlock() { Release(1); }
+
+  // spins before a waiting thread goes to sleep, each one a load of the word
+  static constexpr int SPIN_LIMIT = 128;
+
+ private:
+  void WLockSlow();
+
+  void RLockSlow();
+
+  /**
+   * Take delta off the word, the sleepers are woken if nobody holds the latch any more
+   */
+  inline void Release(uint32_t delta) {
+    uint32_t state = state_.fetch_sub(delta, std::memory_order_release) - delta;
+    if ((state & SLEEPERS) != 0 && (state & (READER_MASK | WRITER)) == 0) {
+      WakeAll();
+    }
+  }
+
+  void WakeAll();
+
+  /**
+   * Sleep until the word is changed from state, state must have SLEEPERS set
+   */
+  void Wait(uint32_t state);
+
+  static constexpr uint32_t READER_MASK = (1U << 29) - 1;  // number of readers holding the latch
+  static constexpr uint32_t SLEEPERS = 1U << 29;           // some thread may sleep on the word
+  static constexpr uint32_t WRITER_WAITING = 1U << 30;     // a writer waits, new readers stay out
+  static constexpr uint32_t WRITER = 1U << 31;             // a writer holds the latch
+
+  std::atomic<uint32_t> state_{0};
+};
+
+#endif  // MINISQL_FUTEX_RWLATCH_H
@@ -5,6 +5,11 @@
 #include <string>
 
 #include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/buffer_pool_set.h"
+#include "buffer/buffer_pool_warmer.h"
+#include "buffer/checkpointer.h"
+#include "buffer/parallel_buffer_pool_manager.h"
 #include "catalog/catalog.h"
 #include "common/config.h"
 #include "common/dberr.h"
@@ -14,15 +19,33 @@
 
 class DBStorageEngine {
  public:
-  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE);
+  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                           DurabilityMode durability = DurabilityMode::kWriteThrough,
+                           DiskIOMode io_mode = DiskIOMode::kPositional,
+                           ReplacerPolicy replacer_policy = ReplacerPolicy::kLRU,
+                           uint32_t keep_pool_size = DEFAULT_KEEP_POOL_SIZE,
+                           uint32_t recycle_pool_size = DEFAULT_RECYCLE_POOL_SIZE,
+                           uint32_t compressed_cache_size = DEFAULT_COMPRESSED_CACHE_SIZE);
 
   ~DBStorageEngine();
 
   std::unique_ptr<ExecuteContext> MakeExecuteContext(Txn *txn);
 
+  /**
+   * @return number of frames taken by the keep and recycle pools and the compressed cache, which are not resized with
+   * the default pool
+   */
+  size_t GetFixedFrames() const;
+
  public:
   DiskManager *disk_mgr_;
-  BufferPoolManager *bpm_;
+  BufferPoolManager *bpm_;          // the default pool
+  BufferPoolManager *keep_bpm_;     // the catalog pages and the objects bound to the keep pool
+  BufferPoolManager *recycle_bpm_;  // the objects bound to the recycle pool
+  BufferPoolSet *pools_;
+  CompressedPageCache *compressed_cache_;  // second tier of the pools, takes compressed_cache_size pages of memory
+  BufferPoolWarmer *warmer_;  // reloads the pages resident at the last shutdown and keeps their list up to date
+  Checkpointer *checkpointer_;  // writes back the dirty pages periodically
   CatalogManager *catalog_mgr_;
   std::string db_file_name_;
   bool init_;
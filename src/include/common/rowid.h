@@ -8,6 +8,7 @@
 
 /**
  * | page_id(32bit) | slot_num(32bit) |
+ * Note: with MINISQL_PAGE_ID_64 Get() is only unique while page ids fit in 32 bits, compare and hash RowId itself.
  */
 class RowId {
  public:
@@ -30,6 +31,10 @@ class RowId {
 
   bool operator==(const RowId &other) const { return page_id_ == other.page_id_ && slot_num_ == other.slot_num_; }
 
+  bool operator<(const RowId &other) const {
+    return page_id_ < other.page_id_ || (page_id_ == other.page_id_ && slot_num_ < other.slot_num_);
+  }
+
  private:
   page_id_t page_id_{INVALID_PAGE_ID};
   uint32_t slot_num_{0};  // logical offset of the record in page, starts from 0. eg:0, 1, 2...
@@ -38,7 +43,9 @@ class RowId {
 namespace std {
 template <>
 struct hash<RowId> {
-  size_t operator()(const RowId &rid) const { return hash<int64_t>()(rid.Get()); }
+  size_t operator()(const RowId &rid) const {
+    return hash<page_id_t>()(rid.GetPageId()) * 31 + hash<uint32_t>()(rid.GetSlotNum());
+  }
 };
 }  // namespace std
 
@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "buffer/buffer_pool_budget.h"
 #include "common/dberr.h"
 #include "common/instance.h"
 #include "concurrency/txn.h"
@@ -22,9 +23,16 @@ extern "C" {
  */
 class ExecuteEngine {
  public:
-  ExecuteEngine();
+  /**
+   * @param buffer_pool_size number of frames the buffer pools and compressed caches of all databases share
+   * @param replacer_policy replacement policy of the buffer pool of every database opened or created
+   */
+  explicit ExecuteEngine(uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                         ReplacerPolicy replacer_policy = ReplacerPolicy::kLRU);
 
   ~ExecuteEngine() {
+    // the budget no longer resizes the pools once its thread is stopped
+    delete budget_;
     for (auto it : dbs_) {
       delete it.second;
     }
@@ -51,6 +59,16 @@ class ExecuteEngine {
 
   dberr_t ExecuteUseDatabase(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteShrinkDatabase(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteSetVariable(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteCheckpoint(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteAlterTable(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteAlterIndex(pSyntaxNode ast, ExecuteContext *context);
+
   dberr_t ExecuteShowTables(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *context);
@@ -73,9 +91,20 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  /**
+   * Reserve the fixed frames of all open databases from the budget, after a database or one of their sizes changed
+   */
+  void ReserveFixedFrames();
+
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  uint32_t buffer_pool_size_;                              /** number of frames of all buffer pools */
+  BufferPoolBudget *budget_;                               /** splits buffer_pool_size_ between the databases */
+  uint32_t keep_pool_size_{DEFAULT_KEEP_POOL_SIZE};         /** number of frames of each keep pool */
+  uint32_t recycle_pool_size_{DEFAULT_RECYCLE_POOL_SIZE};   /** number of frames of each recycle pool */
+  uint32_t compressed_cache_size_{DEFAULT_COMPRESSED_CACHE_SIZE};  /** pages of memory of each compressed cache */
+  ReplacerPolicy replacer_policy_;                         /** replacement policy of the buffer pools */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
@@ -48,6 +48,8 @@ class InsertExecutor : public AbstractExecutor {
   TableInfo *table_info_{};
   const Schema *schema_{};
   std::vector<IndexInfo *> index_info_;
+  /** The ring of frames the pages filled by the insert go through */
+  BufferAccessStrategy strategy_{BufferAccessType::kBulkWrite};
 };
 
 #endif  // MINISQL_INSERT_EXECUTOR_H
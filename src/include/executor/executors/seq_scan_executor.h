@@ -45,6 +45,8 @@ class SeqScanExecutor : public AbstractExecutor {
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_{};
+  /** The ring of frames the scan reads the table into, so it does not push the working set out of the pool */
+  BufferAccessStrategy strategy_{BufferAccessType::kBulkRead};
   TableIterator iterator_;
   const Schema *schema_{};
   bool is_schema_same_;
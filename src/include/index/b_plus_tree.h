@@ -26,8 +26,15 @@ class BPlusTree {
   using LeafPage = BPlusTreeLeafPage;
 
  public:
+  /**
+   * @param buffer_pool_manager pool the nodes of the tree are fetched and created through
+   * @param roots_pool pool the index roots page is fetched through, nullptr for buffer_pool_manager
+   */
   explicit BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &comparator,
-                     int leaf_max_size = UNDEFINED_SIZE, int internal_max_size = UNDEFINED_SIZE);
+                     int leaf_max_size = UNDEFINED_SIZE, int internal_max_size = UNDEFINED_SIZE,
+                     BufferPoolManager *roots_pool = nullptr);
+
+  ~BPlusTree();
 
   // Returns true if this B+ tree has no keys and values.
   bool IsEmpty() const;
@@ -53,6 +60,13 @@ class BPlusTree {
   // used to check whether all pages are unpinned
   bool Check();
 
+  // append the ids of the pages of the tree, parents before their children
+  void GetPageIds(std::vector<page_id_t> *page_ids);
+
+  // fetch and create the nodes through another buffer pool from now on, the nodes must have been evicted from the old
+  // one and no other thread may use the tree meanwhile
+  void SetBufferPoolManager(BufferPoolManager *buffer_pool_manager) { buffer_pool_manager_ = buffer_pool_manager; }
+
   // destroy the b plus tree
   void Destroy(page_id_t current_page_id = INVALID_PAGE_ID);
 
@@ -106,9 +120,11 @@ class BPlusTree {
   index_id_t index_id_;
   page_id_t root_page_id_{INVALID_PAGE_ID};
   BufferPoolManager *buffer_pool_manager_;
+  BufferPoolManager *roots_pool_;  // the index roots page is shared by all indexes and stays in the catalog pool
   KeyManager processor_;
   int leaf_max_size_;
   int internal_max_size_;
+  ExtentReservation reservation_;  // contiguous pages reserved for this index
 };
 
 #endif  // MINISQL_B_PLUS_TREE_H
@@ -7,7 +7,11 @@
 
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager);
+  /**
+   * @param roots_pool pool the index roots page is fetched through, nullptr for buffer_pool_manager
+   */
+  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager,
+                 BufferPoolManager *roots_pool = nullptr);
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
 
@@ -17,6 +21,10 @@ class BPlusTreeIndex : public Index {
 
   dberr_t Destroy() override;
 
+  void GetPageIds(std::vector<page_id_t> *page_ids) override;
+
+  void SetBufferPoolManager(BufferPoolManager *buffer_pool_manager) override;
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
@@ -7,6 +7,8 @@
 #include "concurrency/txn.h"
 #include "record/row.h"
 
+class BufferPoolManager;
+
 class Index {
  public:
   explicit Index(index_id_t index_id, IndexSchema *key_schema) : index_id_(index_id), key_schema_(key_schema) {}
@@ -21,6 +23,16 @@ class Index {
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Append the ids of the pages the index consists of
+   */
+  virtual void GetPageIds(std::vector<page_id_t> *page_ids) = 0;
+
+  /**
+   * Fetch and create the pages of the index through another buffer pool from now on
+   */
+  virtual void SetBufferPoolManager(BufferPoolManager *buffer_pool_manager) = 0;
+
  protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
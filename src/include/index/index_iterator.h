@@ -2,6 +2,7 @@
 #define MINISQL_INDEX_ITERATOR_H
 
 #include <iterator>
+#include "buffer/read_ahead_detector.h"
 #include "page/b_plus_tree_leaf_page.h"
 
 class IndexIterator {
@@ -11,7 +12,11 @@ class IndexIterator {
   // you may define your own constructor based on your member variables
   explicit IndexIterator();
 
-  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0);
+  /**
+   * @param reservation the pages of the index, the read ahead does not go past its runs
+   */
+  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0,
+                         ExtentReservation *reservation = nullptr);
 
   ~IndexIterator();
 
@@ -28,11 +33,18 @@ class IndexIterator {
   bool operator!=(const IndexIterator &itr) const;
 
  private:
+  /**
+   * @return pages to prefetch after moving to current_page_id
+   */
+  std::vector<page_id_t> ReadAhead();
+
   page_id_t current_page_id{INVALID_PAGE_ID};
   LeafPage *page{nullptr};
   int item_index{0};
   BufferPoolManager *buffer_pool_manager{nullptr};
   // add your own private member variables here
+  ExtentReservation *reservation_{nullptr};
+  ReadAheadDetector read_ahead_;  // prefetches the next leaf pages while the iterator moves along the leaf chain
 };
 
 #endif  // MINISQL_INDEX_ITERATOR_H
@@ -27,7 +27,7 @@
 #include "index/generic_key.h"
 #include "page/b_plus_tree_page.h"
 
-#define LEAF_PAGE_HEADER_SIZE 32
+#define LEAF_PAGE_HEADER_SIZE (sizeof(BPlusTreePage) + sizeof(page_id_t))  // 32 bytes with 32-bit page ids
 
 class BPlusTreeLeafPage : public BPlusTreePage {
  public:
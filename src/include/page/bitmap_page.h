@@ -20,6 +20,13 @@ class BitmapPage {
    */
   bool AllocatePage(uint32_t &page_offset);
 
+  /**
+   * Allocate num_pages consecutive pages.
+   * @param page_offset Index in extent of the first page allocated.
+   * @return true if a free run of num_pages pages is found.
+   */
+  bool AllocatePages(uint32_t num_pages, uint32_t &page_offset);
+
   /**
    * @return true if successfully de-allocate a page.
    */
@@ -40,6 +47,16 @@ class BitmapPage {
    */
   bool IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const;
 
+  /**
+   * Find the first free page at or after start, wrapping around the end of the bitmap.
+   * The bitmap is scanned one 64-bit word at a time.
+   *
+   * @param start page offset to start searching from
+   * @param[out] page_offset offset of the free page found
+   * @return true if a free page is found
+   */
+  bool FindFreePage(uint32_t start, uint32_t &page_offset) const;
+
   /** Note: need to update if modify page structure. */
   static constexpr size_t MAX_CHARS = PageSize - 2 * sizeof(uint32_t);
 
@@ -1,29 +1,60 @@
 #ifndef MINISQL_DISK_FILE_META_PAGE_H
 #define MINISQL_DISK_FILE_META_PAGE_H
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #include "page/bitmap_page.h"
 
-static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 8) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
-
+using page_count_t = std::make_unsigned_t<page_id_t>;
+
+// number of extent counters fit in the meta page
+static constexpr uint32_t META_EXTENT_NUM = (PAGE_SIZE - 2 * sizeof(page_count_t)) / sizeof(uint32_t);
+// number of extent counters fit in one extent directory page
+static constexpr uint32_t DIRECTORY_EXTENT_NUM = PAGE_SIZE / sizeof(uint32_t);
+// every extent costs its pages, its bitmap page and at most one more page for the meta and directory pages, so the
+// physical page ids of MAX_EXTENT_NUM extents still fit in page_id_t
+static constexpr uint32_t MAX_EXTENT_NUM = static_cast<uint32_t>(
+    std::min<uint64_t>(std::numeric_limits<uint32_t>::max(),
+                       std::numeric_limits<page_id_t>::max() / (BitmapPage<PAGE_SIZE>::GetMaxSupportedSize() + 2)));
+static constexpr page_id_t MAX_VALID_PAGE_ID =
+    static_cast<page_id_t>(MAX_EXTENT_NUM) * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+
+/**
+ * The meta page holds the used page counters of the first META_EXTENT_NUM extents. The counters of the following
+ * extents are kept in ExtentDirectoryPage.
+ */
 class DiskFileMetaPage {
  public:
   uint32_t GetExtentNums() { return num_extents_; }
 
-  uint32_t GetAllocatedPages() { return num_allocated_pages_; }
+  page_count_t GetAllocatedPages() { return num_allocated_pages_; }
 
+  /**
+   * Note: only the first META_EXTENT_NUM extents, use DiskManager::GetExtentUsedPage() for the others
+   */
   uint32_t GetExtentUsedPage(uint32_t extent_id) {
-    if (extent_id >= num_extents_) {
+    if (extent_id >= num_extents_ || extent_id >= META_EXTENT_NUM) {
       return 0;
     }
     return extent_used_page_[extent_id];
   }
 
  public:
-  uint32_t num_allocated_pages_{0};
+  page_count_t num_allocated_pages_{0};
   uint32_t num_extents_{0};  // each extent consists with a bit map and BIT_MAP_SIZE pages
   uint32_t extent_used_page_[0];
 };
 
+/**
+ * Used page counters of DIRECTORY_EXTENT_NUM extents beyond the meta page. Each directory page is stored right in
+ * front of the extents it describes, so its position follows from the extent id like the position of a bitmap page.
+ */
+class ExtentDirectoryPage {
+ public:
+  uint32_t extent_used_page_[DIRECTORY_EXTENT_NUM];
+};
+
 #endif  // MINISQL_DISK_FILE_META_PAGE_H
@@ -28,6 +28,9 @@ class HeaderPage : public Page {
 
   static const uint32_t HEADER_PAGE_MAX_ENTRY_NAME_LEN = 32;
 
+  // name followed by root page id, 36 bytes with 32-bit page ids
+  static const uint32_t RECORD_SIZE = HEADER_PAGE_MAX_ENTRY_NAME_LEN + sizeof(page_id_t);
+
  private:
   /**
    * helper functions
@@ -2,6 +2,7 @@
 #define MINISQL_INDEX_ROOTS_PAGE_H
 
 #include <string>
+#include <utility>
 
 #include "common/config.h"
 
@@ -13,6 +14,7 @@
  *  -----------------------------------------------------------------
  * | RecordCount (4) | Index_1 id (4) | Index_1 root_id (4) | ... |
  *  -----------------------------------------------------------------
+ * With MINISQL_PAGE_ID_64 root ids take 8 bytes and every field is 8-byte aligned.
  */
 class IndexRootsPage {
  public:
@@ -30,7 +32,8 @@ class IndexRootsPage {
   int GetIndexCount() { return count_; }
 
  private:
-  static constexpr int MAX_INDEX_COUNT = (PAGE_SIZE - 4) / 8;
+  static constexpr int MAX_INDEX_COUNT =
+      (PAGE_SIZE - sizeof(std::pair<index_id_t, page_id_t>)) / sizeof(std::pair<index_id_t, page_id_t>);
 
   int FindIndex(const index_id_t index_id);
 
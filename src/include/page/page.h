@@ -1,27 +1,59 @@
 #ifndef MINISQL_PAGE_H
 #define MINISQL_PAGE_H
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <shared_mutex>
 
 #include "common/config.h"
-#include "common/rwlatch.h"
+#include "common/futex_rwlatch.h"
+
+/**
+ * Book-keeping of a page that the buffer pool reads on its hot paths and when it scans all frames. The buffer pool
+ * keeps them in a dense array of their own, apart from the page data and the latches.
+ */
+class PageMeta {
+  friend class Page;
+  friend class BufferPoolManagerInstance;
+
+  /** The ID of this page. */
+  std::atomic<page_id_t> page_id_{INVALID_PAGE_ID};
+  /** The pin count of this page, a buffer pool hit pins the page without taking a latch. */
+  std::atomic<int> pin_count_{0};
+  /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
+  std::atomic<bool> is_dirty_{false};
+  /** Set by a fetch that logs the access for the replacer, cleared once the replacer has seen the access. */
+  std::atomic<bool> ref_{false};
+  /** Set while a checkpoint writes a copy of the page, the frame is not evicted until the copy is on disk. */
+  std::atomic<bool> write_back_{false};
+};
 
 /**
  * Page is the basic unit of storage within the database system. Page provides a wrapper for actual data pages being
- * held in main memory. Page also contains book-keeping information that is used by the buffer pool manager, e.g.
+ * held in main memory. Page also refers to book-keeping information that is used by the buffer pool manager, e.g.
  * pin count, dirty flag, page id, etc.
  */
 class Page {
   // There is book-keeping information inside the page that should only be relevant to the buffer pool manager.
-  friend class BufferPoolManager;
+  friend class BufferPoolManagerInstance;
 
  public:
   DISALLOW_COPY(Page)
 
-  /** Constructor. Zeros out the page data. */
-  Page() { ResetMemory(); }
+  /** Constructor. The page owns its data, zeroed out, and book-keeping, used for pages outside of a buffer pool. */
+  Page()
+      : own_data_(new char[PAGE_SIZE]()),
+        own_meta_(new PageMeta()),
+        data_(own_data_.get()),
+        meta_(own_meta_.get()) {}
+
+  /**
+   * Constructor. The data lives elsewhere, i.e. in a frame of the buffer pool or in a mapping of the db file, the
+   * book-keeping in the metadata array of the buffer pool.
+   */
+  Page(char *data, PageMeta *meta) : data_(data), meta_(meta) {}
 
   /** Default destructor. */
   ~Page() = default;
@@ -30,13 +62,13 @@ class Page {
   inline char *GetData() { return data_; }
 
   /** @return the page id of this page */
-  inline page_id_t GetPageId() { return page_id_; }
+  inline page_id_t GetPageId() { return meta_->page_id_.load(std::memory_order_relaxed); }
 
   /** @return the pin count of this page */
-  inline int GetPinCount() { return pin_count_; }
+  inline int GetPinCount() { return meta_->pin_count_.load(std::memory_order_relaxed); }
 
   /** @return true if the page in memory has been modified from the page on disk, false otherwise */
-  inline bool IsDirty() { return is_dirty_; }
+  inline bool IsDirty() { return meta_->is_dirty_.load(std::memory_order_relaxed); }
 
   /** Acquire the page write latch. */
   inline void WLatch() { rwlatch_.WLock(); }
@@ -57,27 +89,26 @@ class Page {
   inline void SetLSN(lsn_t lsn) { memcpy(GetData() + OFFSET_LSN, &lsn, sizeof(lsn_t)); }
 
  protected:
-  static_assert(sizeof(page_id_t) == 4);
   static_assert(sizeof(lsn_t) == 4);
 
-  static constexpr size_t SIZE_PAGE_HEADER = 8;
+  static constexpr size_t SIZE_PAGE_HEADER = sizeof(page_id_t) + sizeof(lsn_t);
   static constexpr size_t OFFSET_PAGE_START = 0;
-  static constexpr size_t OFFSET_LSN = 4;
+  static constexpr size_t OFFSET_LSN = sizeof(page_id_t);
 
  private:
   /** Zeroes out the data that is held within the page. */
   inline void ResetMemory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }
 
+  /** Storage of data_ if the page owns it. */
+  std::unique_ptr<char[]> own_data_;
+  /** Storage of meta_ if the page owns it. */
+  std::unique_ptr<PageMeta> own_meta_;
   /** The actual data that is stored within a page. */
-  char data_[PAGE_SIZE]{};
-  /** The ID of this page. */
-  page_id_t page_id_ = INVALID_PAGE_ID;
-  /** The pin count of this page. */
-  int pin_count_ = 0;
-  /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
-  bool is_dirty_ = false;
+  char *data_;
+  /** Page id, pin count, dirty and reference flag. */
+  PageMeta *meta_;
   /** Page latch. */
-  ReaderWriterLatch rwlatch_;
+  FutexReaderWriterLatch rwlatch_;
 };
 
 #endif  // MINISQL_PAGE_H
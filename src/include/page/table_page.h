@@ -8,7 +8,7 @@
  *                                ^
  *                                free space pointer
  *
- *  Header format (size in bytes):
+ *  Header format (size in bytes, page ids take 8 bytes with MINISQL_PAGE_ID_64):
  *  ----------------------------------------------------------------------------
  *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(4) |
  *  ----------------------------------------------------------------------------
@@ -101,16 +101,15 @@ class TablePage : public Page {
   static uint32_t UnsetDeletedFlag(uint32_t tuple_size) { return static_cast<uint32_t>(tuple_size & (~DELETE_MASK)); }
 
  private:
-  static_assert(sizeof(page_id_t) == 4);
   static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
-  static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
   static constexpr size_t SIZE_TUPLE = 8;
-  static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
-  static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
-  static constexpr size_t OFFSET_FREE_SPACE = 16;
-  static constexpr size_t OFFSET_TUPLE_COUNT = 20;
-  static constexpr size_t OFFSET_TUPLE_OFFSET = 24;
-  static constexpr size_t OFFSET_TUPLE_SIZE = 28;
+  static constexpr size_t OFFSET_PREV_PAGE_ID = SIZE_PAGE_HEADER;
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = OFFSET_PREV_PAGE_ID + sizeof(page_id_t);
+  static constexpr size_t OFFSET_FREE_SPACE = OFFSET_NEXT_PAGE_ID + sizeof(page_id_t);
+  static constexpr size_t OFFSET_TUPLE_COUNT = OFFSET_FREE_SPACE + 4;
+  static constexpr size_t SIZE_TABLE_PAGE_HEADER = OFFSET_TUPLE_COUNT + 4;
+  static constexpr size_t OFFSET_TUPLE_OFFSET = SIZE_TABLE_PAGE_HEADER;
+  static constexpr size_t OFFSET_TUPLE_SIZE = SIZE_TABLE_PAGE_HEADER + 4;
 
  public:
   static constexpr size_t SIZE_MAX_ROW = PAGE_SIZE - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE;
@@ -7,6 +7,8 @@
   int yyerror(char* error);
 %}
 
+%define api.header.include {"parser/minisql_yacc.h"}
+
 %union {
 	pSyntaxNode syntax_node;
 }
@@ -17,6 +19,7 @@
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
+%token <syntax_node> SHRINK CHECKPOINT ALTER POOL
 
 %type <syntax_node> start sql
 %type <syntax_node> sql_create_database sql_drop_database sql_show_databases sql_use_database
@@ -27,7 +30,8 @@
 %type <syntax_node> sql_select select_columns column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_quit sql_exec_file sql_shrink_database sql_set_variable
+%type <syntax_node> sql_checkpoint sql_alter_table sql_alter_index identifier
 
 %%
 
@@ -58,17 +62,30 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_shrink_database { $$ = $1; }
+  | sql_set_variable { $$ = $1; }
+  | sql_checkpoint { $$ = $1; }
+  | sql_alter_table { $$ = $1; }
+  | sql_alter_index { $$ = $1; }
+  ;
+
+identifier:
+  IDENTIFIER { $$ = $1; }
+  | SHRINK { $$ = $1; }
+  | CHECKPOINT { $$ = $1; }
+  | ALTER { $$ = $1; }
+  | POOL { $$ = $1; }
   ;
 
 sql_create_database:
-  CREATE DATABASE IDENTIFIER {
+  CREATE DATABASE identifier {
     $$ = CreateSyntaxNode(kNodeCreateDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_drop_database:
-  DROP DATABASE IDENTIFIER {
+  DROP DATABASE identifier {
     $$ = CreateSyntaxNode(kNodeDropDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
@@ -80,8 +97,28 @@ sql_show_databases:
   }
   ;
 
+sql_shrink_database:
+  SHRINK DATABASE {
+    $$ = CreateSyntaxNode(kNodeShrinkDB, NULL);
+  }
+  ;
+
+sql_set_variable:
+  SET identifier EQ NUMBER {
+    $$ = CreateSyntaxNode(kNodeSetVariable, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddChildren($$, $4);
+  }
+  ;
+
+sql_checkpoint:
+  CHECKPOINT {
+    $$ = CreateSyntaxNode(kNodeCheckpoint, NULL);
+  }
+  ;
+
 sql_use_database:
-  USE IDENTIFIER {
+  USE identifier {
     $$ = CreateSyntaxNode(kNodeUseDB, NULL);
     SyntaxNodeAddChildren($$, $2);
   }
@@ -94,7 +131,7 @@ sql_show_tables:
   ;
 
 sql_create_table:
-  CREATE TABLE IDENTIFIER '(' column_definition_list ')' {
+  CREATE TABLE identifier '(' column_definition_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
     pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
     SyntaxNodeAddChildren(list_node, $5);
@@ -104,11 +141,11 @@ sql_create_table:
   ;
 
 column_list:
-  IDENTIFIER ',' column_list {
+  identifier ',' column_list {
     $$ = $1;
     SyntaxNodeAddSibling($$, $3);
   }
-  | IDENTIFIER {
+  | identifier {
     $$ = $1;
   }
   ;
@@ -128,12 +165,12 @@ column_definition_list:
   ;
 
 column_definition:
-  IDENTIFIER column_type UNIQUE {
+  identifier column_type UNIQUE {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, "unique");
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
   }
-  | IDENTIFIER column_type {
+  | identifier column_type {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
@@ -154,14 +191,14 @@ column_type:
   ;
 
 sql_drop_table:
-  DROP TABLE IDENTIFIER {
+  DROP TABLE identifier {
     $$ = CreateSyntaxNode(kNodeDropTable, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_create_index:
-  CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' {
+  CREATE INDEX identifier ON identifier '(' column_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, $5);
@@ -169,7 +206,7 @@ sql_create_index:
     SyntaxNodeAddChildren(index_keys_node, $7);
     SyntaxNodeAddChildren($$, index_keys_node);
   }
-  | CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' USING IDENTIFIER {
+  | CREATE INDEX identifier ON identifier '(' column_list ')' USING identifier {
       $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
       SyntaxNodeAddChildren($$, $3);
       SyntaxNodeAddChildren($$, $5);
@@ -183,12 +220,28 @@ sql_create_index:
   ;
 
 sql_drop_index:
-  DROP INDEX IDENTIFIER {
+  DROP INDEX identifier {
     $$ = CreateSyntaxNode(kNodeDropIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
+sql_alter_table:
+  ALTER TABLE identifier SET POOL identifier {
+    $$ = CreateSyntaxNode(kNodeAlterTable, NULL);
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, $6);
+  }
+  ;
+
+sql_alter_index:
+  ALTER INDEX identifier SET POOL identifier {
+    $$ = CreateSyntaxNode(kNodeAlterIndex, NULL);
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, $6);
+  }
+  ;
+
 sql_show_indexes:
   SHOW INDEXES {
     $$ = CreateSyntaxNode(kNodeShowIndexes, NULL);
@@ -196,12 +249,12 @@ sql_show_indexes:
   ;
 
 sql_select:
-  SELECT select_columns FROM IDENTIFIER {
+  SELECT select_columns FROM identifier {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
   }
-  | SELECT select_columns FROM IDENTIFIER WHERE where_conditions {
+  | SELECT select_columns FROM identifier WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
@@ -242,7 +295,7 @@ connector:
   ;
 
 where_condition:
-  IDENTIFIER operator column_value {
+  identifier operator column_value {
     $$ = $2;
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -289,7 +342,7 @@ operator:
   ;
 
 sql_insert:
-  INSERT INTO IDENTIFIER VALUES '(' column_values ')' {
+  INSERT INTO identifier VALUES '(' column_values ')' {
     $$ = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode col_val_node = CreateSyntaxNode(kNodeColumnValues, NULL);
@@ -309,11 +362,11 @@ column_values:
   ;
 
 sql_delete:
-  DELETE FROM IDENTIFIER {
+  DELETE FROM identifier {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
-  | DELETE FROM IDENTIFIER WHERE where_conditions {
+  | DELETE FROM identifier WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
@@ -323,14 +376,14 @@ sql_delete:
   ;
 
 sql_update:
-  UPDATE IDENTIFIER SET update_values {
+  UPDATE identifier SET update_values {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     pSyntaxNode upd_values_node = CreateSyntaxNode(kNodeUpdateValues, NULL);
     SyntaxNodeAddChildren(upd_values_node, $4);
     SyntaxNodeAddChildren($$, upd_values_node);
   }
-  | UPDATE IDENTIFIER SET update_values WHERE where_conditions {
+  | UPDATE identifier SET update_values WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     // update values
@@ -355,7 +408,7 @@ update_values:
   ;
 
 update_value:
-  IDENTIFIER EQ column_value {
+  identifier EQ column_value {
     $$ = CreateSyntaxNode(kNodeUpdateValue, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -43,7 +43,12 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin recovery command */
   kNodeTrxCommit,            /** commit recovery command */
-  kNodeTrxRollback           /** rollback recovery command */
+  kNodeTrxRollback,          /** rollback recovery command */
+  kNodeShrinkDB,             /** shrink database command */
+  kNodeSetVariable,          /** set variable command */
+  kNodeCheckpoint,           /** checkpoint command */
+  kNodeAlterTable,           /** alter table set pool command */
+  kNodeAlterIndex            /** alter index set pool command */
 } SyntaxNodeType;
 
 /**
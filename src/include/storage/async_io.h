@@ -0,0 +1,136 @@
+#ifndef MINISQL_ASYNC_IO_H
+#define MINISQL_ASYNC_IO_H
+
+#ifdef MINISQL_HAVE_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * Completion handle of an asynchronous page read or write, get() blocks until the request finished and returns
+ * whether it succeeded. A read that ends beyond the end of file succeeds with the missing part zero filled.
+ */
+using IOHandle = std::future<bool>;
+
+/**
+ * AsyncIOEngine issues page sized reads and writes on a file descriptor without blocking the caller.
+ */
+class AsyncIOEngine {
+ public:
+  AsyncIOEngine() = default;
+
+  virtual ~AsyncIOEngine() = default;
+
+  /**
+   * Read PAGE_SIZE bytes at offset into page_data, page_data must stay valid until the handle completes
+   */
+  virtual IOHandle Read(int fd, char *page_data, size_t offset) = 0;
+
+  /**
+   * Write PAGE_SIZE bytes of page_data at offset, page_data must stay valid until the handle completes
+   */
+  virtual IOHandle Write(int fd, const char *page_data, size_t offset) = 0;
+
+  /**
+   * @return io_uring engine if the kernel supports it, the thread pool engine otherwise
+   */
+  static std::unique_ptr<AsyncIOEngine> Create(size_t queue_depth);
+};
+
+/**
+ * Runs blocking pread/pwrite on a small pool of I/O threads.
+ */
+class ThreadPoolIOEngine : public AsyncIOEngine {
+ public:
+  explicit ThreadPoolIOEngine(size_t num_threads);
+
+  ~ThreadPoolIOEngine() override;
+
+  IOHandle Read(int fd, char *page_data, size_t offset) override;
+
+  IOHandle Write(int fd, const char *page_data, size_t offset) override;
+
+ private:
+  IOHandle Submit(std::function<bool()> task);
+
+  void WorkerLoop();
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::packaged_task<bool()>> tasks_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  bool stop_{false};
+};
+
+#ifdef MINISQL_HAVE_IO_URING
+/**
+ * Submits requests to an io_uring instance set up with raw syscalls, a reaper thread completes the handles.
+ */
+class IOUringEngine : public AsyncIOEngine {
+ public:
+  /**
+   * @return nullptr if io_uring is not available, e.g. disabled by the kernel or a seccomp profile
+   */
+  static std::unique_ptr<IOUringEngine> Create(size_t queue_depth);
+
+  ~IOUringEngine() override;
+
+  IOHandle Read(int fd, char *page_data, size_t offset) override;
+
+  IOHandle Write(int fd, const char *page_data, size_t offset) override;
+
+ private:
+  struct Request;
+
+  IOUringEngine() = default;
+
+  bool Setup(size_t queue_depth);
+
+  /**
+   * Put one sqe into the submission ring and notify the kernel, blocks while the ring is full
+   */
+  void Submit(uint8_t opcode, int fd, void *buf, size_t offset, Request *request);
+
+  void ReapLoop();
+
+ private:
+  int ring_fd_{-1};
+  // submission ring
+  void *sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  unsigned *sq_head_{nullptr};
+  unsigned *sq_tail_{nullptr};
+  unsigned *sq_mask_{nullptr};
+  unsigned *sq_array_{nullptr};
+  struct io_uring_sqe *sqes_{nullptr};
+  size_t sqes_size_{0};
+  // completion ring, shares the mapping with the submission ring if the kernel supports it
+  void *cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned *cq_mask_{nullptr};
+  struct io_uring_cqe *cqes_{nullptr};
+  unsigned num_entries_{0};
+  // number of submitted requests not reaped yet, never exceeds num_entries_ so the completion ring cannot overflow
+  unsigned in_flight_{0};
+  std::mutex submit_latch_;
+  std::condition_variable submit_cv_;
+  std::thread reaper_;
+};
+#endif
+
+#endif  // MINISQL_ASYNC_IO_H
@@ -1,16 +1,87 @@
 #ifndef DISK_MGR_H
 #define DISK_MGR_H
 
+#include <sys/uio.h>
+
 #include <atomic>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <vector>
 
 #include "common/config.h"
 #include "common/macros.h"
 #include "page/bitmap_page.h"
 #include "page/disk_file_meta_page.h"
+#include "storage/async_io.h"
+
+/**
+ * Backend used by the DiskManager to move pages between memory and the db file.
+ */
+enum class DiskIOMode {
+  kFstream,      /** one std::fstream with a shared cursor, every access serialized by db_io_latch_ */
+  kPositional,   /** pread/pwrite on a raw file descriptor, reads from different threads run in parallel */
+  kDirect,       /** like kPositional but opened with O_DIRECT, pages bypass the kernel page cache */
+  kMmapReadOnly  /** the existing db file is mapped read-only, pages are read from the mapping and writes rejected */
+};
+
+/**
+ * When page writes reach the db file and when they are made durable.
+ */
+enum class DurabilityMode {
+  kWriteThrough, /** every page write is issued to the file immediately, Sync() only adds the fdatasync barrier */
+  kGroupCommit   /** page writes are queued and issued in coalesced pwritev batches, each followed by one fdatasync */
+};
+
+/**
+ * Frees page buffers allocated by DiskManager::AllocateAlignedPages()
+ */
+struct AlignedPageDeleter {
+  void operator()(char *ptr) const { free(ptr); }
+};
+
+using AlignedPageBuffer = std::unique_ptr<char[], AlignedPageDeleter>;
+
+/**
+ * Pages reserved for one table heap or index. Runs of contiguous pages are taken from the DiskManager and handed out
+ * one at a time, so that the pages of one object are next to each other in the db file instead of interleaved with
+ * the pages of every other object. The pages not handed out yet are only taken in memory, the db file keeps them free
+ * so that a crash does not leak them.
+ */
+class ExtentReservation {
+  friend class DiskManager;
+
+ public:
+  explicit ExtentReservation(uint32_t run_size = DEFAULT_RUN_SIZE) : run_size_(run_size) {}
+
+  /**
+   * @return number of reserved pages not handed out yet
+   */
+  inline uint32_t GetRemaining() const { return end_page_id_ - next_page_id_; }
+
+  /**
+   * @return end of the run page_id was handed out from, page_id + 1 if it is not in a run of this reservation. The
+   * runs are only known until the db file is closed.
+   */
+  page_id_t GetRunEnd(page_id_t page_id);
+
+  // number of pages reserved at a time
+  static constexpr uint32_t DEFAULT_RUN_SIZE = 64;
+
+ private:
+  uint32_t run_size_;
+  // reserved pages not handed out yet: [next_page_id_, end_page_id_)
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  page_id_t end_page_id_{INVALID_PAGE_ID};
+  // runs pages were handed out from, first page id -> end page id
+  std::map<page_id_t, page_id_t> runs_;
+  std::mutex latch_;
+};
 
 /**
  * DiskManager takes care of the allocation and de allocation of pages within a database. It performs the reading and
@@ -19,10 +90,16 @@
  * Disk page storage format: (Free Page BitMap Size = PAGE_SIZE * 8, we note it as N)
  * | Meta Page | Free Page BitMap 1 | Page 1 | Page 2 | ....
  *      | Page N | Free Page BitMap 2 | Page N+1 | ... | Page 2N | ... |
+ *
+ * The meta page counts the used pages of the first META_EXTENT_NUM extents. Every following group of
+ * DIRECTORY_EXTENT_NUM extents is preceded by an extent directory page holding their counters:
+ * | Meta Page | Extent 1 | ... | Extent M | Directory Page 1 | Extent M+1 | ... | Extent M+D | Directory Page 2 | ...
+ * Files with no more than META_EXTENT_NUM extents keep the original format.
  */
 class DiskManager {
  public:
-  explicit DiskManager(const std::string &db_file);
+  explicit DiskManager(const std::string &db_file, DiskIOMode io_mode = DiskIOMode::kPositional,
+                       DurabilityMode durability = DurabilityMode::kWriteThrough);
 
   ~DiskManager() {
     if (!closed) {
@@ -42,12 +119,47 @@ class DiskManager {
    */
   void WritePage(page_id_t logical_page_id, const char *page_data);
 
+  /**
+   * Write a batch of pages in the order of their offset in the db file, each run of physically contiguous pages with
+   * one pwritev
+   * @param pages logical page ids with the data to write, each page at most once
+   */
+  void WritePages(std::vector<std::pair<page_id_t, const char *>> pages);
+
+  /**
+   * Read page without blocking, page_data must stay valid until the returned handle completes
+   */
+  IOHandle ReadPageAsync(page_id_t logical_page_id, char *page_data);
+
+  /**
+   * Write page without blocking, page_data must stay valid until the returned handle completes
+   * Note: in DurabilityMode::kGroupCommit the page is only queued, so the handle is complete on return
+   */
+  IOHandle WritePageAsync(page_id_t logical_page_id, const char *page_data);
+
   /**
    * Get next free page from disk
    * @return logical page id of allocated page
    */
   page_id_t AllocatePage();
 
+  /**
+   * Allocate num_pages contiguous pages, all of them in the same extent
+   * @return logical page id of the first page, INVALID_PAGE_ID if there is no such run
+   */
+  page_id_t AllocateContiguousPages(uint32_t num_pages);
+
+  /**
+   * Hand out the next page of the reservation, a new run of contiguous pages is reserved when it is used up
+   * @return logical page id of allocated page
+   */
+  page_id_t AllocatePage(ExtentReservation *reservation);
+
+  /**
+   * Free the pages of the reservation that were not handed out yet, must be called before the reservation is destroyed
+   */
+  void ReleaseReservation(ExtentReservation *reservation);
+
   /**
    * Free this page and reset bit map
    */
@@ -55,9 +167,32 @@ class DiskManager {
 
   /**
    * Return whether specific logical_page_id is free
+   * Note: answered from the in-memory bitmaps, no disk access
    */
   bool IsPageFree(page_id_t logical_page_id);
 
+  /**
+   * @return number of used pages in specific extent
+   */
+  uint32_t GetExtentUsedPage(uint32_t extent_id);
+
+  /**
+   * Write back dirty bitmap pages, dirty directory pages and the meta page, with the reserved pages not handed out yet
+   * as free
+   */
+  void Checkpoint();
+
+  /**
+   * Issue all queued page writes and make everything written so far durable with a single fdatasync
+   */
+  void Sync();
+
+  /**
+   * Release trailing extents that have no allocated page and truncate the db file accordingly
+   * @return number of extents released
+   */
+  uint32_t Shrink();
+
   /**
    * Shut down the disk manager and close all the file resources.
    */
@@ -69,13 +204,61 @@ class DiskManager {
    */
   char *GetMetaData() { return meta_data_; }
 
+  /**
+   * @return the I/O backend this disk manager was opened with
+   */
+  inline DiskIOMode GetIOMode() const { return io_mode_; }
+
+  /**
+   * @return whether the db file is opened read-only, every write and allocation is rejected then
+   */
+  inline bool IsReadOnly() const { return io_mode_ == DiskIOMode::kMmapReadOnly; }
+
+  /**
+   * Only used by DiskIOMode::kMmapReadOnly
+   * @return address of specific page in the mapping of the db file, nullptr if it is beyond the end of file
+   */
+  const char *GetPageAddress(page_id_t logical_page_id);
+
+  /**
+   * @return the durability mode this disk manager was opened with
+   */
+  inline DurabilityMode GetDurabilityMode() const { return durability_; }
+
+  /**
+   * Allocate zero filled memory for num_pages pages aligned to PAGE_SIZE, which DiskIOMode::kDirect transfers without
+   * a bounce buffer. Release it with free() or hand it to an AlignedPageBuffer.
+   */
+  static char *AllocateAlignedPages(size_t num_pages);
+
   static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
 
+  // number of queued page writes that triggers a Sync() in DurabilityMode::kGroupCommit
+  static constexpr size_t GROUP_COMMIT_BATCH_SIZE = 256;
+
+  // max number of asynchronous requests in flight at the same time
+  static constexpr size_t ASYNC_IO_QUEUE_DEPTH = 64;
+
+  // disk space is reserved with fallocate in chunks of this size as pages get allocated
+  static constexpr size_t FILE_GROWTH_SIZE = 1024 * PAGE_SIZE;
+
  private:
+  /**
+   * @return whether pages are moved with pread/pwrite on db_fd_
+   */
+  inline bool IsPositional() const { return io_mode_ == DiskIOMode::kPositional || io_mode_ == DiskIOMode::kDirect; }
+
+  /**
+   * @return whether page_data has to go through a bounce buffer, O_DIRECT only accepts aligned buffers
+   */
+  inline bool NeedsBounce(const char *page_data) const {
+    return io_mode_ == DiskIOMode::kDirect && reinterpret_cast<uintptr_t>(page_data) % PAGE_SIZE != 0;
+  }
+
   /**
    * Helper function to get disk file size
    */
-  int GetFileSize(const std::string &file_name);
+  size_t GetFileSize(const std::string &file_name);
 
   /**
    * Read physical page from disk
@@ -87,19 +270,168 @@ class DiskManager {
    */
   void WritePhysicalPage(page_id_t physical_page_id, const char *page_data);
 
+  /**
+   * Make sure disk space is reserved up to the end of specific logical page, the file grows in FILE_GROWTH_SIZE steps
+   */
+  void ReserveFileSpace(page_id_t logical_page_id);
+
+  /**
+   * Extend the cached file size to at least end, concurrent writers may race to extend the file
+   */
+  void GrowFileSize(size_t end);
+
+  /**
+   * @return the asynchronous I/O engine, created on first use
+   */
+  AsyncIOEngine *GetIOEngine();
+
+  /**
+   * Write a run of physically contiguous pages starting at first_page_id with pwritev
+   */
+  void WritePhysicalPages(page_id_t first_page_id, std::vector<struct iovec> &iov);
+
+  /**
+   * Copy the queued image of specific physical page into page_data
+   * @return false if the page has no queued write
+   */
+  bool ReadPendingPage(page_id_t physical_page_id, char *page_data);
+
   /**
    * Map logical page id to physical page id
    */
   page_id_t MapPageId(page_id_t logical_page_id);
 
+  /**
+   * @return physical page id of the bitmap page of specific extent
+   */
+  inline page_id_t GetBitmapPageId(uint32_t extent_id) {
+    if (extent_id < META_EXTENT_NUM) {
+      return static_cast<page_id_t>(extent_id * (BITMAP_SIZE + 1) + 1);
+    }
+    uint32_t extent_offset = (extent_id - META_EXTENT_NUM) % DIRECTORY_EXTENT_NUM;
+    return GetDirectoryPageId((extent_id - META_EXTENT_NUM) / DIRECTORY_EXTENT_NUM) + 1 +
+           static_cast<page_id_t>(extent_offset * (BITMAP_SIZE + 1));
+  }
+
+  /**
+   * @return physical page id of specific extent directory page
+   */
+  inline page_id_t GetDirectoryPageId(uint32_t directory_id) {
+    return static_cast<page_id_t>(1 + META_EXTENT_NUM * (BITMAP_SIZE + 1) +
+                                  directory_id * (1 + DIRECTORY_EXTENT_NUM * (BITMAP_SIZE + 1)));
+  }
+
+  /**
+   * @return number of extent directory pages needed by num_extents extents
+   */
+  static inline uint32_t GetDirectoryNums(uint32_t num_extents) {
+    return num_extents <= META_EXTENT_NUM ? 0 : (num_extents - META_EXTENT_NUM - 1) / DIRECTORY_EXTENT_NUM + 1;
+  }
+
+  /**
+   * @return used page counter of specific extent, in the meta page or in a directory page
+   */
+  inline uint32_t &ExtentUsedPage(uint32_t extent_id) {
+    if (extent_id < META_EXTENT_NUM) {
+      return reinterpret_cast<DiskFileMetaPage *>(meta_data_)->extent_used_page_[extent_id];
+    }
+    uint32_t directory_id = (extent_id - META_EXTENT_NUM) / DIRECTORY_EXTENT_NUM;
+    auto *directory = reinterpret_cast<ExtentDirectoryPage *>(directories_[directory_id].get());
+    return directory->extent_used_page_[(extent_id - META_EXTENT_NUM) % DIRECTORY_EXTENT_NUM];
+  }
+
+  /**
+   * Add delta to the used page counter of specific extent and mark the page holding it dirty
+   * @return the new counter
+   */
+  uint32_t AddExtentUsedPage(uint32_t extent_id, int32_t delta);
+
+  /**
+   * Append an empty extent, together with a new directory page if the last one is full
+   * @return false if the db file cannot have more extents
+   */
+  bool AddExtent();
+
+  /**
+   * Allocate num_pages contiguous pages in one extent, bitmap_latch_ must be held
+   * @param reserve whether the pages are reserved for an ExtentReservation, see reserved_pages_
+   */
+  page_id_t AllocateRun(uint32_t num_pages, bool reserve);
+
+  /**
+   * Write back the meta page with the reserved pages not handed out yet as free, bitmap_latch_ must be held
+   */
+  void WriteMetaPage();
+
+  /**
+   * @return the lowest extent that still has free pages, or num_extents if all extents are full
+   */
+  uint32_t FindFreeExtent(uint32_t num_extents) const;
+
+  /**
+   * Record whether specific extent has free pages
+   */
+  inline void SetExtentFree(uint32_t extent_id, bool has_free) {
+    if (extent_id / 64 >= free_extents_.size()) {
+      free_extents_.resize(extent_id / 64 + 1, 0);
+    }
+    if (has_free) {
+      free_extents_[extent_id / 64] |= uint64_t{1} << (extent_id % 64);
+    } else {
+      free_extents_[extent_id / 64] &= ~(uint64_t{1} << (extent_id % 64));
+    }
+  }
+
+  /**
+   * @return in-memory bitmap page of specific extent
+   */
+  inline BitmapPage<PAGE_SIZE> *GetBitmap(uint32_t extent_id) {
+    return reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmaps_[extent_id].get());
+  }
+
  private:
-  // stream to write db file
+  DiskIOMode io_mode_;
+  DurabilityMode durability_;
+  // stream to write db file, only used by DiskIOMode::kFstream
   std::fstream db_io_;
+  // file descriptor of db file, not used by DiskIOMode::kFstream
+  int db_fd_{-1};
+  // read-only mapping of the whole db file, only used by DiskIOMode::kMmapReadOnly
+  char *mapping_{nullptr};
+  // size of db file in byte, kept in memory so that reads need not stat() the file
+  std::atomic<size_t> file_size_{0};
+  // disk space reserved with fallocate, may be beyond file_size_ since the file size is kept unchanged
+  size_t reserved_size_{0};
+  bool fallocate_supported_{true};
   std::string file_name_;
   // with multiple buffer pool instances, need to protect file access
   std::recursive_mutex db_io_latch_;
   bool closed{false};
-  char meta_data_[PAGE_SIZE];
+  alignas(PAGE_SIZE) char meta_data_[PAGE_SIZE];
+  // bitmap pages of all extents stay resident, dirty ones are written back at Checkpoint() or Close()
+  std::vector<AlignedPageBuffer> bitmaps_;
+  std::vector<bool> bitmap_dirty_;
+  // extent directory pages stay resident as well
+  std::vector<AlignedPageBuffer> directories_;
+  std::vector<bool> directory_dirty_;
+  // one bit per extent, set if the extent still has free pages
+  std::vector<uint64_t> free_extents_;
+  // pages of ExtentReservations not handed out yet, first page id -> end page id of each run. They are allocated in
+  // the bitmaps and counters in memory, but written back as free
+  std::map<page_id_t, page_id_t> reserved_pages_;
+  // protects meta_data_, bitmaps_, directories_ and reserved_pages_
+  std::shared_mutex bitmap_latch_;
+  // page writes queued in DurabilityMode::kGroupCommit, ordered by physical page id so that runs can be coalesced
+  std::map<page_id_t, AlignedPageBuffer> pending_writes_;
+  // the batch currently being written by Sync(), still visible to readers until it is on disk
+  std::map<page_id_t, AlignedPageBuffer> flushing_writes_;
+  // protects pending_writes_ and flushing_writes_
+  std::mutex pending_latch_;
+  // only one Sync() writes a batch at a time
+  std::mutex sync_latch_;
+  // serves ReadPageAsync() and WritePageAsync(), only used by DiskIOMode::kPositional and DiskIOMode::kDirect
+  std::unique_ptr<AsyncIOEngine> io_engine_;
+  std::once_flag io_engine_once_;
 };
 
 #endif
\ No newline at end of file
@@ -24,15 +24,16 @@ class TableHeap {
     return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
   }
 
-  ~TableHeap() {}
+  ~TableHeap() { buffer_pool_manager_->ReleaseReservation(&reservation_); }
 
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
    * @param[in/out] row Tuple Row to insert, the rid of the inserted tuple is wrapped in object row
    * @param[in] txn The transaction performing the insert
+   * @param[in] strategy ring of frames of a bulk insert, nullptr for none
    * @return true iff the insert is successful
    */
-  bool InsertTuple(Row &row, Txn *txn);
+  bool InsertTuple(Row &row, Txn *txn, BufferAccessStrategy *strategy = nullptr);
 
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
@@ -74,10 +75,12 @@ class TableHeap {
   bool GetTuple(Row *row, Txn *txn);
 
   void FreeTableHeap() {
+    // every page is read once, so the pages do not go through the replacer
+    BufferAccessStrategy strategy(BufferAccessType::kBulkRead);
     auto next_page_id = first_page_id_;
     while (next_page_id != INVALID_PAGE_ID) {
       auto old_page_id = next_page_id;
-      auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id));
+      auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id, &strategy));
       assert(page != nullptr);
       next_page_id = page->GetNextPageId();
       buffer_pool_manager_->UnpinPage(old_page_id, false);
@@ -91,9 +94,10 @@ class TableHeap {
   void DeleteTable(page_id_t page_id = INVALID_PAGE_ID);
 
   /**
+   * @param strategy ring of frames of a scan that reads the whole table, nullptr for none
    * @return the begin iterator of this table
    */
-  TableIterator Begin(Txn *txn);
+  TableIterator Begin(Txn *txn, BufferAccessStrategy *strategy = nullptr);
 
   /**
    * @return the end iterator of this table
@@ -105,6 +109,19 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * Append the ids of the pages of this table in the order of the page chain
+   */
+  void GetPageIds(std::vector<page_id_t> *page_ids);
+
+  /**
+   * Fetch and create the pages of this table through another buffer pool from now on. The pages must have been evicted
+   * from the old one and no other thread may use the table meanwhile.
+   */
+  inline void SetBufferPoolManager(BufferPoolManager *buffer_pool_manager) {
+    buffer_pool_manager_ = buffer_pool_manager;
+  }
+
  private:
   /**
    * create table heap and initialize first page
@@ -117,7 +134,7 @@ class TableHeap {
         lock_manager_(lock_manager) {
     // 创建第一个表页面
     page_id_t new_page_id;
-    auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id));
+    auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id, &reservation_));
     if (first_page == nullptr) {
       LOG(ERROR) << "Failed to create first page while creating table heap" << std::endl;
       return;
@@ -160,6 +177,7 @@ class TableHeap {
   page_id_t first_page_id_;
   page_id_t last_page_id_;
   unordered_map<page_id_t, uint32_t> free_space_;
+  ExtentReservation reservation_;  // contiguous pages reserved for this table
   Schema *schema_;
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
@@ -1,6 +1,8 @@
 #ifndef MINISQL_TABLE_ITERATOR_H
 #define MINISQL_TABLE_ITERATOR_H
 
+#include "buffer/buffer_access_strategy.h"
+#include "buffer/read_ahead_detector.h"
 #include "common/rowid.h"
 #include "concurrency/txn.h"
 #include "record/row.h"
@@ -10,7 +12,7 @@ class TableHeap;
 class TableIterator {
  public:
   // you may define your own constructor based on your member variables
-  explicit TableIterator(TableHeap *table_heap, RowId rid, Txn *txn);
+  explicit TableIterator(TableHeap *table_heap, RowId rid, Txn *txn, BufferAccessStrategy *strategy = nullptr);
 
   explicit TableIterator(const TableIterator &other);
 
@@ -35,6 +37,8 @@ class TableIterator {
   Row *row_;
   RowId rid_;
   Txn *txn_;
+  ReadAheadDetector read_ahead_;  // prefetches the next pages of the heap while the scan moves along
+  BufferAccessStrategy *strategy_;  // ring the pages of the scan are read into, owned by the caller
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -11,21 +11,22 @@
  * TODO: Student Implement
  */
 BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &KM,
-                     int leaf_max_size, int internal_max_size)
+                     int leaf_max_size, int internal_max_size, BufferPoolManager *roots_pool)
     : index_id_(index_id),
       buffer_pool_manager_(buffer_pool_manager),
+      roots_pool_(roots_pool == nullptr ? buffer_pool_manager : roots_pool),
       processor_(KM),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size),
       root_page_id_(INVALID_PAGE_ID) {  // Initialize root_page_id_ to INVALID_PAGE_ID
   // Try to load root_page_id_ from IndexRootsPage
-  Page *header_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  Page *header_page = roots_pool_->FetchPage(INDEX_ROOTS_PAGE_ID);
   ASSERT(header_page != nullptr, "Failed to fetch index roots page.");
   IndexRootsPage *header = reinterpret_cast<IndexRootsPage *>(header_page->GetData());
   // If not found, it's a new tree or an issue, keep root_page_id_ as INVALID_PAGE_ID
   // It will be updated by StartNewTree or similar logic if it's a new tree.
   header->GetRootId(index_id_, &root_page_id_);
-  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+  roots_pool_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
 
   int key_size = KM.GetKeySize();
   if (leaf_max_size == UNDEFINED_SIZE) {
@@ -38,6 +39,8 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
   }
 }
 
+BPlusTree::~BPlusTree() { buffer_pool_manager_->ReleaseReservation(&reservation_); }
+
 void BPlusTree::Destroy(page_id_t current_page_id_param) {
   page_id_t page_to_destroy_recursively;
   bool is_initial_call = false;
@@ -68,11 +71,11 @@ void BPlusTree::Destroy(page_id_t current_page_id_param) {
                  << " for index_id: " << index_id_;
     // If it's the initial call and root page fetch failed, still try to clean up IndexRootsPage.
     if (is_initial_call) {
-      Page *header_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+      Page *header_page = roots_pool_->FetchPage(INDEX_ROOTS_PAGE_ID);
       if (header_page != nullptr) {
         IndexRootsPage *header = reinterpret_cast<IndexRootsPage *>(header_page->GetData());
         bool modified = header->Delete(index_id_);
-        buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified);
+        roots_pool_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified);
       }
       root_page_id_ = INVALID_PAGE_ID;  // Mark as destroyed locally
     }
@@ -95,11 +98,11 @@ void BPlusTree::Destroy(page_id_t current_page_id_param) {
 
   if (is_initial_call) {
     // After all tree pages are recursively destroyed, remove from IndexRootsPage
-    Page *header_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+    Page *header_page = roots_pool_->FetchPage(INDEX_ROOTS_PAGE_ID);
     if (header_page != nullptr) {
       IndexRootsPage *header = reinterpret_cast<IndexRootsPage *>(header_page->GetData());
       bool modified = header->Delete(index_id_);
-      buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified);
+      roots_pool_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified);
     } else {
       LOG(ERROR) << "BPlusTree::Destroy: Failed to fetch INDEX_ROOTS_PAGE_ID for index_id: " << index_id_;
     }
@@ -140,7 +143,7 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn
   if (IsEmpty()) return false;
 
   Page *leaf_page = FindLeafPage(key, root_page_id_, false);
-  LeafPage *leaf = reinterpret_cast<LeafPage *>(leaf_page);
+  LeafPage *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
   RowId row_id;
   bool found = leaf->Lookup(key, row_id, processor_);
 
@@ -181,7 +184,7 @@ bool BPlusTree::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
  */
 void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
   // Allocate new page for root
-  Page *new_root_page = buffer_pool_manager_->NewPage(root_page_id_);
+  Page *new_root_page = buffer_pool_manager_->NewPage(root_page_id_, &reservation_);
   if (new_root_page == nullptr) {
     throw std::runtime_error("out of memory");
   }
@@ -257,7 +260,7 @@ bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transac
 BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Txn *transaction) {
   // Allocate new page from buffer pool
   page_id_t new_page_id;
-  Page *new_page = buffer_pool_manager_->NewPage(new_page_id);  // NewPage() will new new_page_id
+  Page *new_page = buffer_pool_manager_->NewPage(new_page_id, &reservation_);  // NewPage() will new new_page_id
   if (new_page == nullptr) {
     throw std::runtime_error("out of memory");
   }
@@ -276,7 +279,7 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Txn *transaction) {
 BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Txn *transaction) {
   // Allocate new page from buffer pool
   page_id_t new_page_id;
-  Page *new_page = buffer_pool_manager_->NewPage(new_page_id);
+  Page *new_page = buffer_pool_manager_->NewPage(new_page_id, &reservation_);
   if (new_page == nullptr) {
     throw std::runtime_error("out of memory");
   }
@@ -310,7 +313,7 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
 
   // Case 1: old_node was root, need to create new root
   if (old_node->IsRootPage()) {
-    Page *root_page = buffer_pool_manager_->NewPage(root_page_id_);
+    Page *root_page = buffer_pool_manager_->NewPage(root_page_id_, &reservation_);
     if (root_page == nullptr) {
       throw std::runtime_error("Out of memory while creating new root");
     }
@@ -637,7 +640,7 @@ IndexIterator BPlusTree::Begin() {
   LeafPage *leaf_node = reinterpret_cast<LeafPage *>(leaf_page->GetData());
   page_id_t t_page_id = leaf_node->GetPageId();
   buffer_pool_manager_->UnpinPage(t_page_id, true);
-  return IndexIterator(t_page_id, buffer_pool_manager_, 0);
+  return IndexIterator(t_page_id, buffer_pool_manager_, 0, &reservation_);
 }
 
 // auua: 'low key' 似乎是范围查询的下界，所以找到对应leaf_node，然后通过KeyIndex()返回了第一个大于等于它的index
@@ -653,7 +656,7 @@ IndexIterator BPlusTree::Begin(const GenericKey *key) {
   page_id_t t_page_id = leaf_node->GetPageId();
   int index = leaf_node->KeyIndex(key, processor_);
   buffer_pool_manager_->UnpinPage(t_page_id, true);
-  return IndexIterator(t_page_id, buffer_pool_manager_, index);
+  return IndexIterator(t_page_id, buffer_pool_manager_, index, &reservation_);
 }
 
 // auua: 我感觉这个设计很不合常理，end()不应该是个空值吗...
@@ -716,7 +719,7 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
  * updating it.
  */
 void BPlusTree::UpdateRootPageId() {
-  Page *header_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  Page *header_page = roots_pool_->FetchPage(INDEX_ROOTS_PAGE_ID);
   if (header_page == nullptr) {
     LOG(ERROR) << "UpdateRootPageId: Failed to fetch INDEX_ROOTS_PAGE_ID for index_id: " << index_id_
                << ". Root page ID update will not be persisted.";
@@ -746,7 +749,7 @@ void BPlusTree::UpdateRootPageId() {
       }
     }
   }
-  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified_header);
+  roots_pool_->UnpinPage(INDEX_ROOTS_PAGE_ID, modified_header);
 }
 
 /**
@@ -868,6 +871,33 @@ void BPlusTree::ToString(BPlusTreePage *page, BufferPoolManager *bpm) const {
   }
 }
 
+void BPlusTree::GetPageIds(std::vector<page_id_t> *page_ids) {
+  if (IsEmpty()) {
+    return;
+  }
+  // every node is read once
+  BufferAccessStrategy strategy(BufferAccessType::kBulkRead);
+  std::vector<page_id_t> stack{root_page_id_};
+  while (!stack.empty()) {
+    page_id_t page_id = stack.back();
+    stack.pop_back();
+    Page *page = buffer_pool_manager_->FetchPage(page_id, &strategy);
+    if (page == nullptr) {
+      LOG(ERROR) << "GetPageIds: Failed to fetch page " << page_id << " of index_id: " << index_id_;
+      continue;
+    }
+    page_ids->push_back(page_id);
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (!node->IsLeafPage()) {
+      auto *internal_node = reinterpret_cast<InternalPage *>(node);
+      for (int i = internal_node->GetSize() - 1; i >= 0; i--) {
+        stack.push_back(internal_node->ValueAt(i));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+}
+
 bool BPlusTree::Check() {
   bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
   if (!all_unpinned) {
@@ -3,10 +3,16 @@
 #include "index/generic_key.h"
 #include "utils/tree_file_mgr.h"
 BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
-                               BufferPoolManager *buffer_pool_manager)
+                               BufferPoolManager *buffer_pool_manager, BufferPoolManager *roots_pool)
     : Index(index_id, key_schema),
       processor_(key_schema_, key_size),
-      container_(index_id, buffer_pool_manager, processor_) {}
+      container_(index_id, buffer_pool_manager, processor_, UNDEFINED_SIZE, UNDEFINED_SIZE, roots_pool) {}
+
+void BPlusTreeIndex::GetPageIds(std::vector<page_id_t> *page_ids) { container_.GetPageIds(page_ids); }
+
+void BPlusTreeIndex::SetBufferPoolManager(BufferPoolManager *buffer_pool_manager) {
+  container_.SetBufferPoolManager(buffer_pool_manager);
+}
 
 dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   // ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
@@ -5,12 +5,20 @@
 
 IndexIterator::IndexIterator() = default;
 
-IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index)
-    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm) {
-  if (current_page_id == INVALID_PAGE_ID)
+IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index, ExtentReservation *reservation)
+    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm), reservation_(reservation) {
+  if (current_page_id == INVALID_PAGE_ID) {
     page = nullptr;
-  else
+  } else {
     page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
+    buffer_pool_manager->Prefetch(ReadAhead());
+  }
+}
+
+std::vector<page_id_t> IndexIterator::ReadAhead() {
+  // without the runs of the index only the next leaf is known to belong to it
+  page_id_t owned_end = reservation_ == nullptr ? current_page_id + 1 : reservation_->GetRunEnd(current_page_id);
+  return read_ahead_.OnAccess(current_page_id, page->GetNextPageId(), owned_end);
 }
 
 IndexIterator::~IndexIterator() {
@@ -40,6 +48,9 @@ IndexIterator &IndexIterator::operator++() {
   page = (current_page_id == INVALID_PAGE_ID)
              ? nullptr
              : reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
+  if (page != nullptr) {
+    buffer_pool_manager->Prefetch(ReadAhead());
+  }
 
   return *this;
 }
@@ -1,4 +1,6 @@
 #include <cstdio>
+#include <cstdlib>
+#include <string>
 
 #include "executor/execute_engine.h"
 #include "glog/logging.h"
@@ -36,8 +38,32 @@ int main(int argc, char **argv) {
   // command buffer
   const int buf_size = 1024;
   char cmd[buf_size];
+  // --replacer=lru|clock|lru-k|arc picks the replacement policy of the buffer pools
+  ReplacerPolicy replacer_policy = ReplacerPolicy::kLRU;
+  const std::string replacer_flag = "--replacer=";
+  // --buffer_pool_size=N sets the number of frames the databases share, SET buffer_pool_size = N changes it later
+  uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE;
+  const std::string buffer_pool_size_flag = "--buffer_pool_size=";
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool valid;
+    if (arg.compare(0, replacer_flag.size(), replacer_flag) == 0) {
+      valid = Replacer::ParsePolicy(arg.substr(replacer_flag.size()), &replacer_policy);
+    } else if (arg.compare(0, buffer_pool_size_flag.size(), buffer_pool_size_flag) == 0) {
+      char *end;
+      unsigned long size = strtoul(arg.c_str() + buffer_pool_size_flag.size(), &end, 10);
+      valid = *end == '\0' && size > 0 && size <= UINT32_MAX;
+      buffer_pool_size = static_cast<uint32_t>(size);
+    } else {
+      valid = false;
+    }
+    if (!valid) {
+      printf("Usage: %s [--replacer=lru|clock|lru-k|arc] [--buffer_pool_size=N]\n", argv[0]);
+      return 1;
+    }
+  }
   // executor engine
-  ExecuteEngine engine;
+  ExecuteEngine engine(buffer_pool_size, replacer_policy);
   // for print syntax tree
   TreeFileManagers syntax_tree_file_mgr("syntax_tree_");
   uint32_t syntax_tree_id = 0;
@@ -9,14 +9,15 @@ static constexpr uint32_t INVALID_PAGE = 0xFFFFFFFF;  // 使用最大的32位无
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
-  if (next_free_page_ == INVALID_PAGE) {
+  if (page_allocated_ >= GetMaxSupportedSize()) {
     return false;
   }
-  if (page_allocated_ == GetMaxSupportedSize()) {
-    LOG(ERROR) << "No more space in the bitmap page";
+  // next_free_page_ 只是搜索起点的提示，不保证该页一定空闲
+  uint32_t hint = next_free_page_ < GetMaxSupportedSize() ? next_free_page_ : 0;
+  if (!FindFreePage(hint, page_offset)) {
+    LOG(ERROR) << "Bitmap page is inconsistent with its allocated count";
     return false;
   }
-  page_offset = next_free_page_;  // 分配下一个可用的页面
 
   /* 更新位图 */
   uint32_t byte_index = page_offset / 8;
@@ -24,21 +25,51 @@ bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
   bytes[byte_index] |= (1 << bit_index);
   page_allocated_++;  // 增加已分配的页面数
 
-  /* 更新下一个可用的页面 */
-  uint32_t start = next_free_page_;
-  next_free_page_ = (next_free_page_ + 1) % GetMaxSupportedSize();  // 循环使用位图 (circular bitmap)
-  while (next_free_page_ != start) {
-    if (IsPageFree(next_free_page_)) {
-      break;
-    }
-    next_free_page_ = (next_free_page_ + 1) % GetMaxSupportedSize();  // 循环使用位图 (circular bitmap)
-  }
-  if (next_free_page_ == start) {
-    next_free_page_ = INVALID_PAGE;  // 没有可用的页面
+  /* 更新下一个可用页面的提示 (circular bitmap) */
+  if (page_allocated_ == GetMaxSupportedSize()) {
+    next_free_page_ = INVALID_PAGE;
+  } else {
+    next_free_page_ = (page_offset + 1) % GetMaxSupportedSize();
   }
   return true;
 }
 
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocatePages(uint32_t num_pages, uint32_t &page_offset) {
+  if (num_pages == 0 || page_allocated_ + num_pages > GetMaxSupportedSize()) {
+    return false;
+  }
+  uint32_t start = 0;
+  while (start + num_pages <= GetMaxSupportedSize()) {
+    uint32_t run_start;
+    // FindFreePage 会回绕，找到 start 之前的页说明后面已没有空闲页
+    if (!FindFreePage(start, run_start) || run_start < start || run_start + num_pages > GetMaxSupportedSize()) {
+      return false;
+    }
+    uint32_t run_end = run_start + 1;
+    while (run_end < run_start + num_pages && IsPageFree(run_end)) {
+      run_end++;
+    }
+    if (run_end < run_start + num_pages) {
+      // run_end 已被占用，从它之后继续找
+      start = run_end + 1;
+      continue;
+    }
+    for (uint32_t i = run_start; i < run_end; i++) {
+      bytes[i / 8] |= (1 << (i % 8));
+    }
+    page_allocated_ += num_pages;
+    if (page_allocated_ == GetMaxSupportedSize()) {
+      next_free_page_ = INVALID_PAGE;
+    } else if (next_free_page_ >= run_start && next_free_page_ < run_end) {
+      next_free_page_ = run_end % GetMaxSupportedSize();
+    }
+    page_offset = run_start;
+    return true;
+  }
+  return false;
+}
+
 /**
  * TODO: Student Implement
  */
@@ -80,6 +111,31 @@ bool BitmapPage<PageSize>::IsPageFree(uint32_t page_offset) const {
 
 template <size_t PageSize>
 bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const {
+  return !(bytes[byte_index] & (1 << bit_index));
+}
+
+template <size_t PageSize>
+bool BitmapPage<PageSize>::FindFreePage(uint32_t start, uint32_t &page_offset) const {
+  static_assert(MAX_CHARS % sizeof(uint64_t) == 0, "Bitmap must consist of whole 64-bit words.");
+  constexpr uint32_t num_words = MAX_CHARS / sizeof(uint64_t);
+  // 按 64 位字扫描，起始字中低于 start 的位视为已占用，最后再回绕检查这些位
+  uint32_t start_word = start / 64;
+  uint64_t low_mask = (uint64_t{1} << (start % 64)) - 1;
+  for (uint32_t i = 0; i <= num_words; i++) {
+    uint32_t word_index = (start_word + i) % num_words;
+    uint64_t word;
+    memcpy(&word, bytes + word_index * sizeof(uint64_t), sizeof(uint64_t));
+    if (i == 0) {
+      word |= low_mask;
+    } else if (i == num_words) {
+      word |= ~low_mask;
+    }
+    if (word != ~uint64_t{0}) {
+      // bit i of the little-endian word is page (word_index * 64 + i)
+      page_offset = word_index * 64 + __builtin_ctzll(~word);
+      return true;
+    }
+  }
   return false;
 }
 
@@ -95,4 +151,10 @@ template class BitmapPage<1024>;
 
 template class BitmapPage<2048>;
 
-template class BitmapPage<4096>;
\ No newline at end of file
+template class BitmapPage<4096>;
+
+template class BitmapPage<8192>;
+
+template class BitmapPage<16384>;
+
+template class BitmapPage<32768>;
@@ -364,23 +364,24 @@ static void yy_fatal_error(yyconst char msg[]);
   *yy_cp = '\0';                       \
   (yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 56
-#define YY_END_OF_BUFFER 57
+#define YY_NUM_RULES 60
+#define YY_END_OF_BUFFER 61
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info {
   flex_int32_t yy_verify;
   flex_int32_t yy_nxt;
 };
-static yyconst flex_int16_t yy_accept[175] = {
-    0,  41, 41, 57, 55, 54, 54, 55, 49, 52, 53, 47, 46, 41, 55, 41, 48, 50, 42, 51, 39, 39, 39, 39, 39, 39,
-    39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 0,  1,  0,  0,  41, 40, 44, 43, 45, 39, 39, 39, 39,
-    39, 39, 39, 39, 39, 39, 39, 39, 39, 37, 39, 39, 39, 22, 35, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-    34, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 32, 29, 36, 39, 39, 39, 39, 39, 26, 39,
+static yyconst flex_int16_t yy_accept[193] = {
+    0,  45, 45, 61, 59, 58, 58, 59, 53, 56, 57, 51, 50, 45, 59, 52, 54, 46, 55, 43, 43, 43, 43, 43, 43, 43,
+    43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 0,  1,  0,  0,  45, 44, 48, 47, 49, 43, 43, 43, 43, 43,
+    43, 43, 43, 43, 43, 43, 43, 43, 43, 37, 43, 43, 43, 22, 35, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+    43, 43, 34, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 32, 29, 36, 43, 43, 43, 43,
 
-    39, 39, 39, 14, 39, 39, 39, 39, 31, 39, 39, 39, 39, 3,  39, 39, 23, 39, 39, 25, 38, 39, 11, 39, 39, 13,
-    39, 39, 39, 39, 39, 39, 8,  39, 39, 39, 39, 39, 33, 20, 39, 39, 39, 39, 18, 39, 39, 15, 39, 24, 9,  2,
-    39, 6,  39, 39, 5,  39, 39, 4,  19, 30, 7,  27, 39, 39, 21, 28, 39, 16, 12, 10, 17, 0};
+    43, 43, 26, 43, 43, 43, 43, 43, 14, 43, 43, 43, 43, 43, 31, 43, 43, 43, 43, 43, 3,  43, 43, 23, 43, 43,
+    25, 38, 42, 43, 11, 43, 43, 13, 43, 43, 43, 43, 43, 43, 43, 41, 8,  43, 43, 43, 43, 43, 43, 33, 20, 43,
+    43, 43, 43, 43, 18, 43, 43, 15, 43, 24, 43, 9,  2,  43, 6,  43, 43, 5,  43, 43, 4,  39, 19, 30, 7,  27,
+    43, 43, 43, 21, 28, 43, 43, 16, 12, 10, 43, 17, 40, 0};
 
 static yyconst flex_int32_t yy_ec[256] = {
     0,  1,  1,  1,  1,  1,  1,  1,  1,  2,  3,  2,  2,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
@@ -396,69 +397,81 @@ static yyconst flex_int32_t yy_ec[256] = {
     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1};
 
-static yyconst flex_int32_t yy_meta[43] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 2, 1, 2, 2, 2,
-                                           2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
-
-static yyconst flex_int16_t yy_base[177] = {
-    0,   0,   0,   188, 189, 189, 189, 39,  189, 189, 189, 189, 189, 33,  175, 35,  189, 33,  189, 171, 0,
-    154, 161, 24,  32,  142, 23,  29,  159, 30,  35,  146, 142, 147, 38,  159, 38,  158, 150, 59,  189, 172,
-    162, 42,  161, 189, 189, 189, 0,   150, 146, 151, 139, 145, 130, 137, 133, 141, 131, 130, 50,  0,   119,
-    123, 130, 0,   0,   131, 130, 127, 44,  123, 134, 126, 130, 52,  122, 127, 0,   122, 113, 117, 127, 126,
-    121, 110, 121, 122, 110, 116, 115, 105, 0,   0,   107, 105, 97,  104, 109, 0,   91,
-
-    101, 95,  109, 0,   96,  88,  90,  93,  0,   96,  85,  101, 83,  0,   95,  81,  0,   76,  81,  0,   0,
-    96,  0,   94,  92,  0,   89,  73,  73,  84,  85,  84,  0,   69,  82,  85,  80,  75,  0,   78,  63,  64,
-    79,  60,  60,  72,  71,  0,   57,  0,   0,   0,   56,  0,   62,  54,  0,   43,  63,  0,   0,   0,   0,
-    0,   60,  59,  0,   0,   52,  42,  0,   0,   0,   189, 87,  74};
-
-static yyconst flex_int16_t yy_def[177] = {
-    0,   174, 1,   174, 174, 174, 174, 175, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 175, 174, 175,
-    174, 174, 174, 174, 174, 174, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-    176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 0,   174, 174};
-
-static yyconst flex_int16_t yy_nxt[232] = {
-    0,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  4,   21,  22,
-    23,  24,  25,  26,  20,  20,  27,  28,  20,  20,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  20,
-    20,  40,  42,  43,  42,  43,  45,  46,  51,  54,  58,  42,  43,  55,  52,  41,  59,  53,  60,  70,  63,
-    40,  71,  61,  65,  56,  64,  73,  66,  74,  89,  98,  75,  104, 48,  41,  173, 105, 172, 99,  171, 170,
-    169, 168, 90,  91,  39,  39,  167, 166, 165, 164, 163, 162, 161, 160, 159, 158, 157,
-
-    156, 155, 154, 153, 152, 151, 150, 149, 148, 147, 146, 145, 144, 143, 142, 141, 140, 139, 138, 137, 136,
-    135, 134, 133, 132, 131, 130, 129, 128, 127, 126, 125, 124, 123, 122, 121, 120, 119, 118, 117, 116, 115,
-    114, 113, 112, 111, 110, 109, 108, 107, 106, 103, 102, 101, 100, 97,  96,  95,  94,  93,  92,  88,  87,
-    86,  85,  84,  83,  82,  81,  80,  79,  78,  44,  44,  174, 77,  76,  72,  69,  68,  67,  62,  57,  50,
-    49,  47,  44,  174, 3,   174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-
-    174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-    174, 174, 174, 174, 174, 174, 174, 174, 174, 174};
-
-static yyconst flex_int16_t yy_chk[232] = {
+static yyconst flex_int32_t yy_meta[43] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                           1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+static yyconst flex_int16_t yy_base[193] = {
+    0,   0,   0,   43,  0,   0,   0,   43,  0,   0,   0,   0,   0,   75,  76,  0,   74,  0,   76,  80,  64,
+    71,  97,  105, 55,  96,  99,  75,  95,  103, 104, 88,  105, 118, 123, 112, 127, 121, 0,   0,   146, 0,
+    0,   0,   0,   0,   0,   0,   114, 130, 128, 135, 125, 133, 120, 130, 128, 138, 130, 131, 143, 0,   124,
+    130, 139, 0,   0,   137, 143, 144, 143, 144, 142, 155, 149, 156, 159, 154, 161, 162, 0,   160, 153, 168,
+    160, 172, 173, 170, 161, 174, 177, 167, 175, 176, 168, 0,   0,   172, 173, 173, 167,
+
+    176, 183, 0,   167, 181, 180, 176, 192, 0,   181, 175, 179, 180, 185, 0,   189, 191, 182, 200, 184, 0,
+    198, 186, 0,   183, 190, 0,   0,   0,   207, 0,   207, 207, 0,   198, 207, 193, 195, 208, 211, 212, 0,
+    0,   203, 200, 215, 220, 217, 214, 0,   219, 206, 209, 226, 209, 219, 212, 226, 227, 0,   215, 0,   220,
+    0,   0,   217, 0,   225, 219, 0,   214, 236, 0,   0,   0,   0,   0,   0,   231, 236, 237, 0,   0,   233,
+    231, 227, 0,   0,   227, 0,   0,   265};
+
+static yyconst flex_int16_t yy_def[193] = {
+    0,  192, 1,   192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  7,   192, 7,   14,
+    13, 14,  192, 192, 192, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19, 19,  19,  19,  19,  19,  19,  0};
+
+static yyconst flex_int16_t yy_nxt[308] = {
+    0,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,  13,  15,  16,  17,  18,  19,  4,   20,  21,
+    22,  23,  24,  25,  19,  19,  26,  27,  19,  19,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  19,
+    19,  192, 38,  38,  38,  39,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  40,  38,
+    38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,  38,
+    38,  38,  41,  42,  43,  44,  45,  46,  47,  48,  50,  49,  57,  47,  62,  47,  47,
+
+    47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,  47,
+    47,  51,  54,  58,  69,  63,  55,  52,  60,  59,  53,  64,  65,  61,  67,  70,  66,  68,  56,  71,  73,
+    74,  72,  75,  77,  78,  76,  192, 38,  79,  80,  81,  82,  84,  85,  86,  83,  87,  88,  89,  90,  91,
+    38,  92,  95,  96,  97,  98,  99,  100, 101, 102, 104, 106, 107, 105, 108, 93,  94,  103, 109, 111, 112,
+    113, 110, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148,
+    149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169,
+    170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190,
+    191, 3,   192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+    192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+
+    192, 192, 192, 192, 192, 192, 192};
+
+static yyconst flex_int16_t yy_chk[308] = {
     0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
     1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
-    1,   7,   13,  13,  15,  15,  17,  17,  23,  24,  26,  43,  43,  24,  23,  7,   26,  23,  27,  34,  29,
-    39,  34,  27,  30,  24,  29,  36,  30,  36,  60,  70,  36,  75,  176, 39,  170, 75,  169, 70,  166, 165,
-    159, 158, 60,  60,  175, 175, 156, 155, 153, 149, 147, 146, 145, 144, 143, 142, 141,
+    1,   3,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,
+    7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,
+    7,   7,   13,  13,  14,  16,  16,  18,  19,  20,  21,  20,  24,  19,  27,  19,  19,
 
-    140, 138, 137, 136, 135, 134, 132, 131, 130, 129, 128, 127, 125, 124, 122, 119, 118, 116, 115, 113, 112,
-    111, 110, 108, 107, 106, 105, 103, 102, 101, 100, 98,  97,  96,  95,  94,  91,  90,  89,  88,  87,  86,
-    85,  84,  83,  82,  81,  80,  79,  77,  76,  74,  73,  72,  71,  69,  68,  67,  64,  63,  62,  59,  58,
-    57,  56,  55,  54,  53,  52,  51,  50,  49,  44,  42,  41,  38,  37,  35,  33,  32,  31,  28,  25,  22,
-    21,  19,  14,  3,   174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
+    19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,  19,
+    19,  22,  23,  25,  31,  28,  23,  22,  26,  25,  22,  28,  29,  26,  30,  32,  29,  30,  23,  33,  34,
+    35,  33,  35,  36,  37,  35,  40,  40,  48,  49,  50,  51,  52,  53,  54,  51,  55,  56,  57,  58,  59,
+    40,  60,  62,  63,  64,  67,  68,  69,  70,  71,  72,  73,  74,  72,  75,  60,  60,  71,  76,  77,  78,
+    79,  76,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,
 
-    174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-    174, 174, 174, 174, 174, 174, 174, 174, 174, 174};
+    97,  98,  99,  100, 101, 102, 104, 105, 106, 107, 108, 110, 111, 112, 113, 114, 116, 117, 118, 119, 120,
+    122, 123, 125, 126, 130, 132, 133, 135, 136, 137, 138, 139, 140, 141, 144, 145, 146, 147, 148, 149, 151,
+    152, 153, 154, 155, 156, 157, 158, 159, 161, 163, 166, 168, 169, 171, 172, 179, 180, 181, 184, 185, 186,
+    189, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+    192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+
+    192, 192, 192, 192, 192, 192, 192};
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[57] = {
-    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+static yyconst flex_int32_t yy_rule_can_match_eol[61] = {
+    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
 };
 
 static yy_state_type yy_last_accepting_state;
@@ -700,11 +713,11 @@ YY_DECL {
       }
       while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
         yy_current_state = (int)yy_def[yy_current_state];
-        if (yy_current_state >= 175) yy_c = yy_meta[(unsigned int)yy_c];
+        if (yy_current_state >= 193) yy_c = yy_meta[(unsigned int)yy_c];
       }
       yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int)yy_c];
       ++yy_cp;
-    } while (yy_base[yy_current_state] != 189);
+    } while (yy_base[yy_current_state] != 265);
 
   yy_find_action:
     yy_act = yy_accept[yy_current_state];
@@ -1041,147 +1054,183 @@ YY_DECL {
         YY_BREAK
       case 39:
         YY_RULE_SETUP
-#line 208 "minisql.l"
+#line 209 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-          return IDENTIFIER;
+          return SHRINK;
         }
         YY_BREAK
       case 40:
         YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 215 "minisql.l"
+        {
+          MinisqlParserMovePos(yylineno, yytext);
+          yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+          return CHECKPOINT;
+        }
+        YY_BREAK
+      case 41:
+        YY_RULE_SETUP
+#line 221 "minisql.l"
+        {
+          MinisqlParserMovePos(yylineno, yytext);
+          yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+          return ALTER;
+        }
+        YY_BREAK
+      case 42:
+        YY_RULE_SETUP
+#line 227 "minisql.l"
+        {
+          MinisqlParserMovePos(yylineno, yytext);
+          yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+          return POOL;
+        }
+        YY_BREAK
+      case 43:
+        YY_RULE_SETUP
+#line 233 "minisql.l"
+        {
+          MinisqlParserMovePos(yylineno, yytext);
+          yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+          return IDENTIFIER;
+        }
+        YY_BREAK
+      case 44:
+        YY_RULE_SETUP
+#line 239 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
           return NUMBER;
         }
         YY_BREAK
-      case 41:
+      case 45:
         YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 245 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
           return NUMBER;
         }
         YY_BREAK
-      case 42:
+      case 46:
         YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 251 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return EQ;
         }
         YY_BREAK
-      case 43:
+      case 47:
         YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 256 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return NE;
         }
         YY_BREAK
-      case 44:
+      case 48:
         YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 261 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return LE;
         }
         YY_BREAK
-      case 45:
+      case 49:
         YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 266 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return GE;
         }
         YY_BREAK
-      case 46:
+      case 50:
         YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 271 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return (',');
         }
         YY_BREAK
-      case 47:
+      case 51:
         YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 276 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return ('*');
         }
         YY_BREAK
-      case 48:
+      case 52:
         YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 281 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return (';');
         }
         YY_BREAK
-      case 49:
+      case 53:
         YY_RULE_SETUP
-#line 261 "minisql.l"
+#line 286 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return ('\'');
         }
         YY_BREAK
-      case 50:
+      case 54:
         YY_RULE_SETUP
-#line 266 "minisql.l"
+#line 291 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return ('<');
         }
         YY_BREAK
-      case 51:
+      case 55:
         YY_RULE_SETUP
-#line 271 "minisql.l"
+#line 296 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return ('>');
         }
         YY_BREAK
-      case 52:
+      case 56:
         YY_RULE_SETUP
-#line 276 "minisql.l"
+#line 301 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return ('(');
         }
         YY_BREAK
-      case 53:
+      case 57:
         YY_RULE_SETUP
-#line 281 "minisql.l"
+#line 306 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
           return (')');
         }
         YY_BREAK
-      case 54:
-        /* rule 54 can match eol */
+      case 58:
+        /* rule 58 can match eol */
         YY_RULE_SETUP
-#line 286 "minisql.l"
+#line 311 "minisql.l"
         {
           MinisqlParserMovePos(yylineno, yytext);
         }
         YY_BREAK
-      case 55:
+      case 59:
         YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 315 "minisql.l"
         {
           char str[128] = {0};
           sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
           MinisqlParserSetError(str);
         }
         YY_BREAK
-      case 56:
+      case 60:
         YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 321 "minisql.l"
         ECHO;
         YY_BREAK
 #line 1314 "../../parser/minisql_lex.c"
@@ -1437,7 +1486,7 @@ static yy_state_type yy_get_previous_state(void) {
     }
     while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
       yy_current_state = (int)yy_def[yy_current_state];
-      if (yy_current_state >= 175) yy_c = yy_meta[(unsigned int)yy_c];
+      if (yy_current_state >= 193) yy_c = yy_meta[(unsigned int)yy_c];
     }
     yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int)yy_c];
   }
@@ -1461,10 +1510,10 @@ static yy_state_type yy_try_NUL_trans(yy_state_type yy_current_state) {
   }
   while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
     yy_current_state = (int)yy_def[yy_current_state];
-    if (yy_current_state >= 175) yy_c = yy_meta[(unsigned int)yy_c];
+    if (yy_current_state >= 193) yy_c = yy_meta[(unsigned int)yy_c];
   }
   yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int)yy_c];
-  yy_is_jam = (yy_current_state == 174);
+  yy_is_jam = (yy_current_state == 192);
 
   return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2039,6 +2088,6 @@ void yyfree(void *ptr) { free((char *)ptr); /* see yyrealloc() for (char *) cast
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 321 "minisql.l"
 
 int yywrap() { return 1; }
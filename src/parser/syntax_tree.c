@@ -171,6 +171,16 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeShrinkDB:
+      return "kNodeShrinkDB";
+    case kNodeSetVariable:
+      return "kNodeSetVariable";
+    case kNodeCheckpoint:
+      return "kNodeCheckpoint";
+    case kNodeAlterTable:
+      return "kNodeAlterTable";
+    case kNodeAlterIndex:
+      return "kNodeAlterIndex";
     default:
       return "error type";
   }
@@ -0,0 +1,300 @@
+#include "storage/async_io.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "glog/logging.h"
+
+/**
+ * Blocking read of len bytes at offset, the part beyond the end of file is zero filled
+ */
+static bool ReadFully(int fd, char *buf, size_t len, size_t offset) {
+  size_t read_count = 0;
+  while (read_count < len) {
+    ssize_t ret = pread(fd, buf + read_count, len - read_count, offset + read_count);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while reading: " << strerror(errno);
+      return false;
+    }
+    if (ret == 0) {
+      memset(buf + read_count, 0, len - read_count);
+      break;
+    }
+    read_count += ret;
+  }
+  return true;
+}
+
+/**
+ * Blocking write of len bytes at offset
+ */
+static bool WriteFully(int fd, const char *buf, size_t len, size_t offset) {
+  size_t write_count = 0;
+  while (write_count < len) {
+    ssize_t ret = pwrite(fd, buf + write_count, len - write_count, offset + write_count);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while writing: " << strerror(errno);
+      return false;
+    }
+    write_count += ret;
+  }
+  return true;
+}
+
+std::unique_ptr<AsyncIOEngine> AsyncIOEngine::Create(size_t queue_depth) {
+#ifdef MINISQL_HAVE_IO_URING
+  auto engine = IOUringEngine::Create(queue_depth);
+  if (engine != nullptr) {
+    return engine;
+  }
+  LOG(WARNING) << "io_uring is not available, falling back to the I/O thread pool.";
+#endif
+  return std::make_unique<ThreadPoolIOEngine>(std::min<size_t>(queue_depth, 8));
+}
+
+/*****************************************************************************
+ * ThreadPoolIOEngine
+ *****************************************************************************/
+
+ThreadPoolIOEngine::ThreadPoolIOEngine(size_t num_threads) {
+  for (size_t i = 0; i < std::max<size_t>(num_threads, 1); i++) {
+    workers_.emplace_back(&ThreadPoolIOEngine::WorkerLoop, this);
+  }
+}
+
+ThreadPoolIOEngine::~ThreadPoolIOEngine() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+IOHandle ThreadPoolIOEngine::Read(int fd, char *page_data, size_t offset) {
+  return Submit([=]() { return ReadFully(fd, page_data, PAGE_SIZE, offset); });
+}
+
+IOHandle ThreadPoolIOEngine::Write(int fd, const char *page_data, size_t offset) {
+  return Submit([=]() { return WriteFully(fd, page_data, PAGE_SIZE, offset); });
+}
+
+IOHandle ThreadPoolIOEngine::Submit(std::function<bool()> task) {
+  std::packaged_task<bool()> packaged_task(std::move(task));
+  IOHandle handle = packaged_task.get_future();
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    tasks_.emplace_back(std::move(packaged_task));
+  }
+  cv_.notify_one();
+  return handle;
+}
+
+void ThreadPoolIOEngine::WorkerLoop() {
+  while (true) {
+    std::packaged_task<bool()> task;
+    {
+      std::unique_lock<std::mutex> lock(latch_);
+      cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      // queued requests are still served after stop
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+#ifdef MINISQL_HAVE_IO_URING
+/*****************************************************************************
+ * IOUringEngine
+ *****************************************************************************/
+
+struct IOUringEngine::Request {
+  std::promise<bool> promise_;
+  int fd_;
+  char *buf_;
+  size_t offset_;
+  bool is_write_;
+};
+
+std::unique_ptr<IOUringEngine> IOUringEngine::Create(size_t queue_depth) {
+  std::unique_ptr<IOUringEngine> engine(new IOUringEngine());
+  if (!engine->Setup(queue_depth)) {
+    return nullptr;
+  }
+  return engine;
+}
+
+bool IOUringEngine::Setup(size_t queue_depth) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth), &params));
+  if (fd < 0) {
+    return false;
+  }
+  ring_fd_ = fd;
+  num_entries_ = params.sq_entries;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  void *ptr = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+  sq_ring_ = ptr;
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    ptr = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ptr == MAP_FAILED) {
+      return false;
+    }
+    cq_ring_ = ptr;
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  ptr = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+  sqes_ = reinterpret_cast<struct io_uring_sqe *>(ptr);
+
+  auto *sq = reinterpret_cast<char *>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  auto *cq = reinterpret_cast<char *>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+
+  reaper_ = std::thread(&IOUringEngine::ReapLoop, this);
+  return true;
+}
+
+IOUringEngine::~IOUringEngine() {
+  if (reaper_.joinable()) {
+    // wait for outstanding requests, then wake the reaper up with a nop that carries no request
+    {
+      std::unique_lock<std::mutex> lock(submit_latch_);
+      submit_cv_.wait(lock, [this]() { return in_flight_ == 0; });
+    }
+    Submit(IORING_OP_NOP, -1, nullptr, 0, nullptr);
+    reaper_.join();
+  }
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+  }
+}
+
+IOHandle IOUringEngine::Read(int fd, char *page_data, size_t offset) {
+  auto *request = new Request{std::promise<bool>(), fd, page_data, offset, false};
+  IOHandle handle = request->promise_.get_future();
+  Submit(IORING_OP_READ, fd, page_data, offset, request);
+  return handle;
+}
+
+IOHandle IOUringEngine::Write(int fd, const char *page_data, size_t offset) {
+  auto *request = new Request{std::promise<bool>(), fd, const_cast<char *>(page_data), offset, true};
+  IOHandle handle = request->promise_.get_future();
+  Submit(IORING_OP_WRITE, fd, const_cast<char *>(page_data), offset, request);
+  return handle;
+}
+
+void IOUringEngine::Submit(uint8_t opcode, int fd, void *buf, size_t offset, Request *request) {
+  std::unique_lock<std::mutex> lock(submit_latch_);
+  submit_cv_.wait(lock, [this]() { return in_flight_ < num_entries_; });
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & *sq_mask_;
+  struct io_uring_sqe *sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(buf);
+  sqe->len = buf == nullptr ? 0 : PAGE_SIZE;
+  sqe->off = offset;
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+  sq_array_[index] = index;
+  // the kernel must see the sqe before the new tail
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  in_flight_++;
+  int ret;
+  do {
+    ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0));
+  } while (ret < 0 && errno == EINTR);
+  if (ret < 0) {
+    // the sqe stays in the ring and goes out with the next submission
+    LOG(ERROR) << "io_uring_enter failed: " << strerror(errno);
+  }
+}
+
+void IOUringEngine::ReapLoop() {
+  while (true) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+      if (ret < 0 && errno != EINTR) {
+        LOG(ERROR) << "io_uring_enter failed: " << strerror(errno);
+      }
+      continue;
+    }
+    struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+    auto *request = reinterpret_cast<Request *>(cqe->user_data);
+    int res = cqe->res;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    if (request == nullptr) {
+      return;
+    }
+    // short transfers and retryable errors are finished with blocking calls
+    bool success;
+    size_t done = res > 0 ? res : 0;
+    if (res < 0 && res != -EAGAIN && res != -EINTR) {
+      LOG(ERROR) << "Asynchronous " << (request->is_write_ ? "write" : "read") << " failed: " << strerror(-res);
+      success = false;
+    } else if (done < PAGE_SIZE) {
+      success = request->is_write_
+                    ? WriteFully(request->fd_, request->buf_ + done, PAGE_SIZE - done, request->offset_ + done)
+                    : ReadFully(request->fd_, request->buf_ + done, PAGE_SIZE - done, request->offset_ + done);
+    } else {
+      success = true;
+    }
+    request->promise_.set_value(success);
+    delete request;
+    {
+      std::scoped_lock<std::mutex> lock(submit_latch_);
+      in_flight_--;
+    }
+    submit_cv_.notify_all();
+  }
+}
+#endif
@@ -1,38 +1,240 @@
 #include "storage/disk_manager.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <new>
 #include <stdexcept>
 
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
 
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
+DiskManager::DiskManager(const std::string &db_file, DiskIOMode io_mode, DurabilityMode durability)
+    : io_mode_(io_mode), durability_(durability), file_name_(db_file) {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    std::filesystem::path p = db_file;
-    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
+  if (durability_ == DurabilityMode::kGroupCommit && !IsPositional()) {
+    LOG(WARNING) << "Group commit needs positional I/O, falling back to write-through.";
+    durability_ = DurabilityMode::kWriteThrough;
+  }
+  std::filesystem::path p = db_file;
+  if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+  if (IsPositional()) {
+    db_fd_ = open(db_file.c_str(), O_RDWR | O_CREAT | (io_mode_ == DiskIOMode::kDirect ? O_DIRECT : 0), 0644);
+    if (db_fd_ < 0 && io_mode_ == DiskIOMode::kDirect && errno == EINVAL) {
+      // e.g. tmpfs does not support O_DIRECT
+      LOG(WARNING) << "O_DIRECT is not supported for " << db_file << ", falling back to buffered I/O.";
+      io_mode_ = DiskIOMode::kPositional;
+      db_fd_ = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);
+    }
+    if (db_fd_ < 0) {
+      throw std::exception();
+    }
+    struct stat stat_buf;
+    file_size_ = fstat(db_fd_, &stat_buf) == 0 ? stat_buf.st_size : 0;
+    reserved_size_ = file_size_;
+  } else if (io_mode_ == DiskIOMode::kMmapReadOnly) {
+    // a read-only db must already exist, it is never created here
+    db_fd_ = open(db_file.c_str(), O_RDONLY);
+    if (db_fd_ < 0) {
+      throw std::exception();
+    }
+    struct stat stat_buf;
+    file_size_ = fstat(db_fd_, &stat_buf) == 0 ? stat_buf.st_size : 0;
+    if (file_size_ > 0) {
+      void *ptr = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, db_fd_, 0);
+      if (ptr == MAP_FAILED) {
+        close(db_fd_);
+        throw std::exception();
+      }
+      mapping_ = reinterpret_cast<char *>(ptr);
+    }
+  } else {
     db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
+    // directory or file does not exist
     if (!db_io_.is_open()) {
-      throw std::exception();
+      db_io_.clear();
+      // create a new file
+      db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
+      db_io_.close();
+      // reopen with original mode
+      db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
+      if (!db_io_.is_open()) {
+        throw std::exception();
+      }
     }
   }
   ReadPhysicalPage(META_PAGE_ID, meta_data_);
+  // load directory pages and bitmap pages of all extents
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  for (uint32_t i = 0; i < GetDirectoryNums(meta_page->GetExtentNums()); i++) {
+    directories_.emplace_back(AllocateAlignedPages(1));
+    directory_dirty_.push_back(false);
+    ReadPhysicalPage(GetDirectoryPageId(i), directories_[i].get());
+  }
+  for (uint32_t i = 0; i < meta_page->GetExtentNums(); i++) {
+    bitmaps_.emplace_back(AllocateAlignedPages(1));
+    bitmap_dirty_.push_back(false);
+    ReadPhysicalPage(GetBitmapPageId(i), bitmaps_[i].get());
+    SetExtentFree(i, ExtentUsedPage(i) < BITMAP_SIZE);
+  }
+}
+
+void DiskManager::Checkpoint() {
+  if (IsReadOnly()) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(bitmap_latch_);
+  // the pages reserved but not handed out yet are written back as free, on a copy of the page holding them
+  AlignedPageBuffer image(AllocateAlignedPages(1));
+  for (size_t i = 0; i < bitmaps_.size(); i++) {
+    if (!bitmap_dirty_[i]) {
+      continue;
+    }
+    const char *data = bitmaps_[i].get();
+    auto run = reserved_pages_.lower_bound(static_cast<page_id_t>(i * BITMAP_SIZE));
+    if (run != reserved_pages_.end() && run->first / BITMAP_SIZE == i) {
+      memcpy(image.get(), data, PAGE_SIZE);
+      auto *bitmap = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(image.get());
+      for (; run != reserved_pages_.end() && run->first / BITMAP_SIZE == i; ++run) {
+        for (page_id_t page_id = run->first; page_id < run->second; page_id++) {
+          bitmap->DeAllocatePage(page_id % BITMAP_SIZE);
+        }
+      }
+      data = image.get();
+    }
+    WritePhysicalPage(GetBitmapPageId(i), data);
+    bitmap_dirty_[i] = false;
+  }
+  for (size_t i = 0; i < directories_.size(); i++) {
+    if (!directory_dirty_[i]) {
+      continue;
+    }
+    memcpy(image.get(), directories_[i].get(), PAGE_SIZE);
+    auto *directory = reinterpret_cast<ExtentDirectoryPage *>(image.get());
+    for (auto &run : reserved_pages_) {
+      uint32_t extent_id = run.first / BITMAP_SIZE;
+      if (extent_id >= META_EXTENT_NUM && (extent_id - META_EXTENT_NUM) / DIRECTORY_EXTENT_NUM == i) {
+        directory->extent_used_page_[(extent_id - META_EXTENT_NUM) % DIRECTORY_EXTENT_NUM] -= run.second - run.first;
+      }
+    }
+    WritePhysicalPage(GetDirectoryPageId(i), image.get());
+    directory_dirty_[i] = false;
+  }
+  WriteMetaPage();
+}
+
+void DiskManager::Sync() {
+  if (IsReadOnly()) {
+    return;
+  }
+  std::scoped_lock<std::mutex> sync_lock(sync_latch_);
+  if (!IsPositional()) {
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+    db_io_.flush();
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(pending_latch_);
+    flushing_writes_.swap(pending_writes_);
+  }
+  // issue one pwritev per run of physically contiguous pages
+  std::vector<struct iovec> iov;
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  page_id_t next_page_id = INVALID_PAGE_ID;
+  for (auto &write : flushing_writes_) {
+    if (write.first != next_page_id && !iov.empty()) {
+      WritePhysicalPages(first_page_id, iov);
+      iov.clear();
+    }
+    if (iov.empty()) {
+      first_page_id = write.first;
+    }
+    iov.push_back({write.second.get(), PAGE_SIZE});
+    next_page_id = write.first + 1;
+  }
+  if (!iov.empty()) {
+    WritePhysicalPages(first_page_id, iov);
+  }
+  {
+    std::scoped_lock<std::mutex> lock(pending_latch_);
+    flushing_writes_.clear();
+  }
+  if (fdatasync(db_fd_) != 0) {
+    LOG(ERROR) << "Failed to sync db file: " << strerror(errno);
+  }
+}
+
+uint32_t DiskManager::Shrink() {
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot shrink a read-only db file.";
+    return 0;
+  }
+  std::unique_lock<std::shared_mutex> lock(bitmap_latch_);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t &num_extents = meta_page->num_extents_;
+  uint32_t released = 0;
+  while (num_extents > 0 && ExtentUsedPage(num_extents - 1) == 0) {
+    num_extents--;
+    bitmaps_.pop_back();
+    bitmap_dirty_.pop_back();
+    SetExtentFree(num_extents, false);
+    released++;
+  }
+  directories_.resize(GetDirectoryNums(num_extents));
+  directory_dirty_.resize(directories_.size());
+  if (released == 0) {
+    return 0;
+  }
+  // queued writes must not extend the file again after it is truncated
+  Sync();
+  // everything after the last page of the last remaining extent is free
+  size_t new_size = num_extents == 0
+                        ? PAGE_SIZE
+                        : (static_cast<size_t>(GetBitmapPageId(num_extents - 1)) + 1 + BITMAP_SIZE) * PAGE_SIZE;
+  if (IsPositional()) {
+    // also drops the space reserved beyond the end of file
+    if (new_size <= file_size_.load() && ftruncate(db_fd_, new_size) != 0) {
+      LOG(ERROR) << "Failed to truncate db file: " << strerror(errno);
+    } else {
+      file_size_ = std::min(file_size_.load(), new_size);
+      reserved_size_ = std::min(reserved_size_, new_size);
+    }
+  } else {
+    std::scoped_lock<std::recursive_mutex> io_lock(db_io_latch_);
+    db_io_.flush();
+    if (new_size < GetFileSize(file_name_)) {
+      std::filesystem::resize_file(file_name_, new_size);
+    }
+  }
+  WriteMetaPage();
+  return released;
 }
 
 void DiskManager::Close() {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  WritePhysicalPage(META_PAGE_ID, meta_data_);
   if (!closed) {
-    db_io_.close();
+    Checkpoint();
+    Sync();
+    // waits for the requests still in flight
+    io_engine_.reset();
+    if (mapping_ != nullptr) {
+      munmap(mapping_, file_size_);
+      mapping_ = nullptr;
+    }
+    if (db_fd_ >= 0) {
+      close(db_fd_);
+      db_fd_ = -1;
+    } else {
+      db_io_.close();
+    }
     closed = true;
   }
 }
@@ -53,87 +255,462 @@ void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
   WritePhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
+void DiskManager::WritePages(std::vector<std::pair<page_id_t, const char *>> pages) {
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot write a read-only db file.";
+    return;
+  }
+  for (auto &page : pages) {
+    ASSERT(page.first >= 0, "Invalid page id.");
+    page.first = MapPageId(page.first);
+  }
+  std::sort(pages.begin(), pages.end());
+  // the fstream backend and queued writes go through WritePhysicalPage, the queue is coalesced by Sync() anyway
+  bool vectored = IsPositional() && durability_ == DurabilityMode::kWriteThrough;
+  std::vector<struct iovec> iov;
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  for (auto &page : pages) {
+    if (!vectored || NeedsBounce(page.second)) {
+      WritePhysicalPage(page.first, page.second);
+      continue;
+    }
+    if (!iov.empty() && page.first != first_page_id + static_cast<page_id_t>(iov.size())) {
+      WritePhysicalPages(first_page_id, iov);
+      iov.clear();
+    }
+    if (iov.empty()) {
+      first_page_id = page.first;
+    }
+    iov.push_back({const_cast<char *>(page.second), PAGE_SIZE});
+  }
+  if (!iov.empty()) {
+    WritePhysicalPages(first_page_id, iov);
+  }
+}
+
+/**
+ * @return a handle that has already completed with the given result
+ */
+static IOHandle CompletedHandle(bool success) {
+  std::promise<bool> promise;
+  promise.set_value(success);
+  return promise.get_future();
+}
+
+IOHandle DiskManager::ReadPageAsync(page_id_t logical_page_id, char *page_data) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  if (IsPageFree(logical_page_id)) {
+    LOG(WARNING) << "Attempting to read free page.";
+  }
+  page_id_t physical_page_id = MapPageId(logical_page_id);
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
+  // the fstream backend cannot serve concurrent requests
+  if (!IsPositional() || NeedsBounce(page_data)) {
+    ReadPhysicalPage(physical_page_id, page_data);
+    return CompletedHandle(true);
+  }
+  // queued pages and pages beyond the end of file need no disk access
+  if (durability_ == DurabilityMode::kGroupCommit && ReadPendingPage(physical_page_id, page_data)) {
+    return CompletedHandle(true);
+  }
+  if (offset >= file_size_.load(std::memory_order_acquire)) {
+    memset(page_data, 0, PAGE_SIZE);
+    return CompletedHandle(true);
+  }
+  return GetIOEngine()->Read(db_fd_, page_data, offset);
+}
+
+IOHandle DiskManager::WritePageAsync(page_id_t logical_page_id, const char *page_data) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  if (IsPageFree(logical_page_id)) {
+    LOG(WARNING) << "Attempting to write free page.";
+  }
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot write page " << logical_page_id << " of a read-only db file.";
+    return CompletedHandle(false);
+  }
+  page_id_t physical_page_id = MapPageId(logical_page_id);
+  if (!IsPositional() || durability_ == DurabilityMode::kGroupCommit || NeedsBounce(page_data)) {
+    WritePhysicalPage(physical_page_id, page_data);
+    return CompletedHandle(true);
+  }
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
+  GrowFileSize(offset + PAGE_SIZE);
+  return GetIOEngine()->Write(db_fd_, page_data, offset);
+}
+
+char *DiskManager::AllocateAlignedPages(size_t num_pages) {
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, PAGE_SIZE, num_pages * PAGE_SIZE) != 0) {
+    throw std::bad_alloc();
+  }
+  memset(ptr, 0, num_pages * PAGE_SIZE);
+  return reinterpret_cast<char *>(ptr);
+}
+
+AsyncIOEngine *DiskManager::GetIOEngine() {
+  std::call_once(io_engine_once_, [this]() { io_engine_ = AsyncIOEngine::Create(ASYNC_IO_QUEUE_DEPTH); });
+  return io_engine_.get();
+}
+
+void DiskManager::GrowFileSize(size_t end) {
+  size_t file_size = file_size_.load(std::memory_order_relaxed);
+  while (file_size < end && !file_size_.compare_exchange_weak(file_size, end, std::memory_order_release)) {
+  }
+}
+
 /**
  * TODO: Student Implement
  */
 page_id_t DiskManager::AllocatePage() {
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot allocate page in a read-only db file.";
+    return INVALID_PAGE_ID;
+  }
+  std::unique_lock<std::shared_mutex> lock(bitmap_latch_);
   DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
   uint32_t &num_extents = meta_page->num_extents_;
-  if (num_extents == 0 || meta_page->GetExtentUsedPage(num_extents - 1) == BITMAP_SIZE) {
-    // 开辟新的 extent
-    num_extents++;
-  }
-  if (num_extents > (PAGE_SIZE - 8) / 4) {
+  // 优先复用前面 extent 中被释放的页
+  uint32_t extent_id = FindFreeExtent(num_extents);
+  // 开辟新的 extent，位图页只在内存中创建，检查点时再写回
+  if (extent_id == num_extents && !AddExtent()) {
     LOG(ERROR) << "No more space for new page.";
     return INVALID_PAGE_ID;
   }
-  /* 在新 extent 中分配页 */
-  char bitmap_page_data[PAGE_SIZE] = {0};  // 存储位图的内存
-  BitmapPage<PAGE_SIZE> *bitmap_page = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_page_data);
-  ReadPhysicalPage((num_extents - 1) * (BITMAP_SIZE + 1) + 1, bitmap_page_data);  // 读取位图页
-
-  uint32_t page_offset;                                   // 分区中的页偏移
-  bool success = bitmap_page->AllocatePage(page_offset);  // 分配页
+  uint32_t page_offset;                                            // 分区中的页偏移
+  bool success = GetBitmap(extent_id)->AllocatePage(page_offset);  // 分配页
   ASSERT(success, "Failed to allocate page.");
-  WritePhysicalPage((num_extents - 1) * (BITMAP_SIZE + 1) + 1, bitmap_page_data);  // 写入位图页
+  bitmap_dirty_[extent_id] = true;
 
   // 更新元数据
   meta_page->num_allocated_pages_++;
-  meta_page->extent_used_page_[num_extents - 1]++;
+  if (AddExtentUsedPage(extent_id, 1) == BITMAP_SIZE) {
+    SetExtentFree(extent_id, false);
+  }
 
-  return (num_extents - 1) * BITMAP_SIZE + page_offset;
+  page_id_t page_id = static_cast<page_id_t>(extent_id * BITMAP_SIZE + page_offset);
+  ReserveFileSpace(page_id);
+  return page_id;
+}
+
+page_id_t DiskManager::AllocateContiguousPages(uint32_t num_pages) {
+  if (num_pages == 0 || num_pages > BITMAP_SIZE || IsReadOnly()) {
+    return INVALID_PAGE_ID;
+  }
+  std::unique_lock<std::shared_mutex> lock(bitmap_latch_);
+  return AllocateRun(num_pages, false);
+}
+
+page_id_t DiskManager::AllocateRun(uint32_t num_pages, bool reserve) {
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t &num_extents = meta_page->num_extents_;
+  // 在已有 extent 中找足够长的连续空闲页，找不到再开辟新的 extent
+  uint32_t extent_id = 0;
+  uint32_t page_offset = 0;
+  for (; extent_id < num_extents; extent_id++) {
+    if (BITMAP_SIZE - ExtentUsedPage(extent_id) >= num_pages &&
+        GetBitmap(extent_id)->AllocatePages(num_pages, page_offset)) {
+      break;
+    }
+  }
+  if (extent_id == num_extents) {
+    if (!AddExtent()) {
+      LOG(ERROR) << "No more space for new pages.";
+      return INVALID_PAGE_ID;
+    }
+    bool success = GetBitmap(extent_id)->AllocatePages(num_pages, page_offset);
+    ASSERT(success, "Failed to allocate pages.");
+  }
+  bitmap_dirty_[extent_id] = true;
+
+  // 更新元数据
+  meta_page->num_allocated_pages_ += num_pages;
+  SetExtentFree(extent_id, AddExtentUsedPage(extent_id, num_pages) < BITMAP_SIZE);
+
+  page_id_t first_page_id = static_cast<page_id_t>(extent_id * BITMAP_SIZE + page_offset);
+  if (reserve) {
+    reserved_pages_.emplace(first_page_id, first_page_id + num_pages);
+  }
+  ReserveFileSpace(first_page_id + num_pages - 1);
+  return first_page_id;
+}
+
+page_id_t DiskManager::AllocatePage(ExtentReservation *reservation) {
+  std::scoped_lock<std::mutex> lock(reservation->latch_);
+  if (reservation->next_page_id_ == reservation->end_page_id_) {
+    // fall back to shorter runs when the file is fragmented
+    if (IsReadOnly()) {
+      return AllocatePage();
+    }
+    std::unique_lock<std::shared_mutex> bitmap_lock(bitmap_latch_);
+    for (uint32_t run_size = std::min<uint32_t>(reservation->run_size_, BITMAP_SIZE); run_size > 1; run_size /= 2) {
+      page_id_t first_page_id = AllocateRun(run_size, true);
+      if (first_page_id != INVALID_PAGE_ID) {
+        reservation->next_page_id_ = first_page_id;
+        reservation->end_page_id_ = first_page_id + run_size;
+        reservation->runs_[first_page_id] = reservation->end_page_id_;
+        break;
+      }
+    }
+    if (reservation->next_page_id_ == reservation->end_page_id_) {
+      bitmap_lock.unlock();
+      return AllocatePage();
+    }
+  }
+  std::unique_lock<std::shared_mutex> bitmap_lock(bitmap_latch_);
+  page_id_t page_id = reservation->next_page_id_++;
+  auto run = reserved_pages_.extract(page_id);
+  ASSERT(!run.empty(), "Reserved page is not recorded.");
+  if (++run.key() < run.mapped()) {
+    reserved_pages_.insert(std::move(run));
+  }
+  // the page is written back as allocated from now on
+  uint32_t extent_id = page_id / BITMAP_SIZE;
+  bitmap_dirty_[extent_id] = true;
+  if (extent_id >= META_EXTENT_NUM) {
+    directory_dirty_[(extent_id - META_EXTENT_NUM) / DIRECTORY_EXTENT_NUM] = true;
+  }
+  return page_id;
+}
+
+void DiskManager::ReleaseReservation(ExtentReservation *reservation) {
+  std::scoped_lock<std::mutex> lock(reservation->latch_);
+  if (reservation->next_page_id_ != reservation->end_page_id_) {
+    std::unique_lock<std::shared_mutex> bitmap_lock(bitmap_latch_);
+    reserved_pages_.erase(reservation->next_page_id_);
+    uint32_t extent_id = reservation->next_page_id_ / BITMAP_SIZE;
+    for (page_id_t page_id = reservation->next_page_id_; page_id < reservation->end_page_id_; page_id++) {
+      bool success = GetBitmap(extent_id)->DeAllocatePage(page_id % BITMAP_SIZE);
+      ASSERT(success, "Failed to deallocate page.");
+    }
+    bitmap_dirty_[extent_id] = true;
+    uint32_t num_pages = reservation->end_page_id_ - reservation->next_page_id_;
+    reinterpret_cast<DiskFileMetaPage *>(meta_data_)->num_allocated_pages_ -= num_pages;
+    AddExtentUsedPage(extent_id, -static_cast<int32_t>(num_pages));
+    SetExtentFree(extent_id, true);
+    // the pages given back may be reserved for another object now
+    auto run = std::prev(reservation->runs_.upper_bound(reservation->next_page_id_));
+    if (run->first == reservation->next_page_id_) {
+      reservation->runs_.erase(run);
+    } else {
+      run->second = reservation->next_page_id_;
+    }
+  }
+  reservation->next_page_id_ = reservation->end_page_id_ = INVALID_PAGE_ID;
+}
+
+page_id_t ExtentReservation::GetRunEnd(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto run = runs_.upper_bound(page_id);
+  if (run == runs_.begin() || page_id >= std::prev(run)->second) {
+    return page_id + 1;
+  }
+  return std::prev(run)->second;
+}
+
+void DiskManager::WriteMetaPage() {
+  alignas(PAGE_SIZE) char image[PAGE_SIZE];
+  memcpy(image, meta_data_, PAGE_SIZE);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(image);
+  // the pages reserved but not handed out yet are counted as free
+  for (auto &run : reserved_pages_) {
+    uint32_t extent_id = run.first / BITMAP_SIZE;
+    meta_page->num_allocated_pages_ -= run.second - run.first;
+    if (extent_id < META_EXTENT_NUM) {
+      meta_page->extent_used_page_[extent_id] -= run.second - run.first;
+    }
+  }
+  WritePhysicalPage(META_PAGE_ID, image);
+}
+
+void DiskManager::ReserveFileSpace(page_id_t logical_page_id) {
+  if (!IsPositional() || !fallocate_supported_) {
+    return;
+  }
+  size_t end = static_cast<size_t>(MapPageId(logical_page_id) + 1) * PAGE_SIZE;
+  if (end <= reserved_size_) {
+    return;
+  }
+  size_t new_reserved_size = (end + FILE_GROWTH_SIZE - 1) / FILE_GROWTH_SIZE * FILE_GROWTH_SIZE;
+  // keep the file size, so that reads beyond the data written so far still need no disk access
+  if (fallocate(db_fd_, FALLOC_FL_KEEP_SIZE, reserved_size_, new_reserved_size - reserved_size_) != 0) {
+    if (errno == EOPNOTSUPP) {
+      fallocate_supported_ = false;
+    } else {
+      LOG(WARNING) << "Failed to reserve disk space: " << strerror(errno);
+    }
+    return;
+  }
+  reserved_size_ = new_reserved_size;
 }
 
 /**
  * TODO: Student Implement
  */
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot deallocate page " << logical_page_id << " of a read-only db file.";
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(bitmap_latch_);
   DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
-  page_id_t bitmap_id = logical_page_id / BITMAP_SIZE * (BITMAP_SIZE + 1) + 1;  // 位图页的物理页号
-  char bitmap_page_data[PAGE_SIZE] = {0};                                       // 存储位图的内存
-  BitmapPage<PAGE_SIZE> *bitmap_page = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_page_data);
-  ReadPhysicalPage(bitmap_id, bitmap_page_data);  // 读取位图页
-
-  uint32_t page_offset = logical_page_id % BITMAP_SIZE;     // 分区中的页偏移
-  bool success = bitmap_page->DeAllocatePage(page_offset);  // 释放页
+  uint32_t extent_id = logical_page_id / BITMAP_SIZE;
+  if (extent_id >= bitmaps_.size()) {
+    LOG(WARNING) << "Deallocating page " << logical_page_id << " out of range.";
+    return;
+  }
+  uint32_t page_offset = logical_page_id % BITMAP_SIZE;               // 分区中的页偏移
+  bool success = GetBitmap(extent_id)->DeAllocatePage(page_offset);  // 释放页
   ASSERT(success, "Failed to deallocate page.");
-  WritePhysicalPage(bitmap_id, bitmap_page_data);  // 写入位图页
+  if (!success) {
+    return;
+  }
+  bitmap_dirty_[extent_id] = true;
 
   // 更新元数据
   meta_page->num_allocated_pages_--;
-  meta_page->extent_used_page_[logical_page_id / BITMAP_SIZE]--;
+  AddExtentUsedPage(extent_id, -1);
+  SetExtentFree(extent_id, true);
 }
 
 /**
  * TODO: Student Implement
  */
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
-  page_id_t bitmap_id = logical_page_id / BITMAP_SIZE * (BITMAP_SIZE + 1) + 1;  // 位图页的物理页号
-  char bitmap_page_data[PAGE_SIZE] = {0};                                       // 存储位图的内存
-  BitmapPage<PAGE_SIZE> *bitmap_page = reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_page_data);
-  ReadPhysicalPage(bitmap_id, bitmap_page_data);  // 读取位图页
-
+  std::shared_lock<std::shared_mutex> lock(bitmap_latch_);
+  uint32_t extent_id = logical_page_id / BITMAP_SIZE;
+  if (extent_id >= bitmaps_.size()) {
+    return true;
+  }
   uint32_t page_offset = logical_page_id % BITMAP_SIZE;  // 分区中的页偏移
-  return bitmap_page->IsPageFree(page_offset);           // 检查页是否空闲
+  return GetBitmap(extent_id)->IsPageFree(page_offset);  // 检查页是否空闲
+}
+
+uint32_t DiskManager::GetExtentUsedPage(uint32_t extent_id) {
+  std::shared_lock<std::shared_mutex> lock(bitmap_latch_);
+  if (extent_id >= bitmaps_.size()) {
+    return 0;
+  }
+  return ExtentUsedPage(extent_id);
+}
+
+uint32_t DiskManager::AddExtentUsedPage(uint32_t extent_id, int32_t delta) {
+  uint32_t &used_page = ExtentUsedPage(extent_id);
+  used_page += delta;
+  if (extent_id >= META_EXTENT_NUM) {
+    directory_dirty_[(extent_id - META_EXTENT_NUM) / DIRECTORY_EXTENT_NUM] = true;
+  }
+  return used_page;
+}
+
+bool DiskManager::AddExtent() {
+  uint32_t &num_extents = reinterpret_cast<DiskFileMetaPage *>(meta_data_)->num_extents_;
+  if (num_extents >= MAX_EXTENT_NUM) {
+    return false;
+  }
+  num_extents++;
+  bitmaps_.emplace_back(AllocateAlignedPages(1));
+  bitmap_dirty_.push_back(true);
+  if (directories_.size() < GetDirectoryNums(num_extents)) {
+    directories_.emplace_back(AllocateAlignedPages(1));
+    directory_dirty_.push_back(true);
+  }
+  SetExtentFree(num_extents - 1, true);
+  return true;
+}
+
+uint32_t DiskManager::FindFreeExtent(uint32_t num_extents) const {
+  for (uint32_t i = 0; i * 64 < num_extents && i < free_extents_.size(); i++) {
+    if (free_extents_[i] != 0) {
+      return std::min(num_extents, i * 64 + __builtin_ctzll(free_extents_[i]));
+    }
+  }
+  return num_extents;
 }
 
 /**
  * TODO: Student Implement
  */
 page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
-  uint32_t num_extents = logical_page_id / BITMAP_SIZE;          // 计算逻辑页所在的 extent 编号
-  uint32_t page_offset = logical_page_id % BITMAP_SIZE;          // 计算逻辑页在 extent 中的偏移量
-  return num_extents * (BITMAP_SIZE + 1) + 1 + page_offset + 1;  // 加上 disk_file_meta 和 bitmap_page
+  uint32_t extent_id = logical_page_id / BITMAP_SIZE;    // 计算逻辑页所在的 extent 编号
+  uint32_t page_offset = logical_page_id % BITMAP_SIZE;  // 计算逻辑页在 extent 中的偏移量
+  return GetBitmapPageId(extent_id) + 1 + page_offset;   // 位图页之后就是 extent 中的页
+}
+
+const char *DiskManager::GetPageAddress(page_id_t logical_page_id) {
+  ASSERT(IsReadOnly(), "Only a mapped db file has page addresses.");
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  // a page cut off by the end of file cannot be served from the mapping
+  if (offset + PAGE_SIZE > file_size_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return mapping_ + offset;
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
+size_t DiskManager::GetFileSize(const std::string &file_name) {
   struct stat stat_buf;
   int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? stat_buf.st_size : -1;
+  return rc == 0 ? stat_buf.st_size : 0;
+}
+
+bool DiskManager::ReadPendingPage(page_id_t physical_page_id, char *page_data) {
+  std::scoped_lock<std::mutex> lock(pending_latch_);
+  auto it = pending_writes_.find(physical_page_id);
+  if (it == pending_writes_.end()) {
+    it = flushing_writes_.find(physical_page_id);
+    if (it == flushing_writes_.end()) {
+      return false;
+    }
+  }
+  memcpy(page_data, it->second.get(), PAGE_SIZE);
+  return true;
 }
 
 void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
-  int offset = physical_page_id * PAGE_SIZE;
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
+  // the latest image of a page may still be queued
+  if (durability_ == DurabilityMode::kGroupCommit && ReadPendingPage(physical_page_id, page_data)) {
+    return;
+  }
+  if (io_mode_ == DiskIOMode::kMmapReadOnly) {
+    size_t file_size = file_size_.load(std::memory_order_relaxed);
+    size_t read_count = offset >= file_size ? 0 : std::min<size_t>(PAGE_SIZE, file_size - offset);
+    memcpy(page_data, mapping_ + offset, read_count);
+    memset(page_data + read_count, 0, PAGE_SIZE - read_count);
+    return;
+  }
+  if (NeedsBounce(page_data)) {
+    AlignedPageBuffer bounce(AllocateAlignedPages(1));
+    ReadPhysicalPage(physical_page_id, bounce.get());
+    memcpy(page_data, bounce.get(), PAGE_SIZE);
+    return;
+  }
+  if (IsPositional()) {
+    // check if read beyond file length, no syscall needed since the size is tracked in memory
+    if (offset >= file_size_.load(std::memory_order_acquire)) {
+      memset(page_data, 0, PAGE_SIZE);
+      return;
+    }
+    // pread does not move any shared cursor, so no latch is needed here
+    ssize_t read_count = 0;
+    while (read_count < PAGE_SIZE) {
+      ssize_t ret = pread(db_fd_, page_data + read_count, PAGE_SIZE - read_count, offset + read_count);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret <= 0) {
+        if (ret < 0) LOG(ERROR) << "I/O error while reading: " << strerror(errno);
+        break;
+      }
+      read_count += ret;
+    }
+    // if file ends before reading PAGE_SIZE
+    if (read_count < PAGE_SIZE) {
+      memset(page_data + read_count, 0, PAGE_SIZE - read_count);
+    }
+    return;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   // check if read beyond file length
   if (offset >= GetFileSize(file_name_)) {
 #ifdef ENABLE_BPM_DEBUG
@@ -150,13 +727,57 @@ void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data)
 #ifdef ENABLE_BPM_DEBUG
       LOG(INFO) << "Read less than a page" << std::endl;
 #endif
+      db_io_.clear();
       memset(page_data + read_count, 0, PAGE_SIZE - read_count);
     }
   }
 }
 
 void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
+  if (IsReadOnly()) {
+    LOG(ERROR) << "Cannot write a read-only db file.";
+    return;
+  }
   size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
+  if (durability_ == DurabilityMode::kGroupCommit) {
+    size_t num_pending;
+    {
+      std::scoped_lock<std::mutex> lock(pending_latch_);
+      auto &buf = pending_writes_[physical_page_id];
+      if (buf == nullptr) {
+        buf.reset(AllocateAlignedPages(1));
+      }
+      memcpy(buf.get(), page_data, PAGE_SIZE);
+      num_pending = pending_writes_.size();
+    }
+    if (num_pending >= GROUP_COMMIT_BATCH_SIZE) {
+      Sync();
+    }
+    return;
+  }
+  if (NeedsBounce(page_data)) {
+    AlignedPageBuffer bounce(AllocateAlignedPages(1));
+    memcpy(bounce.get(), page_data, PAGE_SIZE);
+    WritePhysicalPage(physical_page_id, bounce.get());
+    return;
+  }
+  if (IsPositional()) {
+    ssize_t write_count = 0;
+    while (write_count < PAGE_SIZE) {
+      ssize_t ret = pwrite(db_fd_, page_data + write_count, PAGE_SIZE - write_count, offset + write_count);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret < 0) {
+        LOG(ERROR) << "I/O error while writing: " << strerror(errno);
+        return;
+      }
+      write_count += ret;
+    }
+    GrowFileSize(offset + PAGE_SIZE);
+    return;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   // set write cursor to offset
   db_io_.seekp(offset);
   db_io_.write(page_data, PAGE_SIZE);
@@ -167,4 +788,33 @@ void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page
   }
   // needs to flush to keep disk file in sync
   db_io_.flush();
-}
\ No newline at end of file
+}
+
+void DiskManager::WritePhysicalPages(page_id_t first_page_id, std::vector<struct iovec> &iov) {
+  size_t offset = static_cast<size_t>(first_page_id) * PAGE_SIZE;
+  size_t idx = 0;
+  while (idx < iov.size()) {
+    int iov_cnt = static_cast<int>(std::min<size_t>(iov.size() - idx, IOV_MAX));
+    ssize_t ret = pwritev(db_fd_, iov.data() + idx, iov_cnt, offset);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while writing: " << strerror(errno);
+      return;
+    }
+    offset += ret;
+    // skip what has been written, a short write may stop in the middle of a page
+    while (ret > 0) {
+      if (static_cast<size_t>(ret) >= iov[idx].iov_len) {
+        ret -= iov[idx].iov_len;
+        idx++;
+      } else {
+        iov[idx].iov_base = static_cast<char *>(iov[idx].iov_base) + ret;
+        iov[idx].iov_len -= ret;
+        ret = 0;
+      }
+    }
+  }
+  GrowFileSize(offset);
+}
@@ -3,7 +3,7 @@
 /**
  * TODO: Student Implement
  */
-bool TableHeap::InsertTuple(Row &row, Txn *txn) {
+bool TableHeap::InsertTuple(Row &row, Txn *txn, BufferAccessStrategy *strategy) {
   if (first_page_id_ == INVALID_PAGE_ID) {
     LOG(ERROR) << "Failed to insert tuple: table is empty" << std::endl;
   }
@@ -23,7 +23,7 @@ bool TableHeap::InsertTuple(Row &row, Txn *txn) {
   }
   if (page_id != INVALID_PAGE_ID) {
     // 在找到的页面中插入元组
-    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, strategy));
     if (page == nullptr) {
       LOG(ERROR) << "Failed to fetch page when insert" << std::endl;
       return false;
@@ -41,7 +41,7 @@ bool TableHeap::InsertTuple(Row &row, Txn *txn) {
     return insert_success;
   } else {
     // 如果所有现有页面都已满，创建新页面
-    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_, strategy));
     if (page == nullptr) {
       LOG(ERROR) << "Failed to fetch page when insert" << std::endl;
       return false;
@@ -55,7 +55,7 @@ bool TableHeap::InsertTuple(Row &row, Txn *txn) {
     }
     // 创建新页面
     page_id_t new_page_id;
-    auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id));
+    auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id, &reservation_, strategy));
     if (new_page == nullptr) {
       LOG(ERROR) << "Failed to create new page while insert" << std::endl;
       return false;
@@ -295,12 +295,28 @@ void TableHeap::DeleteTable(page_id_t page_id) {
   }
 }
 
+void TableHeap::GetPageIds(std::vector<page_id_t> *page_ids) {
+  BufferAccessStrategy strategy(BufferAccessType::kBulkRead);
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, &strategy));
+    if (page == nullptr) {
+      LOG(ERROR) << "Failed to fetch page " << page_id << " of table heap" << std::endl;
+      return;
+    }
+    page_ids->push_back(page_id);
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
 /**
  * TODO: Student Implement
  */
-TableIterator TableHeap::Begin(Txn *txn) {
+TableIterator TableHeap::Begin(Txn *txn, BufferAccessStrategy *strategy) {
   // 获取第一个页面
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_, strategy));
   // LOG(INFO) << "In Begin: first_page_id_: " << first_page_id_ << std::endl;
   if (page == nullptr) {
     LOG(ERROR) << "Failed to fetch page when get Begin iterator(a): " << first_page_id_ << std::endl;
@@ -315,7 +331,7 @@ TableIterator TableHeap::Begin(Txn *txn) {
     // LOG(INFO) << "In Begin 0: rid: " << rid.GetPageId() << " " << rid.GetSlotNum() << std::endl;
     page->RUnlatch();
     buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
-    return TableIterator(this, rid, txn);
+    return TableIterator(this, rid, txn, strategy);
   }
   // LOG(INFO) << "In Begin 1: rid: " << rid.GetPageId() << " " << rid.GetSlotNum() << std::endl;
 
@@ -324,7 +340,7 @@ TableIterator TableHeap::Begin(Txn *txn) {
     page_id_t next_page_id = page->GetNextPageId();
     page->RUnlatch();
     buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
-    page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id, strategy));
     if (page == nullptr) {
       LOG(ERROR) << "Failed to fetch page when get Begin iterator(b): " << next_page_id << std::endl;
       return End();
@@ -335,7 +351,7 @@ TableIterator TableHeap::Begin(Txn *txn) {
       // std::endl;
       page->RUnlatch();
       buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
-      return TableIterator(this, rid, txn);
+      return TableIterator(this, rid, txn, strategy);
     }
   }
 
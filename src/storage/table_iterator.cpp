@@ -6,8 +6,8 @@
 /**
  * TODO: Student Implement
  */
-TableIterator::TableIterator(TableHeap *table_heap, RowId rid, Txn *txn)
-    : table_heap_(table_heap), rid_(rid), txn_(txn) {
+TableIterator::TableIterator(TableHeap *table_heap, RowId rid, Txn *txn, BufferAccessStrategy *strategy)
+    : table_heap_(table_heap), rid_(rid), txn_(txn), strategy_(strategy) {
   row_ = new Row(rid);
   if (rid_.GetPageId() != INVALID_PAGE_ID) {
     // LOG(INFO) << "TableIterator initialized with rid: " << rid_.GetPageId() << " " << rid_.GetSlotNum() << std::endl;
@@ -20,6 +20,8 @@ TableIterator::TableIterator(const TableIterator &other) {
   table_heap_ = other.table_heap_;
   rid_ = other.rid_;
   txn_ = other.txn_;
+  read_ahead_ = other.read_ahead_;
+  strategy_ = other.strategy_;
   row_ = new Row(*other.row_);
 }
 
@@ -38,6 +40,8 @@ TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
     table_heap_ = itr.table_heap_;
     rid_ = itr.rid_;
     txn_ = itr.txn_;
+    read_ahead_ = itr.read_ahead_;
+    strategy_ = itr.strategy_;
     delete row_;
     row_ = new Row(*itr.row_);
   }
@@ -46,7 +50,8 @@ TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
 
 // ++iter
 TableIterator &TableIterator::operator++() {
-  auto page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(rid_.GetPageId()));
+  auto page =
+      reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(rid_.GetPageId(), strategy_));
   RowId next_rid;
   if (page != nullptr) {
     if (page->GetNextTupleRid(rid_, &next_rid)) {  // 当前页面还有下一个元组
@@ -56,7 +61,11 @@ TableIterator &TableIterator::operator++() {
       while (page->GetNextPageId() != INVALID_PAGE_ID) {  // 有可能一个页中的所有元组都被删除了
         auto next_page_id = page->GetNextPageId();
         table_heap_->buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
-        page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(next_page_id));
+        page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(next_page_id, strategy_));
+        // 预读后续的页，只读到本表的 run 结束为止
+        page_id_t owned_end = table_heap_->reservation_.GetRunEnd(next_page_id);
+        table_heap_->buffer_pool_manager_->Prefetch(
+            read_ahead_.OnAccess(next_page_id, page->GetNextPageId(), owned_end), strategy_);
         if (page->GetFirstTupleRid(&next_rid)) {
           rid_ = next_rid;
           row_->SetRowId(rid_);
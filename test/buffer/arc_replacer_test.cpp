@@ -0,0 +1,61 @@
+#include "buffer/arc_replacer.h"
+
+#include "gtest/gtest.h"
+
+TEST(ARCReplacerTest, SampleTest) {
+  ARCReplacer arc_replacer(4);
+
+  // Scenario: load pages 100 to 103 into frames 0 to 3, page 100 is accessed again.
+  for (frame_id_t i = 0; i < 4; i++) {
+    arc_replacer.Admit(i, 100 + i);
+  }
+  arc_replacer.RecordAccess(0);
+  EXPECT_EQ(4, arc_replacer.Size());
+
+  // Scenario: pages seen once are evicted first, oldest first.
+  int value;
+  ASSERT_TRUE(arc_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  ASSERT_TRUE(arc_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  EXPECT_EQ(2, arc_replacer.Size());
+
+  // Scenario: page 101 comes back while it is remembered, it goes to the frequent list and the recent list grows.
+  arc_replacer.Admit(1, 101);
+  std::vector<frame_id_t> victims;
+  arc_replacer.PeekVictims(3, &victims);
+  EXPECT_EQ(std::vector<frame_id_t>({0, 1, 3}), victims);
+  ASSERT_TRUE(arc_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+
+  // Scenario: page 100 comes back from the frequent ghosts, the recent list shrinks again.
+  arc_replacer.Admit(0, 100);
+  ASSERT_TRUE(arc_replacer.VictimIf(&value, [](frame_id_t frame_id) { return frame_id != 3; }));
+  EXPECT_EQ(1, value);
+  arc_replacer.Pin(3);
+  EXPECT_EQ(1, arc_replacer.Size());
+  ASSERT_TRUE(arc_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+  EXPECT_FALSE(arc_replacer.Victim(&value));
+}
+
+TEST(ARCReplacerTest, ScanResistanceTest) {
+  const frame_id_t num_frames = 16;
+  const frame_id_t num_hot_frames = 4;
+  ARCReplacer arc_replacer(num_frames);
+  for (frame_id_t i = 0; i < num_hot_frames; i++) {
+    arc_replacer.Admit(i, i);
+    arc_replacer.RecordAccess(i);
+  }
+  for (frame_id_t i = num_hot_frames; i < num_frames; i++) {
+    arc_replacer.Admit(i, i);
+  }
+  // a scan never reads a page again while it is remembered, so the frequent list keeps its frames
+  page_id_t next_page_id = num_frames;
+  for (int i = 0; i < 100; i++) {
+    frame_id_t frame_id;
+    ASSERT_TRUE(arc_replacer.Victim(&frame_id));
+    ASSERT_LE(num_hot_frames, frame_id);
+    arc_replacer.Admit(frame_id, next_page_id++);
+  }
+}
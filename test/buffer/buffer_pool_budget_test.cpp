@@ -0,0 +1,166 @@
+#include "buffer/buffer_pool_budget.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+
+TEST(BufferPoolBudgetTest, SampleTest) {
+  const std::string idle_db_name = "budget_test_idle.db";
+  const std::string busy_db_name = "budget_test_busy.db";
+  const size_t budget_size = 512;
+  const page_id_t num_pages = 1024;
+  remove(idle_db_name.c_str());
+  remove(busy_db_name.c_str());
+  auto *idle_disk_manager = new DiskManager(idle_db_name);
+  auto *busy_disk_manager = new DiskManager(busy_db_name);
+  // the thread does not get a turn, the test runs the passes itself
+  auto *budget = new BufferPoolBudget(budget_size, std::chrono::hours(1));
+  auto sum_of_sizes = [](BufferPoolManager *a, BufferPoolManager *b) { return a->GetPoolSize() + b->GetPoolSize(); };
+
+  // the first pool gets the whole budget, the second a fair share that the first makes room for
+  EXPECT_EQ(budget_size, budget->GetInitialSize());
+  BufferPoolManager *idle = new BufferPoolManagerInstance(budget->GetInitialSize(), idle_disk_manager);
+  budget->Register(idle);
+  EXPECT_EQ(budget_size / 2, budget->GetInitialSize());
+  BufferPoolManager *busy = new BufferPoolManagerInstance(budget->GetInitialSize(), busy_disk_manager);
+  budget->Register(busy);
+  EXPECT_LE(sum_of_sizes(idle, busy), budget_size);
+  EXPECT_GT(idle->GetPoolSize(), busy->GetPoolSize());
+
+  // a pool nobody misses in keeps its frames while no other pool needs them
+  size_t idle_size = idle->GetPoolSize();
+  budget->Rebalance();
+  EXPECT_EQ(idle_size, idle->GetPoolSize());
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_NE(nullptr, busy->NewPage(page_id));
+    busy->UnpinPage(page_id, true);
+  }
+  // the frames of the idle pool move over to the pool that misses, never more than the budget in total
+  for (int pass = 0; pass < 10; pass++) {
+    budget->Rebalance();
+    EXPECT_LE(sum_of_sizes(idle, busy), budget_size);
+    for (page_id_t i = 0; i < num_pages; i++) {
+      ASSERT_NE(nullptr, busy->FetchPage(i));
+      busy->UnpinPage(i, false);
+    }
+  }
+  EXPECT_GE(idle->GetPoolSize(), BufferPoolBudget::MIN_POOL_SIZE);
+  EXPECT_LT(idle->GetPoolSize(), 2 * BufferPoolBudget::MIN_POOL_SIZE);
+  EXPECT_GT(busy->GetPoolSize(), budget_size - 2 * BufferPoolBudget::MIN_POOL_SIZE);
+
+  // a smaller budget is enforced right away
+  budget->SetBudget(budget_size / 2);
+  EXPECT_EQ(budget_size / 2, budget->GetBudget());
+  EXPECT_LE(sum_of_sizes(idle, busy), budget_size / 2);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = busy->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    busy->UnpinPage(i, false);
+  }
+
+  budget->Unregister(idle);
+  budget->Unregister(busy);
+  delete budget;
+  delete idle;
+  delete busy;
+  idle_disk_manager->Close();
+  busy_disk_manager->Close();
+  delete idle_disk_manager;
+  delete busy_disk_manager;
+  remove(idle_db_name.c_str());
+  remove(busy_db_name.c_str());
+}
+
+TEST(BufferPoolBudgetTest, PinnedPoolTest) {
+  const std::string pinned_db_name = "budget_test_pinned.db";
+  const std::string new_db_name = "budget_test_new.db";
+  const size_t budget_size = 512;
+  remove(pinned_db_name.c_str());
+  remove(new_db_name.c_str());
+  auto *pinned_disk_manager = new DiskManager(pinned_db_name);
+  auto *new_disk_manager = new DiskManager(new_db_name);
+  auto *budget = new BufferPoolBudget(budget_size, std::chrono::hours(1));
+  BufferPoolManager *pinned = new BufferPoolManagerInstance(budget->GetInitialSize(), pinned_disk_manager);
+  budget->Register(pinned);
+  // every frame is pinned, shrinking the pool waits for the pins until it gives up
+  std::vector<page_id_t> page_ids(budget_size);
+  for (auto &page_id : page_ids) {
+    ASSERT_NE(nullptr, pinned->NewPage(page_id));
+  }
+  std::thread shrinker([&]() { budget->SetBudget(budget_size / 2); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // a database can still be created and dropped meanwhile
+  auto start_time = std::chrono::steady_clock::now();
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(budget->GetInitialSize(), new_disk_manager);
+  budget->Register(bpm);
+  EXPECT_EQ(budget_size / 2, budget->GetBudget());
+  budget->Unregister(bpm);
+  EXPECT_GT(std::chrono::milliseconds(500), std::chrono::steady_clock::now() - start_time);
+  shrinker.join();
+  EXPECT_EQ(budget_size, pinned->GetPoolSize());
+
+  for (auto page_id : page_ids) {
+    pinned->UnpinPage(page_id, false);
+  }
+  budget->Unregister(pinned);
+  delete budget;
+  delete bpm;
+  delete pinned;
+  pinned_disk_manager->Close();
+  new_disk_manager->Close();
+  delete pinned_disk_manager;
+  delete new_disk_manager;
+  remove(pinned_db_name.c_str());
+  remove(new_db_name.c_str());
+}
+
+TEST(BufferPoolBudgetTest, ReservedFramesTest) {
+  const std::string db_name = "budget_test_reserved.db";
+  const size_t budget_size = 512;
+  const size_t reserved = 384;
+  const page_id_t num_pages = 1024;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *budget = new BufferPoolBudget(budget_size, std::chrono::hours(1));
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(budget->GetInitialSize(), disk_manager);
+  budget->Register(bpm);
+  EXPECT_EQ(budget_size, bpm->GetPoolSize());
+
+  // the frames of the pools of fixed size are taken from the shared ones right away
+  budget->SetReserved(reserved);
+  EXPECT_EQ(reserved, budget->GetReserved());
+  EXPECT_EQ(budget_size - reserved, bpm->GetPoolSize());
+  EXPECT_EQ((budget_size - reserved) / 2, budget->GetInitialSize());
+
+  // misses do not grow the pool into the reserved frames
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  budget->Rebalance();
+  EXPECT_EQ(budget_size - reserved, bpm->GetPoolSize());
+
+  // released frames go to the pool once it misses again
+  budget->SetReserved(0);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    bpm->UnpinPage(i, false);
+  }
+  budget->Rebalance();
+  EXPECT_EQ(budget_size, bpm->GetPoolSize());
+
+  budget->Unregister(bpm);
+  delete budget;
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,194 @@
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+static const std::string db_file_name = "bpm_performance_test.db";
+
+/**
+ * Fetch and unpin random pages from several threads at the same time.
+ * @return number of fetches per second
+ */
+static double FetchUnpinThroughput(BufferPoolManager *bpm, uint32_t num_pages, int num_threads,
+                                   int fetches_per_thread) {
+  std::vector<std::thread> threads;
+  auto start_time = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<uint32_t> dist(0, num_pages - 1);
+      for (int i = 0; i < fetches_per_thread; i++) {
+        page_id_t page_id = dist(rng);
+        Page *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(stop_time - start_time).count();
+  return num_threads * fetches_per_thread / seconds;
+}
+
+/**
+ * All pages fit in the buffer pool, so the benchmark measures the hit path. The latency is the average wall time of a
+ * fetch and unpin pair seen by one thread.
+ */
+TEST(BufferPoolManagerPerformanceTest, ConcurrentFetchTest) {
+  const uint32_t num_pages = 1024;
+  const size_t buffer_pool_size = 2048;
+  const int total_fetches = 1 << 18;
+  for (size_t num_instances : {1, 8}) {
+    remove(db_file_name.c_str());
+    DiskManager disk_mgr(db_file_name);
+    BufferPoolManager *bpm;
+    if (num_instances == 1) {
+      bpm = new BufferPoolManagerInstance(buffer_pool_size, &disk_mgr);
+    } else {
+      bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, &disk_mgr);
+    }
+    page_id_t page_id;
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id));
+      ASSERT_EQ(i, page_id);
+      bpm->UnpinPage(page_id, false);
+    }
+    for (int num_threads : {1, 4, 16, 64}) {
+      double throughput = FetchUnpinThroughput(bpm, num_pages, num_threads, total_fetches / num_threads);
+      LOG(INFO) << "[" << num_instances << " instance(s)] " << num_threads
+                << " thread(s): " << static_cast<uint64_t>(throughput) << " fetches/s, latency "
+                << static_cast<uint64_t>(num_threads * 1e9 / throughput) << " ns";
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+    delete bpm;
+    disk_mgr.Close();
+  }
+  remove(db_file_name.c_str());
+}
+
+/**
+ * Almost every fetch hits, the misses make the replacer process the accesses of the hits and pick victims.
+ */
+TEST(BufferPoolManagerPerformanceTest, ReplacerOverheadTest) {
+  const uint32_t num_pages = 1024;
+  const size_t buffer_pool_size = 960;
+  const int total_fetches = 1 << 18;
+  const std::pair<ReplacerPolicy, const char *> policies[] = {{ReplacerPolicy::kLRU, "LRU"},
+                                                              {ReplacerPolicy::kClock, "CLOCK"}};
+  for (auto &policy : policies) {
+    remove(db_file_name.c_str());
+    DiskManager disk_mgr(db_file_name);
+    auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, &disk_mgr, 0, policy.first);
+    page_id_t page_id;
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id));
+      bpm->UnpinPage(page_id, false);
+    }
+    for (int num_threads : {1, 4}) {
+      double throughput = FetchUnpinThroughput(bpm, num_pages, num_threads, total_fetches / num_threads);
+      LOG(INFO) << "[" << policy.second << "] " << num_threads << " thread(s): " << static_cast<uint64_t>(throughput)
+                << " fetches/s";
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+    delete bpm;
+    disk_mgr.Close();
+  }
+  remove(db_file_name.c_str());
+}
+
+/**
+ * Hot pages stand in for the inner pages of a B+ tree that point lookups go through, while another thread keeps
+ * scanning a table larger than the buffer pool. A hot page is marked in memory without being dirtied, so a lookup that
+ * finds the mark gone knows the page was evicted and read again.
+ */
+TEST(BufferPoolManagerPerformanceTest, ScanResistanceTest) {
+  const uint32_t num_hot_pages = 192;
+  const uint32_t num_scan_pages = 1024;
+  const size_t buffer_pool_size = 256;
+  const int num_lookup_threads = 2;
+  const int lookups_per_thread = 1 << 16;
+  const std::pair<ReplacerPolicy, const char *> policies[] = {
+      {ReplacerPolicy::kLRU, "LRU"},
+      {ReplacerPolicy::kClock, "CLOCK"},
+      {ReplacerPolicy::kLRUK, "LRU-K"},
+      {ReplacerPolicy::kARC, "ARC"}};
+  for (auto &policy : policies) {
+    remove(db_file_name.c_str());
+    DiskManager disk_mgr(db_file_name);
+    auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, &disk_mgr, 0, policy.first);
+    page_id_t page_id;
+    for (uint32_t i = 0; i < num_hot_pages + num_scan_pages; i++) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id));
+      bpm->UnpinPage(page_id, true);
+    }
+    bpm->FlushAllPages();
+    // warm up the hot pages and mark them
+    for (page_id_t i = 0; i < static_cast<page_id_t>(num_hot_pages); i++) {
+      for (int access = 0; access < 2; access++) {
+        Page *page = bpm->FetchPage(i);
+        ASSERT_NE(nullptr, page);
+        page->GetData()[0] = 1;
+        bpm->UnpinPage(i, false);
+      }
+    }
+    std::atomic<bool> stop_scan{false};
+    std::atomic<uint64_t> scanned_pages{0};
+    std::thread scanner([&]() {
+      while (!stop_scan.load()) {
+        for (uint32_t i = 0; i < num_scan_pages && !stop_scan.load(); i++) {
+          page_id_t scan_page_id = num_hot_pages + i;
+          ASSERT_NE(nullptr, bpm->FetchPage(scan_page_id));
+          bpm->UnpinPage(scan_page_id, false);
+          scanned_pages++;
+        }
+      }
+    });
+    std::atomic<uint64_t> misses{0};
+    std::vector<std::thread> threads;
+    auto start_time = std::chrono::steady_clock::now();
+    for (int t = 0; t < num_lookup_threads; t++) {
+      threads.emplace_back([&, t]() {
+        std::mt19937 rng(t);
+        std::uniform_int_distribution<page_id_t> dist(0, num_hot_pages - 1);
+        for (int i = 0; i < lookups_per_thread; i++) {
+          page_id_t hot_page_id = dist(rng);
+          Page *page = bpm->FetchPage(hot_page_id);
+          ASSERT_NE(nullptr, page);
+          page->WLatch();
+          if (page->GetData()[0] == 0) {
+            misses++;
+            page->GetData()[0] = 1;
+          }
+          page->WUnlatch();
+          bpm->UnpinPage(hot_page_id, false);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto stop_time = std::chrono::steady_clock::now();
+    stop_scan.store(true);
+    scanner.join();
+    double seconds = std::chrono::duration<double>(stop_time - start_time).count();
+    uint64_t num_lookups = num_lookup_threads * lookups_per_thread;
+    LOG(INFO) << "[" << policy.second << "] hot hit ratio "
+              << 100.0 * static_cast<double>(num_lookups - misses.load()) / static_cast<double>(num_lookups) << "%, "
+              << static_cast<uint64_t>(num_lookups / seconds) << " lookups/s, "
+              << static_cast<uint64_t>(static_cast<double>(scanned_pages.load()) / seconds) << " scanned pages/s";
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+    delete bpm;
+    disk_mgr.Close();
+  }
+  remove(db_file_name.c_str());
+}
@@ -1,10 +1,17 @@
-#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <fstream>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "buffer_pool_test_util.h"  // NOLINT
 #include "gtest/gtest.h"
 
 TEST(BufferPoolManagerTest, BinaryDataTest) {
@@ -17,7 +24,7 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   remove(db_name.c_str());
   auto *disk_manager = new DiskManager(db_name);
-  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
 
   page_id_t page_id_temp;
   auto *page0 = bpm->NewPage(page_id_temp);
@@ -201,7 +208,7 @@ TEST(BufferPoolManagerTest, LRUPerformanceTest) {
 
   remove(db_name.c_str());
   auto *disk_manager = new DiskManager(db_name);
-  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
 
   std::vector<page_id_t> page_ids;
   std::vector<page_id_t> new_page_ids;
@@ -225,4 +232,453 @@ TEST(BufferPoolManagerTest, LRUPerformanceTest) {
   disk_manager->Close();
   delete disk_manager;
   remove(db_name.c_str());
-}
\ No newline at end of file
+}
+TEST(BufferPoolManagerTest, ReplacerPolicyTest) {
+  const size_t buffer_pool_size = 10;
+  const page_id_t num_pages = buffer_pool_size * 3;
+
+  TestBufferPool pool("bpm_test.db");
+  for (auto policy : {ReplacerPolicy::kLRU, ReplacerPolicy::kClock, ReplacerPolicy::kLRUK, ReplacerPolicy::kARC}) {
+    pool.Remove();
+    auto *bpm = pool.Open([policy](DiskManager *disk_manager) {
+      return new BufferPoolManagerInstance(buffer_pool_size, disk_manager, 0, policy);
+    });
+    ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+    // pinned pages are never evicted, the other frames keep being replaced
+    const page_id_t num_pinned = 3;
+    for (page_id_t i = 0; i < num_pinned; i++) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+    }
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+    for (int i = 0; i < 1000; i++) {
+      page_id_t page_id = dist(rng);
+      Page *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page);
+      ASSERT_EQ(PageText(page_id), page->GetData());
+      bpm->UnpinPage(page_id, false);
+    }
+    for (page_id_t i = 0; i < num_pinned; i++) {
+      EXPECT_TRUE(bpm->UnpinPage(i, false));
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+  }
+}
+
+TEST(BufferPoolManagerTest, FetchPagesTest) {
+  const size_t buffer_pool_size = 10;
+  const page_id_t num_pages = buffer_pool_size * 3;
+
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.OpenInstance(buffer_pool_size);
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+
+  // mix of resident and evicted pages, the evicted ones are read in one batch
+  std::vector<page_id_t> page_ids = {num_pages - 1, 0, 5, num_pages - 2, 12};
+  std::vector<Page *> pages = bpm->FetchPages(page_ids);
+  ASSERT_EQ(page_ids.size(), pages.size());
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    ASSERT_NE(nullptr, pages[i]);
+    EXPECT_EQ(page_ids[i], pages[i]->GetPageId());
+    EXPECT_EQ(PageText(page_ids[i]), pages[i]->GetData());
+  }
+
+  // pages that cannot get a frame are reported as nullptr
+  std::vector<page_id_t> more_page_ids;
+  for (page_id_t i = 13; i < 23; i++) {
+    more_page_ids.push_back(i);
+  }
+  std::vector<Page *> more_pages = bpm->FetchPages(more_page_ids);
+  EXPECT_EQ(buffer_pool_size - page_ids.size(),
+            std::count_if(more_pages.begin(), more_pages.end(), [](Page *page) { return page != nullptr; }));
+  for (size_t i = 0; i < more_page_ids.size(); i++) {
+    if (more_pages[i] != nullptr) {
+      bpm->UnpinPage(more_page_ids[i], false);
+    }
+  }
+  for (auto id : page_ids) {
+    EXPECT_TRUE(bpm->UnpinPage(id, false));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, MmapReadOnlyTest) {
+  const size_t buffer_pool_size = 10;
+  const page_id_t num_pages = buffer_pool_size * 3;
+
+  TestBufferPool pool("bpm_test.db");
+  pool.OpenInstance(buffer_pool_size);
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+
+  auto *bpm = pool.Open(
+      [](DiskManager *disk_manager) { return new BufferPoolManagerInstance(buffer_pool_size, disk_manager); },
+      DiskIOMode::kMmapReadOnly);
+  DiskManager *disk_manager = pool.GetDiskManager();
+  ASSERT_TRUE(disk_manager->IsReadOnly());
+  // every page goes through the small pool, the data is served straight from the mapping
+  for (page_id_t page_id = 0; page_id < num_pages; page_id++) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(disk_manager->GetPageAddress(page_id), page->GetData());
+    EXPECT_EQ(PageText(page_id), page->GetData());
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  char buf[PAGE_SIZE];
+  disk_manager->ReadPage(7, buf);
+  EXPECT_STREQ("page 7", buf);
+
+  // writes are rejected
+  page_id_t page_id;
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  ASSERT_NE(nullptr, bpm->FetchPage(0));
+  EXPECT_FALSE(bpm->UnpinPage(0, true));
+  EXPECT_FALSE(bpm->DeletePage(0));
+  EXPECT_EQ(INVALID_PAGE_ID, disk_manager->AllocatePage());
+  EXPECT_FALSE(disk_manager->WritePageAsync(0, buf).get());
+  EXPECT_FALSE(disk_manager->IsPageFree(0));
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, PageCleanerTest) {
+  const size_t buffer_pool_size = 10;
+  const size_t clean_frame_target = 4;
+
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.Open([](DiskManager *disk_manager) {
+    return new BufferPoolManagerInstance(buffer_pool_size, disk_manager, clean_frame_target);
+  });
+  DiskManager *disk_manager = pool.GetDiskManager();
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(buffer_pool_size));
+
+  // the cleaner writes the next clean_frame_target victims back while they stay in the pool
+  char buf[PAGE_SIZE];
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (true) {
+    disk_manager->ReadPage(clean_frame_target - 1, buf);
+    if (strcmp(buf, "page 3") == 0 || std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); i++) {
+    disk_manager->ReadPage(i, buf);
+    if (i < static_cast<page_id_t>(clean_frame_target)) {
+      EXPECT_EQ(PageText(i), buf);
+    } else {
+      EXPECT_STREQ("", buf);
+    }
+  }
+
+  // evicting the cleaned pages needs no write, their data comes back from disk
+  page_id_t page_id;
+  for (size_t i = 0; i < clean_frame_target; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); i++) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(PageText(i), page->GetData());
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, PrefetchTest) {
+  const size_t buffer_pool_size = 16;
+  const page_id_t num_pages = 32;
+
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.OpenInstance(buffer_pool_size);
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+  bpm->FlushAllPages();
+
+  // pages 0 to 3 were evicted, prefetching them pins nothing
+  bpm->Prefetch({0, 1, 2, 3, 31, INVALID_PAGE_ID, num_pages});
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  for (page_id_t i = 0; i < 4; i++) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(1, page->GetPinCount());
+    EXPECT_EQ(PageText(i), page->GetData());
+  }
+  for (page_id_t i = 0; i < 4; i++) {
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  // the reads in flight never take more than a quarter of the pool, the pages that did not fit are fetched as usual
+  std::vector<page_id_t> page_ids;
+  for (page_id_t i = 4; i < num_pages; i++) {
+    page_ids.push_back(i);
+  }
+  bpm->Prefetch(page_ids);
+  for (auto i : page_ids) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(PageText(i), page->GetData());
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, ResizeTest) {
+  const page_id_t num_pages = 40;
+
+  TestBufferPool pool("bpm_test.db");
+  for (auto policy : {ReplacerPolicy::kLRU, ReplacerPolicy::kClock, ReplacerPolicy::kLRUK, ReplacerPolicy::kARC}) {
+    pool.Remove();
+    auto *bpm = pool.Open(
+        [policy](DiskManager *disk_manager) { return new BufferPoolManagerInstance(10, disk_manager, 0, policy); });
+    ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+    auto check_page = [&](page_id_t id, bool unpin) {
+      Page *page = bpm->FetchPage(id);
+      ASSERT_NE(nullptr, page);
+      ASSERT_EQ(PageText(id), page->GetData());
+      if (unpin) {
+        bpm->UnpinPage(id, false);
+      }
+    };
+
+    // grow past one chunk of frames, every page fits and can be pinned at the same time
+    ASSERT_TRUE(bpm->Resize(1100));
+    EXPECT_EQ(1100, bpm->GetPoolSize());
+    for (page_id_t i = 0; i < num_pages; i++) {
+      check_page(i, false);
+    }
+    // pinned pages keep their frames, so the pool cannot shrink
+    EXPECT_FALSE(bpm->Resize(5));
+    EXPECT_EQ(1100, bpm->GetPoolSize());
+    for (page_id_t i = 0; i < num_pages; i++) {
+      EXPECT_TRUE(bpm->UnpinPage(i, true));
+    }
+
+    // shrink while another thread keeps fetching pages, their data survives the eviction
+    std::atomic<bool> stop{false};
+    std::thread reader([&]() {
+      std::mt19937 rng(0);
+      std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+      while (!stop.load()) {
+        page_id_t id = dist(rng);
+        Page *page = bpm->FetchPage(id);
+        if (page == nullptr) {
+          continue;
+        }
+        EXPECT_EQ(PageText(id), page->GetData());
+        bpm->UnpinPage(id, false);
+      }
+    });
+    EXPECT_TRUE(bpm->Resize(8));
+    EXPECT_EQ(8, bpm->GetPoolSize());
+    stop.store(true);
+    reader.join();
+    for (page_id_t i = 0; i < num_pages; i++) {
+      check_page(i, true);
+    }
+    // frames of a released chunk can be added again
+    ASSERT_TRUE(bpm->Resize(600));
+    for (page_id_t i = 0; i < num_pages; i++) {
+      check_page(i, true);
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+  }
+}
+
+TEST(BufferPoolManagerTest, AccessStrategyTest) {
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 256;
+  const page_id_t num_hot_pages = 32;
+  // the pages scanned are not resident when the scans start
+  const page_id_t scan_begin = 100;
+  const page_id_t scan_end = num_pages - static_cast<page_id_t>(buffer_pool_size);
+
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.OpenInstance(buffer_pool_size);
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+  auto touch_hot_pages = [&]() {
+    for (page_id_t i = 0; i < num_hot_pages; i++) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+      bpm->UnpinPage(i, false);
+    }
+  };
+  auto count_resident = [&](page_id_t begin, page_id_t end) {
+    std::vector<page_id_t> resident;
+    bpm->GetResidentPages(&resident);
+    return std::count_if(resident.begin(), resident.end(), [&](page_id_t id) { return id >= begin && id < end; });
+  };
+  touch_hot_pages();
+  ASSERT_EQ(num_hot_pages, count_resident(0, num_hot_pages));
+
+  // a scan through a ring keeps the hot pages resident and takes only the frames of its ring
+  BufferAccessStrategy strategy(BufferAccessType::kBulkRead);
+  const size_t ring_size = buffer_pool_size / BufferAccessStrategy::MAX_RING_SHARE;
+  for (page_id_t i = scan_begin; i < scan_end; i++) {
+    Page *page = bpm->FetchPage(i, &strategy);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(PageText(i), page->GetData());
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_EQ(num_hot_pages, count_resident(0, num_hot_pages));
+  EXPECT_EQ(ring_size, count_resident(scan_begin, scan_end));
+
+  // a pinned frame of the ring is passed over, the miss is served by the replacer
+  Page *pinned = bpm->FetchPage(40, &strategy);
+  ASSERT_NE(nullptr, pinned);
+  for (page_id_t i = 41; i < 41 + static_cast<page_id_t>(ring_size); i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i, &strategy));
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_STREQ("page 40", pinned->GetData());
+  bpm->UnpinPage(40, false);
+
+  // the same scan without a ring pushes the hot pages out
+  for (page_id_t i = scan_begin; i < scan_end; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_EQ(0, count_resident(0, num_hot_pages));
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, CheckpointTest) {
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 48;
+
+  // the pages of the second pool are spread over its instances, runs of pages are still written together
+  TestBufferPool pool("bpm_test.db");
+  for (int parallel = 0; parallel < 2; parallel++) {
+    pool.Remove();
+    BufferPoolManager *bpm = pool.Open([parallel](DiskManager *disk_manager) -> BufferPoolManager * {
+      if (parallel == 0) {
+        return new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+      }
+      return new ParallelBufferPoolManager(4, buffer_pool_size, disk_manager);
+    });
+    ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+    EXPECT_EQ(num_pages, bpm->Checkpoint());
+    EXPECT_EQ(0, bpm->Checkpoint());
+
+    // only the pages dirtied since are written, a pinned page included
+    std::vector<page_id_t> dirtied = {3, 10, 11, 12, 13, 40};
+    for (auto id : dirtied) {
+      Page *page = bpm->FetchPage(id);
+      ASSERT_NE(nullptr, page);
+      SetPageText(page->GetData(), id, "new page ");
+      bpm->UnpinPage(id, true);
+    }
+    Page *pinned = bpm->FetchPage(20);
+    ASSERT_NE(nullptr, pinned);
+    SetPageText(pinned->GetData(), 20, "new page ");
+    bpm->UnpinPage(20, true);
+    ASSERT_NE(nullptr, bpm->FetchPage(20));
+    dirtied.push_back(20);
+    EXPECT_EQ(dirtied.size(), bpm->Checkpoint());
+    EXPECT_FALSE(pinned->IsDirty());
+    bpm->UnpinPage(20, false);
+
+    // the pages of the first extent follow the meta page and its bitmap page
+    std::ifstream file(pool.GetDbName(), std::ios::binary);
+    char data[PAGE_SIZE];
+    for (page_id_t i = 0; i < num_pages; i++) {
+      file.seekg((i + 2) * PAGE_SIZE);
+      ASSERT_TRUE(file.read(data, PAGE_SIZE));
+      bool is_dirtied = std::find(dirtied.begin(), dirtied.end(), i) != dirtied.end();
+      EXPECT_EQ(PageText(i, is_dirtied ? "new page " : "page "), data);
+    }
+    EXPECT_TRUE(bpm->CheckAllUnpinned());
+  }
+}
+
+TEST(BufferPoolManagerTest, CheckpointConcurrentWriteTest) {
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 32;
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.Open(
+      [](DiskManager *disk_manager) { return new ParallelBufferPoolManager(4, buffer_pool_size, disk_manager); });
+  DiskManager *disk_manager = pool.GetDiskManager();
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  // every byte of a page is set to the same value under its write latch, a checkpoint must never write a mix
+  std::atomic<bool> stop{false};
+  std::thread writer([&]() {
+    for (char value = 1; !stop.load(); value = static_cast<char>(value % 100 + 1)) {
+      for (page_id_t i = 0; i < num_pages; i++) {
+        Page *page = bpm->FetchPage(i);
+        ASSERT_NE(nullptr, page);
+        page->WLatch();
+        for (size_t j = 0; j < PAGE_SIZE; j++) {
+          page->GetData()[j] = value;
+        }
+        page->WUnlatch();
+        bpm->UnpinPage(i, true);
+      }
+    }
+  });
+  char data[PAGE_SIZE];
+  int num_torn = 0;
+  for (int round = 0; round < 50; round++) {
+    bpm->Checkpoint();
+    for (page_id_t i = 0; i < num_pages; i++) {
+      disk_manager->ReadPage(i, data);
+      if (std::count(data, data + PAGE_SIZE, data[0]) != static_cast<std::ptrdiff_t>(PAGE_SIZE)) {
+        num_torn++;
+      }
+    }
+  }
+  stop = true;
+  writer.join();
+  EXPECT_EQ(0, num_torn);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+}
+
+TEST(BufferPoolManagerTest, SyncTest) {
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 48;
+
+  TestBufferPool pool("bpm_test.db");
+  for (int parallel = 0; parallel < 2; parallel++) {
+    pool.Remove();
+    BufferPoolManager *bpm = pool.Open([parallel](DiskManager *disk_manager) -> BufferPoolManager * {
+      if (parallel == 0) {
+        return new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+      }
+      return new ParallelBufferPoolManager(4, buffer_pool_size, disk_manager);
+    });
+    ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+    bpm->Sync();
+
+    // a crash right after the commit, the db file is opened again without being closed
+    auto *reopened = new DiskManager(pool.GetDbName());
+    char data[PAGE_SIZE];
+    for (page_id_t i = 0; i < num_pages; i++) {
+      EXPECT_FALSE(reopened->IsPageFree(i));
+      reopened->ReadPage(i, data);
+      EXPECT_EQ(PageText(i), data);
+    }
+    EXPECT_TRUE(reopened->IsPageFree(num_pages));
+    delete reopened;
+  }
+}
+
+TEST(BufferPoolManagerTest, StaleCopyTest) {
+  TestBufferPool pool("bpm_test.db");
+  auto *bpm = pool.OpenInstance(10);
+  auto *other_bpm = new BufferPoolManagerInstance(10, pool.GetDiskManager());
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(1));
+  const page_id_t page_id = 0;
+  bpm->FlushPage(page_id);
+
+  // the other pool frees and allocates the page again while this one still has the old copy pinned
+  ASSERT_NE(nullptr, bpm->FetchPage(page_id));
+  ASSERT_TRUE(other_bpm->DeletePage(page_id));
+  EXPECT_EQ(nullptr, bpm->CreatePage(page_id));
+
+  bpm->UnpinPage(page_id, false);
+  Page *page = bpm->CreatePage(page_id);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(0, page->GetData()[0]);
+  bpm->UnpinPage(page_id, true);
+  delete other_bpm;
+}
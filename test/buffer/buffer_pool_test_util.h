@@ -0,0 +1,98 @@
+#ifndef MINISQL_BUFFER_POOL_TEST_UTIL_H
+#define MINISQL_BUFFER_POOL_TEST_UTIL_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk_manager.h"
+
+/**
+ * @return the text the buffer pool tests put into a page, e.g. "page 7"
+ */
+inline std::string PageText(page_id_t page_id, const std::string &prefix = "page ") {
+  return prefix + std::to_string(page_id);
+}
+
+inline void SetPageText(char *data, page_id_t page_id, const std::string &prefix = "page ") {
+  std::string text = PageText(page_id, prefix);
+  memcpy(data, text.c_str(), text.size() + 1);
+}
+
+/**
+ * A db file with a buffer pool on it. The file is removed when the test starts and again when it ends, the pool and
+ * the disk manager are closed with it. Tests that restart the pool open it again.
+ */
+class TestBufferPool {
+ public:
+  explicit TestBufferPool(std::string db_name) : db_name_(std::move(db_name)) { remove(db_name_.c_str()); }
+
+  ~TestBufferPool() { Remove(); }
+
+  /**
+   * Open the db file and a pool made by make_pool on it, after closing the ones opened before
+   * @param make_pool called with the disk manager, returns the pool created with new
+   */
+  template <typename MakePool>
+  auto Open(MakePool make_pool, DiskIOMode io_mode = DiskIOMode::kPositional) {
+    Close();
+    disk_manager_ = new DiskManager(db_name_, io_mode);
+    auto *bpm = make_pool(disk_manager_);
+    bpm_ = bpm;
+    return bpm;
+  }
+
+  /**
+   * Open the db file and a pool of a single instance on it
+   */
+  BufferPoolManagerInstance *OpenInstance(size_t pool_size) {
+    return Open([pool_size](DiskManager *disk_manager) {
+      return new BufferPoolManagerInstance(pool_size, disk_manager);
+    });
+  }
+
+  void Close() {
+    delete bpm_;
+    bpm_ = nullptr;
+    if (disk_manager_ != nullptr) {
+      disk_manager_->Close();
+      delete disk_manager_;
+      disk_manager_ = nullptr;
+    }
+  }
+
+  /**
+   * Close the pool and remove the db file, the next Open starts with an empty one
+   */
+  void Remove() {
+    Close();
+    remove(db_name_.c_str());
+  }
+
+  /**
+   * Create num_pages pages holding their PageText, they are left unpinned and dirty. Use with ASSERT_NO_FATAL_FAILURE.
+   */
+  void NewPages(page_id_t num_pages) {
+    page_id_t page_id;
+    for (page_id_t i = 0; i < num_pages; i++) {
+      Page *page = bpm_->NewPage(page_id);
+      ASSERT_NE(nullptr, page);
+      SetPageText(page->GetData(), page_id);
+      ASSERT_TRUE(bpm_->UnpinPage(page_id, true));
+    }
+  }
+
+  inline const std::string &GetDbName() const { return db_name_; }
+
+  inline DiskManager *GetDiskManager() { return disk_manager_; }
+
+ private:
+  std::string db_name_;
+  DiskManager *disk_manager_{nullptr};
+  BufferPoolManager *bpm_{nullptr};
+};
+
+#endif  // MINISQL_BUFFER_POOL_TEST_UTIL_H
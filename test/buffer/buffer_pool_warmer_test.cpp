@@ -0,0 +1,88 @@
+#include "buffer/buffer_pool_warmer.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "buffer_pool_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+
+TEST(BufferPoolWarmerTest, PageListTest) {
+  const std::string file_name = ".warmer_test.db.warmup";
+  EXPECT_EQ(file_name, BufferPoolWarmer::GetFileName("warmer_test.db"));
+  EXPECT_EQ("./databases/.db0.warmup", BufferPoolWarmer::GetFileName("./databases/db0"));
+  remove(file_name.c_str());
+  std::vector<page_id_t> page_ids;
+  EXPECT_FALSE(BufferPoolWarmer::ReadPageList(file_name, &page_ids));
+  std::vector<page_id_t> expected = {7, 3, 100, 0};
+  ASSERT_TRUE(BufferPoolWarmer::WritePageList(file_name, expected));
+  ASSERT_TRUE(BufferPoolWarmer::ReadPageList(file_name, &page_ids));
+  EXPECT_EQ(expected, page_ids);
+  // a truncated list is not used
+  FILE *file = fopen(file_name.c_str(), "r+b");
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(0, ftruncate(fileno(file), 10));
+  fclose(file);
+  EXPECT_FALSE(BufferPoolWarmer::ReadPageList(file_name, &page_ids));
+  remove(file_name.c_str());
+}
+
+TEST(BufferPoolWarmerTest, SampleTest) {
+  const size_t buffer_pool_size = 64;
+  const page_id_t num_pages = 256;
+  TestBufferPool pool("warmer_test.db");
+  const std::string file_name = BufferPoolWarmer::GetFileName(pool.GetDbName());
+  remove(file_name.c_str());
+
+  // the second pool is split over instances, its list is an interleaving of theirs
+  for (int parallel = 0; parallel < 2; parallel++) {
+    BufferPoolManager *bpm = pool.OpenInstance(buffer_pool_size);
+    auto *warmer = new BufferPoolWarmer(bpm, file_name);
+    if (parallel == 0) {
+      // nothing to reload yet
+      EXPECT_EQ(0, warmer->WaitForLoad());
+      ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+    }
+    // the hot pages are the ones touched last
+    for (page_id_t i = 64; i < 64 + static_cast<page_id_t>(buffer_pool_size); i++) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+      bpm->UnpinPage(i, false);
+    }
+    std::vector<page_id_t> resident;
+    bpm->GetResidentPages(&resident);
+    ASSERT_EQ(buffer_pool_size, resident.size());
+    EXPECT_EQ(64 + static_cast<page_id_t>(buffer_pool_size) - 1, resident.front());
+    delete warmer;
+    std::vector<page_id_t> saved;
+    ASSERT_TRUE(BufferPoolWarmer::ReadPageList(file_name, &saved));
+    EXPECT_EQ(resident, saved);
+
+    // a restarted pool gets the same pages back before they are fetched
+    bpm = pool.Open([parallel](DiskManager *disk_manager) -> BufferPoolManager * {
+      if (parallel == 0) {
+        return new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+      }
+      return new ParallelBufferPoolManager(4, buffer_pool_size, disk_manager);
+    });
+    warmer = new BufferPoolWarmer(bpm, file_name);
+    EXPECT_EQ(buffer_pool_size, warmer->WaitForLoad());
+    resident.clear();
+    bpm->GetResidentPages(&resident);
+    std::sort(resident.begin(), resident.end());
+    std::sort(saved.begin(), saved.end());
+    EXPECT_EQ(saved, resident);
+    for (auto page_id : saved) {
+      Page *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page);
+      EXPECT_EQ(PageText(page_id), page->GetData());
+      bpm->UnpinPage(page_id, false);
+    }
+    delete warmer;
+  }
+  remove(file_name.c_str());
+}
@@ -0,0 +1,34 @@
+#include "buffer/checkpointer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer_pool_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+
+TEST(CheckpointerTest, SampleTest) {
+  const page_id_t num_pages = 16;
+  TestBufferPool pool("checkpointer_test.db");
+  auto *bpm = pool.OpenInstance(32);
+  ASSERT_NO_FATAL_FAILURE(pool.NewPages(num_pages));
+
+  // the dirty pages are written by the thread without anyone asking for it
+  BufferPoolSet pools(bpm);
+  auto *checkpointer = new Checkpointer(&pools, std::chrono::milliseconds(10));
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (checkpointer->GetNumCheckpoints() < 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_LE(2, checkpointer->GetNumCheckpoints());
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_FALSE(page->IsDirty());
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_EQ(0, bpm->Checkpoint());
+  delete checkpointer;
+}
@@ -1,43 +1,92 @@
-#include "buffer/clock_replacer.h"
-
-#include "gtest/gtest.h"
-
-TEST(CLOCKReplacerTest, SampleTest) {
-  CLOCKReplacer clock_replacer(7);
-
-  // Scenario: unpin six elements, i.e. add them to the replacer.
-  clock_replacer.Unpin(1);
-  clock_replacer.Unpin(2);
-  clock_replacer.Unpin(3);
-  clock_replacer.Unpin(4);
-  clock_replacer.Unpin(5);
-  clock_replacer.Unpin(6);
-  clock_replacer.Unpin(1);
-  EXPECT_EQ(6, clock_replacer.Size());
-
-  // Scenario: get three victims from the clock.
-  int value;
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(2, value);
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(3, value);
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(4, value);
-
-  // Scenario: pin elements in the replacer.
-  // Note that 3 has already been victimized, so pinning 3 should have no effect.
-  clock_replacer.Pin(4);
-  clock_replacer.Pin(5);
-  EXPECT_EQ(2, clock_replacer.Size());
-
-  // Scenario: unpin 5, the hand will point to 6 now
-  clock_replacer.Unpin(5);
-
-  // Scenario: continue looking for victims. We expect these victims.
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(6, value);
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(1, value);
-  clock_replacer.Victim(&value);
-  EXPECT_EQ(5, value);
-}
\ No newline at end of file
+#include "buffer/clock_replacer.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(CLOCKReplacerTest, SampleTest) {
+  CLOCKReplacer clock_replacer(7);
+
+  // Scenario: unpin six elements, i.e. add them to the replacer.
+  clock_replacer.Unpin(1);
+  clock_replacer.Unpin(2);
+  clock_replacer.Unpin(3);
+  clock_replacer.Unpin(4);
+  clock_replacer.Unpin(5);
+  clock_replacer.Unpin(6);
+  clock_replacer.Unpin(1);
+  EXPECT_EQ(6, clock_replacer.Size());
+
+  // Scenario: get three victims from the clock.
+  int value;
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(2, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(3, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(4, value);
+
+  // Scenario: pin elements in the replacer.
+  // Note that 3 has already been victimized, so pinning 3 should have no effect.
+  clock_replacer.Pin(4);
+  clock_replacer.Pin(5);
+  EXPECT_EQ(2, clock_replacer.Size());
+
+  // Scenario: unpin 5, it goes back to its own slot, which the hand points to now
+  clock_replacer.Unpin(5);
+
+  // Scenario: continue looking for victims. We expect these victims.
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(5, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(6, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(clock_replacer.Victim(&value));
+}
+
+TEST(CLOCKReplacerTest, VictimIfTest) {
+  CLOCKReplacer clock_replacer(4);
+  for (frame_id_t i = 0; i < 4; i++) {
+    clock_replacer.Unpin(i);
+  }
+  // accessed frames get a second chance, rejected frames stay in the clock
+  clock_replacer.RecordAccess(0);
+  int value;
+  ASSERT_TRUE(clock_replacer.VictimIf(&value, [](frame_id_t frame_id) { return frame_id != 1; }));
+  EXPECT_EQ(2, value);
+  std::vector<frame_id_t> victims;
+  clock_replacer.PeekVictims(4, &victims);
+  EXPECT_EQ(std::vector<frame_id_t>({3, 0, 1}), victims);
+  clock_replacer.Pin(3);
+  EXPECT_EQ(2, clock_replacer.Size());
+  EXPECT_FALSE(clock_replacer.VictimIf(&value, [](frame_id_t) { return false; }));
+  ASSERT_TRUE(clock_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+}
+TEST(CLOCKReplacerTest, ResizeWhileAccessedTest) {
+  CLOCKReplacer clock_replacer(16);
+  for (frame_id_t i = 0; i < 16; i++) {
+    clock_replacer.Unpin(i);
+  }
+  // hits keep setting ref bits while the clock grows and shrinks, the old arrays are freed under them
+  std::atomic<bool> stop{false};
+  std::thread hit([&] {
+    for (frame_id_t i = 0; !stop.load(); i = (i + 1) % 64) {
+      clock_replacer.RecordAccess(i);
+    }
+  });
+  for (int round = 0; round < 1000; round++) {
+    clock_replacer.Resize(round % 2 == 0 ? 64 : 16);
+  }
+  stop.store(true);
+  hit.join();
+  clock_replacer.Resize(16);
+  EXPECT_EQ(16, clock_replacer.Size());
+  int value;
+  for (int i = 0; i < 16; i++) {
+    ASSERT_TRUE(clock_replacer.Victim(&value));
+  }
+  EXPECT_FALSE(clock_replacer.Victim(&value));
+}
@@ -0,0 +1,278 @@
+#include "buffer/compressed_page_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/page_codec.h"
+#include "gtest/gtest.h"
+
+// rows of a text heavy table, with repeated words and distinct numbers
+static void FillTextPage(char *data, int seed) {
+  std::string text;
+  for (int i = 0; text.size() < PAGE_SIZE; i++) {
+    text += "row " + std::to_string(seed * 1000 + i) + " name customer#" + std::to_string((seed + i) % 97) +
+            " comment the quick brown fox jumps over the lazy dog;";
+  }
+  memcpy(data, text.data(), PAGE_SIZE);
+}
+
+TEST(CompressedPageCacheTest, CodecTest) {
+  std::mt19937 rng(7);
+  std::vector<std::vector<char>> pages;
+  pages.emplace_back(PAGE_SIZE, 0);
+  pages.emplace_back(PAGE_SIZE);
+  FillTextPage(pages.back().data(), 1);
+  pages.emplace_back(PAGE_SIZE);
+  for (auto &c : pages.back()) {
+    c = static_cast<char>(rng());
+  }
+  // the worst case grows by a byte per 255 literals
+  const size_t capacity = PAGE_SIZE + PAGE_SIZE / 255 + 16;
+  std::vector<char> compressed(capacity);
+  std::vector<char> decompressed(PAGE_SIZE);
+  std::vector<size_t> sizes;
+  for (auto &page : pages) {
+    size_t size = PageCodec::Compress(page.data(), PAGE_SIZE, compressed.data(), capacity);
+    ASSERT_NE(0, size);
+    sizes.push_back(size);
+    ASSERT_TRUE(PageCodec::Decompress(compressed.data(), size, decompressed.data(), PAGE_SIZE));
+    EXPECT_EQ(page, decompressed);
+    // truncated data or the wrong size are detected
+    EXPECT_FALSE(PageCodec::Decompress(compressed.data(), size - 1, decompressed.data(), PAGE_SIZE));
+    EXPECT_FALSE(PageCodec::Decompress(compressed.data(), size, decompressed.data(), PAGE_SIZE - 1));
+  }
+  EXPECT_GT(PAGE_SIZE / 50, sizes[0]);
+  EXPECT_GT(PAGE_SIZE / 2, sizes[1]);
+  EXPECT_LT(PAGE_SIZE, sizes[2]);
+  // data that does not fit is dropped
+  EXPECT_EQ(0, PageCodec::Compress(pages[2].data(), PAGE_SIZE, compressed.data(), PAGE_SIZE / 2));
+  // inputs too short to hold a match
+  const char short_input[] = "minisql";
+  size_t size = PageCodec::Compress(short_input, sizeof(short_input), compressed.data(), capacity);
+  ASSERT_NE(0, size);
+  ASSERT_TRUE(PageCodec::Decompress(compressed.data(), size, decompressed.data(), sizeof(short_input)));
+  EXPECT_STREQ(short_input, decompressed.data());
+}
+
+TEST(CompressedPageCacheTest, SampleTest) {
+  char data[PAGE_SIZE];
+  char random_data[PAGE_SIZE];
+  std::mt19937 rng(11);
+  for (auto &c : random_data) {
+    c = static_cast<char>(rng());
+  }
+  // the pages are tagged with the address of the pool that puts them
+  int pool;
+  CompressedPageCache cache(8 * PAGE_SIZE);
+  // pages that do not shrink are not kept
+  EXPECT_FALSE(cache.Put(0, random_data, false, &pool));
+  for (page_id_t i = 0; i < 8; i++) {
+    FillTextPage(data, i);
+    ASSERT_TRUE(cache.Put(i, data, false, &pool));
+  }
+  EXPECT_EQ(8, cache.GetNumPages());
+  EXPECT_GE(cache.GetCapacity(), cache.GetSize());
+
+  // a hit takes the page out
+  char expected[PAGE_SIZE];
+  FillTextPage(expected, 3);
+  ASSERT_TRUE(cache.Take(3, data, &pool));
+  EXPECT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+  EXPECT_FALSE(cache.Take(3, data, &pool));
+  EXPECT_EQ(1, cache.GetNumHits());
+  EXPECT_EQ(1, cache.GetNumMisses());
+  cache.Erase(4);
+  EXPECT_FALSE(cache.Take(4, data, &pool));
+
+  // the least recently put pages go first
+  size_t num_pages = cache.GetNumPages();
+  cache.SetCapacity(cache.GetSize() / 2);
+  EXPECT_GT(num_pages, cache.GetNumPages());
+  EXPECT_FALSE(cache.Take(0, data, &pool));
+  FillTextPage(expected, 7);
+  ASSERT_TRUE(cache.Take(7, data, &pool));
+  EXPECT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+  cache.SetCapacity(0);
+  EXPECT_EQ(0, cache.GetNumPages());
+  EXPECT_EQ(0, cache.GetSize());
+  FillTextPage(data, 0);
+  EXPECT_FALSE(cache.Put(0, data, false, &pool));
+}
+
+TEST(CompressedPageCacheTest, StaleCopyTest) {
+  char data[PAGE_SIZE];
+  char fresh[PAGE_SIZE];
+  char stale[PAGE_SIZE];
+  FillTextPage(fresh, 1);
+  FillTextPage(stale, 2);
+  int pool;
+  int other_pool;
+  CompressedPageCache cache(8 * PAGE_SIZE);
+  // a page written back on eviction replaces the copy of another pool
+  ASSERT_TRUE(cache.Put(0, stale, false, &other_pool));
+  ASSERT_TRUE(cache.Put(0, fresh, true, &pool));
+  ASSERT_TRUE(cache.Take(0, data, &pool));
+  EXPECT_EQ(0, memcmp(fresh, data, PAGE_SIZE));
+  // a clean page that meets another copy may be the stale one, neither is served
+  ASSERT_TRUE(cache.Put(0, fresh, true, &pool));
+  EXPECT_FALSE(cache.Put(0, stale, false, &other_pool));
+  EXPECT_FALSE(cache.Take(0, data, &pool));
+  EXPECT_EQ(0, cache.GetNumPages());
+  // the copy of another pool is not served, it stays for that pool
+  ASSERT_TRUE(cache.Put(0, stale, false, &other_pool));
+  EXPECT_FALSE(cache.Take(0, data, &pool));
+  ASSERT_TRUE(cache.Take(0, data, &other_pool));
+  EXPECT_EQ(0, memcmp(stale, data, PAGE_SIZE));
+}
+
+TEST(CompressedPageCacheTest, BufferPoolTest) {
+  const std::string db_name = "compressed_page_cache_test.db";
+  const size_t buffer_pool_size = 16;
+  const page_id_t num_pages = 64;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  // room for every page that does not fit into the pool
+  CompressedPageCache cache(num_pages * PAGE_SIZE);
+  bpm->SetCompressedCache(&cache);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    FillTextPage(page->GetData(), page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  // the evicted pages were written back and kept compressed
+  EXPECT_EQ(num_pages - buffer_pool_size, cache.GetNumPages());
+  EXPECT_GT((num_pages - buffer_pool_size) * PAGE_SIZE / 2, cache.GetSize());
+
+  // a page in the second tier is not read from disk, which is proven by changing the db file behind its back
+  char data[PAGE_SIZE];
+  memset(data, 'x', PAGE_SIZE);
+  disk_manager->WritePage(0, data);
+  char expected[PAGE_SIZE];
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    FillTextPage(expected, i);
+    EXPECT_EQ(0, memcmp(expected, page->GetData(), PAGE_SIZE));
+    bpm->UnpinPage(i, false);
+  }
+  // the pages resident at first are evicted by the first fetches, so every fetch is a miss served by the second tier
+  EXPECT_EQ(num_pages, cache.GetNumHits());
+  EXPECT_EQ(0, cache.GetNumMisses());
+
+  // a deleted page is forgotten by the second tier as well
+  size_t num_cached = cache.GetNumPages();
+  ASSERT_TRUE(bpm->DeletePage(1));
+  EXPECT_EQ(num_cached - 1, cache.GetNumPages());
+  EXPECT_FALSE(cache.Take(1, data, bpm));
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(CompressedPageCacheTest, SharedByPoolsTest) {
+  const std::string db_name = "compressed_page_cache_test.db";
+  const size_t buffer_pool_size = 2;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  // e.g. the default pool holds a copy reloaded by the warmer of a page bound to the keep pool
+  auto *stale_bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  CompressedPageCache cache(16 * PAGE_SIZE);
+  stale_bpm->SetCompressedCache(&cache);
+  bpm->SetCompressedCache(&cache);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < 6; i++) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    FillTextPage(page->GetData(), 0);
+    bpm->UnpinPage(page_id, true);
+  }
+  bpm->FlushAllPages();
+  ASSERT_NE(nullptr, stale_bpm->FetchPage(0));
+  stale_bpm->UnpinPage(0, false);
+  // the page is changed and evicted, then the stale copy is evicted after it
+  Page *page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  FillTextPage(page->GetData(), 1);
+  bpm->UnpinPage(0, true);
+  for (page_id_t i = 1; i < 3; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    bpm->UnpinPage(i, false);
+  }
+  for (page_id_t i = 3; i < 5; i++) {
+    ASSERT_NE(nullptr, stale_bpm->FetchPage(i));
+    stale_bpm->UnpinPage(i, false);
+  }
+  char expected[PAGE_SIZE];
+  FillTextPage(expected, 1);
+  page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(0, memcmp(expected, page->GetData(), PAGE_SIZE));
+  bpm->UnpinPage(0, false);
+  delete stale_bpm;
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(CompressedPageCacheTest, StaleCopyAfterCapacityEvictionTest) {
+  const std::string db_name = "compressed_page_cache_test.db";
+  const size_t buffer_pool_size = 2;
+  const page_id_t num_pages = 12;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *stale_bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  // room for a few pages only
+  CompressedPageCache cache(PAGE_SIZE);
+  stale_bpm->SetCompressedCache(&cache);
+  bpm->SetCompressedCache(&cache);
+
+  page_id_t page_id;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    FillTextPage(page->GetData(), 0);
+    bpm->UnpinPage(page_id, true);
+  }
+  bpm->FlushAllPages();
+  ASSERT_NE(nullptr, stale_bpm->FetchPage(0));
+  stale_bpm->UnpinPage(0, false);
+  // the page is changed and written back on eviction, then its compressed copy is dropped for capacity
+  Page *page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  FillTextPage(page->GetData(), 1);
+  bpm->UnpinPage(0, true);
+  for (page_id_t i = 1; i < num_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+    bpm->UnpinPage(i, false);
+  }
+  ASSERT_GT(num_pages - 1 - static_cast<page_id_t>(buffer_pool_size), static_cast<page_id_t>(cache.GetNumPages()));
+  // the stale copy is evicted into the cache with nothing left to collide with
+  for (page_id_t i = num_pages - 2; i < num_pages; i++) {
+    ASSERT_NE(nullptr, stale_bpm->FetchPage(i));
+    stale_bpm->UnpinPage(i, false);
+  }
+  char expected[PAGE_SIZE];
+  FillTextPage(expected, 1);
+  page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(0, memcmp(expected, page->GetData(), PAGE_SIZE));
+  bpm->UnpinPage(0, false);
+  delete stale_bpm;
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,55 @@
+#include "buffer/concurrent_page_table.h"
+
+#include <random>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+TEST(ConcurrentPageTableTest, SampleTest) {
+  const size_t num_frames = 64;
+  ConcurrentPageTable page_table(num_frames);
+  frame_id_t frame_id;
+  EXPECT_FALSE(page_table.Find(0, &frame_id));
+  page_table.Insert(3, 1);
+  page_table.Insert(11, 2);
+  ASSERT_TRUE(page_table.Find(3, &frame_id));
+  EXPECT_EQ(1, frame_id);
+  ASSERT_TRUE(page_table.Find(11, &frame_id));
+  EXPECT_EQ(2, frame_id);
+  page_table.Erase(3);
+  EXPECT_FALSE(page_table.Find(3, &frame_id));
+  ASSERT_TRUE(page_table.Find(11, &frame_id));
+  EXPECT_EQ(2, frame_id);
+  // erasing a missing page does nothing
+  page_table.Erase(3);
+  ASSERT_TRUE(page_table.Find(11, &frame_id));
+}
+
+TEST(ConcurrentPageTableTest, RandomTest) {
+  const size_t num_frames = 256;
+  ConcurrentPageTable page_table(num_frames);
+  std::unordered_map<page_id_t, frame_id_t> expected;
+  std::mt19937 rng(0);
+  // page ids of one instance of a parallel buffer pool are a fixed stride apart
+  std::uniform_int_distribution<page_id_t> dist(0, 1023);
+  frame_id_t frame_id;
+  for (int i = 0; i < 100000; i++) {
+    page_id_t page_id = dist(rng) * 8;
+    if (expected.count(page_id) != 0) {
+      page_table.Erase(page_id);
+      expected.erase(page_id);
+    } else if (expected.size() < num_frames) {
+      page_table.Insert(page_id, i);
+      expected[page_id] = i;
+    }
+    if (i % 1000 == 0) {
+      for (page_id_t j = 0; j < 1024 * 8; j += 8) {
+        auto it = expected.find(j);
+        ASSERT_EQ(it != expected.end(), page_table.Find(j, &frame_id));
+        if (it != expected.end()) {
+          ASSERT_EQ(it->second, frame_id);
+        }
+      }
+    }
+  }
+}
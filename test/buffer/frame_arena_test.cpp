@@ -0,0 +1,29 @@
+#include "buffer/frame_arena.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+TEST(FrameArenaTest, SampleTest) {
+  // smaller than a huge page, and large enough for the huge page paths
+  for (size_t num_frames : {static_cast<size_t>(3), 2 * FrameArena::HUGE_PAGE_SIZE / PAGE_SIZE + 1}) {
+    FrameArena arena(num_frames);
+    for (size_t i = 0; i < num_frames; i++) {
+      char *frame = arena.GetFrame(i);
+      ASSERT_EQ(0, reinterpret_cast<uintptr_t>(frame) % PAGE_SIZE);
+      ASSERT_EQ(0, frame[0]);
+      ASSERT_EQ(0, frame[PAGE_SIZE - 1]);
+      frame[0] = static_cast<char>(i + 1);
+      frame[PAGE_SIZE - 1] = static_cast<char>(i + 1);
+    }
+    // frames do not overlap
+    for (size_t i = 0; i < num_frames; i++) {
+      EXPECT_EQ(static_cast<char>(i + 1), arena.GetFrame(i)[0]);
+      EXPECT_EQ(static_cast<char>(i + 1), arena.GetFrame(i)[PAGE_SIZE - 1]);
+    }
+    if (num_frames * PAGE_SIZE >= FrameArena::HUGE_PAGE_SIZE && !arena.IsHugeTLB()) {
+      // transparent huge pages need the frames to start at a huge page boundary
+      EXPECT_EQ(0, reinterpret_cast<uintptr_t>(arena.GetFrame(0)) % FrameArena::HUGE_PAGE_SIZE);
+    }
+  }
+}
@@ -0,0 +1,64 @@
+#include "buffer/lru_k_replacer.h"
+
+#include "gtest/gtest.h"
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2);
+
+  // Scenario: unpin six frames, then access frames 1 and 2 a second time.
+  for (frame_id_t i = 1; i <= 6; i++) {
+    lru_k_replacer.Unpin(i);
+  }
+  lru_k_replacer.Unpin(1);
+  lru_k_replacer.RecordAccess(1);
+  lru_k_replacer.RecordAccess(2);
+  // accesses to frames that are not in the replacer are ignored
+  lru_k_replacer.RecordAccess(0);
+  EXPECT_EQ(6, lru_k_replacer.Size());
+
+  // Scenario: frames accessed once go first, even though 1 and 2 were unpinned before them.
+  int value;
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  ASSERT_TRUE(lru_k_replacer.VictimIf(&value, [](frame_id_t frame_id) { return frame_id != 4; }));
+  EXPECT_EQ(5, value);
+  EXPECT_EQ(4, lru_k_replacer.Size());
+
+  // Scenario: frame 4 was skipped, it stays first in victim order.
+  std::vector<frame_id_t> victims;
+  lru_k_replacer.PeekVictims(3, &victims);
+  EXPECT_EQ(std::vector<frame_id_t>({4, 6, 1}), victims);
+
+  // Scenario: a third access to 1 makes its second most recent access newer than the one of 2.
+  lru_k_replacer.RecordAccess(1);
+  lru_k_replacer.Pin(4);
+  EXPECT_EQ(3, lru_k_replacer.Size());
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(6, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+TEST(LRUKReplacerTest, ScanResistanceTest) {
+  const frame_id_t num_frames = 16;
+  const frame_id_t num_hot_frames = 4;
+  LRUKReplacer lru_k_replacer(num_frames);
+  for (frame_id_t i = 0; i < num_hot_frames; i++) {
+    lru_k_replacer.Unpin(i);
+    lru_k_replacer.RecordAccess(i);
+  }
+  // a scan keeps replacing the remaining frames, the hot frames are never picked
+  for (frame_id_t i = num_hot_frames; i < num_frames; i++) {
+    lru_k_replacer.Unpin(i);
+  }
+  for (int i = 0; i < 100; i++) {
+    frame_id_t frame_id;
+    ASSERT_TRUE(lru_k_replacer.Victim(&frame_id));
+    ASSERT_LE(num_hot_frames, frame_id);
+    lru_k_replacer.Unpin(frame_id);
+  }
+}
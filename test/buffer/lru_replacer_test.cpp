@@ -33,6 +33,12 @@ TEST(LRUReplacerTest, SampleTest) {
   // Scenario: unpin 4. We expect that the reference bit of 4 will be set to 1.
   lru_replacer.Unpin(4);
 
+  // Scenario: the next victims can be looked at without removing them.
+  std::vector<frame_id_t> victims;
+  lru_replacer.PeekVictims(2, &victims);
+  EXPECT_EQ(std::vector<frame_id_t>({5, 6}), victims);
+  EXPECT_EQ(3, lru_replacer.Size());
+
   // Scenario: continue looking for victims. We expect these victims.
   lru_replacer.Victim(&value);
   EXPECT_EQ(5, value);
@@ -0,0 +1,149 @@
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(ParallelBufferPoolManagerTest, SampleTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const size_t num_instances = 4;
+  const size_t buffer_pool_size = 10;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, disk_manager);
+  EXPECT_EQ(buffer_pool_size, bpm->GetPoolSize());
+
+  // the frames are split 3, 3, 2, 2, so the pages of instance 0 and 1 run out last
+  std::vector<Page *> pages;
+  page_id_t page_id;
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); i++) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(i, page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", static_cast<int>(page_id));
+    pages.push_back(page);
+  }
+  // page 10 belongs to instance 2 which has no frame left, its id is given back
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  EXPECT_EQ(INVALID_PAGE_ID, page_id);
+  EXPECT_TRUE(bpm->IsPageFree(10));
+
+  // unpinning pages of instance 2 and 3 makes room for the next page
+  EXPECT_TRUE(bpm->UnpinPage(2, true));
+  EXPECT_TRUE(bpm->UnpinPage(3, true));
+  ASSERT_NE(nullptr, bpm->NewPage(page_id));
+  EXPECT_TRUE(page_id % num_instances == 2 || page_id % num_instances == 3);
+  EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+
+  // page 2 or 3 was written back and comes back through its instance
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); i++) {
+    if (i != 2 && i != 3) {
+      EXPECT_TRUE(bpm->UnpinPage(i, true));
+    }
+  }
+  std::vector<page_id_t> page_ids = {7, 2, 9, 3, 4};
+  std::vector<Page *> fetched = bpm->FetchPages(page_ids);
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    ASSERT_NE(nullptr, fetched[i]);
+    EXPECT_EQ(page_ids[i], fetched[i]->GetPageId());
+    EXPECT_EQ("page " + std::to_string(page_ids[i]), std::string(fetched[i]->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(page_ids[i], false));
+  }
+  EXPECT_TRUE(bpm->DeletePage(9));
+  EXPECT_TRUE(bpm->IsPageFree(9));
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, ConcurrentFetchTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const int num_threads = 8;
+  const int num_pages = 64;
+  const int rounds = 2000;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  // fewer frames than pages, so the threads keep evicting each other's pages
+  auto *bpm = new ParallelBufferPoolManager(4, 32, disk_manager);
+  page_id_t page_id;
+  for (int i = 0; i < num_pages; i++) {
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    *reinterpret_cast<int *>(page->GetData()) = 0;
+    bpm->UnpinPage(page_id, true);
+  }
+
+  // every thread increments its own counter on every page, the slot is only written by one thread
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < rounds; i++) {
+        page_id_t id = (i * 7 + t) % num_pages;
+        Page *page = bpm->FetchPage(id);
+        if (page == nullptr) {
+          continue;
+        }
+        page->WLatch();
+        reinterpret_cast<int *>(page->GetData())[t + 1]++;
+        page->WUnlatch();
+        bpm->UnpinPage(id, true);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  int total = 0;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    for (int t = 0; t < num_threads; t++) {
+      total += reinterpret_cast<int *>(page->GetData())[t + 1];
+    }
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_EQ(num_threads * rounds, total);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, ResizeTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const size_t num_instances = 4;
+  const size_t buffer_pool_size = 64;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, buffer_pool_size, disk_manager);
+  page_id_t page_id;
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    // the pages of instance 2 stay pinned
+    if (page_id % num_instances != 2) {
+      bpm->UnpinPage(page_id, false);
+    }
+  }
+  // instance 2 cannot shrink, the instances shrunk before it grow back
+  EXPECT_FALSE(bpm->Resize(buffer_pool_size / 2));
+  EXPECT_EQ(buffer_pool_size, bpm->GetPoolSize());
+  for (page_id_t i = 2; i < static_cast<page_id_t>(buffer_pool_size); i += num_instances) {
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_TRUE(bpm->Resize(buffer_pool_size / 2));
+  EXPECT_EQ(buffer_pool_size / 2, bpm->GetPoolSize());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,42 @@
+#include "buffer/read_ahead_detector.h"
+
+#include "gtest/gtest.h"
+
+TEST(ReadAheadDetectorTest, SampleTest) {
+  ReadAheadDetector read_ahead(8, 2);
+
+  // Scenario: a single access only prefetches the next page of the chain.
+  EXPECT_EQ(std::vector<page_id_t>({11}), read_ahead.OnAccess(10, 11));
+  EXPECT_TRUE(read_ahead.OnAccess(20).empty());
+
+  // Scenario: consecutive pages prefetch the whole window.
+  EXPECT_EQ(std::vector<page_id_t>({22, 23, 24, 25, 26, 27, 28, 29}), read_ahead.OnAccess(21, 22));
+
+  // Scenario: the next batch is issued once less than half of the window is left.
+  for (page_id_t page_id = 22; page_id <= 25; page_id++) {
+    EXPECT_TRUE(read_ahead.OnAccess(page_id, page_id + 1).empty());
+  }
+  EXPECT_EQ(std::vector<page_id_t>({30, 31, 32, 33, 34}), read_ahead.OnAccess(26, 27));
+
+  // Scenario: a jump ends the sequential run.
+  EXPECT_EQ(std::vector<page_id_t>({3}), read_ahead.OnAccess(5, 3));
+  EXPECT_EQ(std::vector<page_id_t>({7, 8, 9, 10, 11, 12, 13, 14}), read_ahead.OnAccess(6, 7));
+}
+
+TEST(ReadAheadDetectorTest, OwnedPagesTest) {
+  ReadAheadDetector read_ahead(8, 2);
+
+  // Scenario: the window stops at the end of the run of the object, e.g. the pages after it belong to another table.
+  EXPECT_EQ(std::vector<page_id_t>({11}), read_ahead.OnAccess(10, 11, 14));
+  EXPECT_EQ(std::vector<page_id_t>({12, 13}), read_ahead.OnAccess(11, 12, 14));
+  EXPECT_TRUE(read_ahead.OnAccess(12, 13, 14).empty());
+
+  // Scenario: at the end of the run the chain goes on in the next run of the object.
+  EXPECT_EQ(std::vector<page_id_t>({40}), read_ahead.OnAccess(13, 40, 14));
+  EXPECT_EQ(std::vector<page_id_t>({41}), read_ahead.OnAccess(40, 41, 48));
+  EXPECT_EQ(std::vector<page_id_t>({42, 43, 44, 45, 46, 47}), read_ahead.OnAccess(41, 42, 48));
+
+  // Scenario: a page outside the known runs only prefetches the next page of the chain.
+  EXPECT_EQ(std::vector<page_id_t>({60}), read_ahead.OnAccess(59, 60, 60));
+  EXPECT_EQ(std::vector<page_id_t>({61}), read_ahead.OnAccess(60, 61, 61));
+}
@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "utils/utils.h"
 
+#include <algorithm>
 #include <cstring>
 
 static string db_file_name = "catalog_test.db";
@@ -128,4 +129,89 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, CatalogPoolTest) {
+  auto is_resident = [](BufferPoolManager *bpm, page_id_t page_id) {
+    std::vector<page_id_t> resident;
+    bpm->GetResidentPages(&resident);
+    return std::find(resident.begin(), resident.end(), page_id) != resident.end();
+  };
+  /** Stage 1: Binding a table and an index to other pools */
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  // the rows take more than one table page whatever the page size
+  const int row_nums = 300 * PAGE_SIZE / 4096;
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+  std::vector<page_id_t> table_pages, index_pages;
+  table_info->GetTableHeap()->GetPageIds(&table_pages);
+  index_info->GetIndex()->GetPageIds(&index_pages);
+  ASSERT_LT(1, table_pages.size());
+  ASSERT_LE(1, index_pages.size());
+  EXPECT_TRUE(is_resident(db_01->bpm_, index_pages[0]));
+
+  ASSERT_EQ(DB_INDEX_NOT_FOUND, catalog_01->SetIndexPool("table-1", "index-0", BufferPoolId::kKeep));
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_01->SetTablePool("table-0", BufferPoolId::kKeep));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->SetIndexPool("table-1", "index-1", BufferPoolId::kKeep));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->SetTablePool("table-1", BufferPoolId::kRecycle));
+  for (auto page_id : index_pages) {
+    EXPECT_FALSE(is_resident(db_01->bpm_, page_id));
+  }
+  // the pages come back through the pools they are bound to
+  std::vector<RowId> ret;
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row key(fields);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, ret, &txn));
+  }
+  ASSERT_EQ(row_nums, ret.size());
+  int rows = 0;
+  for (auto it = table_info->GetTableHeap()->Begin(&txn); it != table_info->GetTableHeap()->End(); ++it) {
+    rows++;
+  }
+  ASSERT_EQ(row_nums, rows);
+  for (auto page_id : index_pages) {
+    EXPECT_TRUE(is_resident(db_01->keep_bpm_, page_id));
+    EXPECT_FALSE(is_resident(db_01->bpm_, page_id));
+  }
+  for (auto page_id : table_pages) {
+    EXPECT_TRUE(is_resident(db_01->recycle_bpm_, page_id));
+    EXPECT_FALSE(is_resident(db_01->bpm_, page_id));
+  }
+  // a table in use cannot be moved
+  ASSERT_NE(nullptr, db_01->recycle_bpm_->FetchPage(table_pages[0]));
+  ASSERT_EQ(DB_FAILED, catalog_01->SetTablePool("table-1", BufferPoolId::kDefault));
+  db_01->recycle_bpm_->UnpinPage(table_pages[0], false);
+  delete db_01;
+
+  /** Stage 2: The binding is kept in the metadata */
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("table-1", table_info));
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "index-1", index_info));
+  EXPECT_EQ(BufferPoolId::kRecycle, table_info->GetTableMeta()->GetPoolId());
+  EXPECT_EQ(BufferPoolId::kKeep, index_info->GetIndexMeta()->GetPoolId());
+  ret.clear();
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row key(fields);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, ret, &txn));
+  }
+  ASSERT_EQ(row_nums, ret.size());
+  for (auto page_id : index_pages) {
+    EXPECT_TRUE(is_resident(db_02->keep_bpm_, page_id));
+  }
+  delete db_02;
+}
@@ -0,0 +1,159 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/futex_rwlatch.h"
+#include "common/rwlatch.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+/**
+ * Writers move a unit from one counter to the other, readers check that no unit is lost in between.
+ */
+template <typename Latch>
+static void CheckExclusion(int num_readers, int num_writers, int ops_per_thread) {
+  Latch latch;
+  int64_t from = ops_per_thread * num_writers;
+  int64_t to = 0;
+  std::atomic<int> num_torn{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_writers; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < ops_per_thread; j++) {
+        latch.WLock();
+        from--;
+        to++;
+        latch.WUnlock();
+      }
+    });
+  }
+  for (int i = 0; i < num_readers; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < ops_per_thread; j++) {
+        latch.RLock();
+        if (from + to != ops_per_thread * num_writers) {
+          num_torn++;
+        }
+        latch.RUnlock();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, num_torn.load());
+  EXPECT_EQ(0, from);
+  EXPECT_EQ(ops_per_thread * num_writers, to);
+}
+
+TEST(RWLatchTest, ExclusionTest) {
+  CheckExclusion<ReaderWriterLatch>(4, 4, 20000);
+  CheckExclusion<FutexReaderWriterLatch>(4, 4, 20000);
+  // more threads than cores, waiting threads go to sleep
+  CheckExclusion<FutexReaderWriterLatch>(16, 16, 5000);
+}
+
+TEST(RWLatchTest, WriterPreferenceTest) {
+  FutexReaderWriterLatch latch;
+  std::atomic<int> order{0};
+  int writer_order = 0;
+  int reader_order = 0;
+  latch.RLock();
+  std::thread writer([&]() {
+    latch.WLock();
+    writer_order = ++order;
+    latch.WUnlock();
+  });
+  // the writer waits for the reader holding the latch
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(0, order.load());
+  std::thread reader([&]() {
+    latch.RLock();
+    reader_order = ++order;
+    latch.RUnlock();
+  });
+  // the new reader does not get in ahead of the waiting writer
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(0, order.load());
+  latch.RUnlock();
+  writer.join();
+  reader.join();
+  EXPECT_EQ(1, writer_order);
+  EXPECT_EQ(2, reader_order);
+}
+
+/**
+ * @return average nanoseconds of a lock and unlock pair taken by one thread alone
+ */
+template <typename Latch>
+static double UncontendedCost(bool write, int num_ops) {
+  Latch latch;
+  auto start_time = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_ops; i++) {
+    if (write) {
+      latch.WLock();
+      latch.WUnlock();
+    } else {
+      latch.RLock();
+      latch.RUnlock();
+    }
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop_time - start_time).count() / num_ops;
+}
+
+/**
+ * Threads take one latch, one lock in write_share for writing and the others for reading.
+ * @return lock and unlock pairs per second over all threads
+ */
+template <typename Latch>
+static double ContendedThroughput(int num_threads, int write_share, int ops_per_thread) {
+  Latch latch;
+  volatile int64_t value = 0;
+  std::vector<std::thread> threads;
+  auto start_time = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < ops_per_thread; i++) {
+        if ((i + t) % write_share == 0) {
+          latch.WLock();
+          value = value + 1;
+          latch.WUnlock();
+        } else {
+          latch.RLock();
+          [[maybe_unused]] int64_t read = value;
+          latch.RUnlock();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  return num_threads * ops_per_thread / std::chrono::duration<double>(stop_time - start_time).count();
+}
+
+TEST(RWLatchTest, PerformanceTest) {
+  const int num_ops = 1 << 22;
+  for (bool write : {false, true}) {
+    LOG(INFO) << "uncontended " << (write ? "write" : "read") << ": mutex " << UncontendedCost<ReaderWriterLatch>(
+                                                                                   write, num_ops)
+              << " ns, futex " << UncontendedCost<FutexReaderWriterLatch>(write, num_ops) << " ns";
+  }
+  const int total_ops = 1 << 20;
+  for (int num_threads : {2, 4, 16}) {
+    for (int write_share : {2, 10, 100}) {
+      double mutex_throughput = ContendedThroughput<ReaderWriterLatch>(num_threads, write_share,
+                                                                       total_ops / num_threads);
+      double futex_throughput = ContendedThroughput<FutexReaderWriterLatch>(num_threads, write_share,
+                                                                            total_ops / num_threads);
+      LOG(INFO) << num_threads << " thread(s), 1/" << write_share
+                << " writes: mutex " << static_cast<uint64_t>(mutex_throughput) << " ops/s, futex "
+                << static_cast<uint64_t>(futex_throughput) << " ops/s";
+    }
+  }
+  LOG(INFO) << "size: mutex " << sizeof(ReaderWriterLatch) << " bytes, futex " << sizeof(FutexReaderWriterLatch)
+            << " bytes";
+}
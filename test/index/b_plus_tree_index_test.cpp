@@ -29,7 +29,7 @@ TEST(BPlusTreeTests, BPlusTreeIndexGenericKeyTest) {
 
 TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
   auto disk_mgr_ = new DiskManager(db_name);
-  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
   page_id_t id;
   if (bpm_->IsPageFree(CATALOG_META_PAGE_ID)) {
     if (bpm_->NewPage(id) == nullptr || id != CATALOG_META_PAGE_ID) {
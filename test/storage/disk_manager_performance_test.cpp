@@ -0,0 +1,273 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+#include "storage/async_io.h"
+#include "storage/disk_manager.h"
+
+static const std::string db_file_name = "disk_manager_performance_test.db";
+
+/**
+ * Read random pages from several threads at the same time.
+ * @return number of pages read per second
+ */
+static double RandomReadThroughput(DiskManager *disk_mgr, uint32_t num_pages, int num_threads, int reads_per_thread) {
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatch{0};
+  auto start_time = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<uint32_t> dist(0, num_pages - 1);
+      char buf[PAGE_SIZE];
+      for (int i = 0; i < reads_per_thread; i++) {
+        page_id_t page_id = dist(rng);
+        disk_mgr->ReadPage(page_id, buf);
+        if (*reinterpret_cast<page_id_t *>(buf) != page_id) {
+          mismatch++;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  EXPECT_EQ(0, mismatch.load());
+  double seconds = std::chrono::duration<double>(stop_time - start_time).count();
+  return num_threads * reads_per_thread / seconds;
+}
+
+TEST(DiskManagerPerformanceTest, RandomReadThroughputTest) {
+  const uint32_t num_pages = 4096;
+  const int total_reads = 1 << 15;
+  remove(db_file_name.c_str());
+  {
+    // fill the db file, every page starts with its own page id
+    DiskManager disk_mgr(db_file_name);
+    char buf[PAGE_SIZE] = {0};
+    for (uint32_t i = 0; i < num_pages; i++) {
+      page_id_t page_id = disk_mgr.AllocatePage();
+      ASSERT_EQ(i, page_id);
+      *reinterpret_cast<page_id_t *>(buf) = page_id;
+      disk_mgr.WritePage(page_id, buf);
+    }
+    disk_mgr.Close();
+  }
+
+  for (auto io_mode : {DiskIOMode::kFstream, DiskIOMode::kPositional}) {
+    DiskManager disk_mgr(db_file_name, io_mode);
+    const char *mode_name = io_mode == DiskIOMode::kFstream ? "fstream" : "pread";
+    for (int num_threads : {1, 4, 16}) {
+      double throughput = RandomReadThroughput(&disk_mgr, num_pages, num_threads, total_reads / num_threads);
+      LOG(INFO) << "[" << mode_name << "] " << num_threads << " thread(s): " << static_cast<uint64_t>(throughput)
+                << " pages/s";
+    }
+    disk_mgr.Close();
+  }
+  remove(db_file_name.c_str());
+}
+
+/**
+ * Write pages in random order and commit every commit_size writes.
+ * @return number of pages written per second
+ */
+static double CommitWriteThroughput(DiskManager *disk_mgr, uint32_t num_pages, uint32_t commit_size) {
+  std::vector<page_id_t> page_ids(num_pages);
+  for (uint32_t i = 0; i < num_pages; i++) {
+    page_ids[i] = i;
+  }
+  std::shuffle(page_ids.begin(), page_ids.end(), std::mt19937(0));
+  char buf[PAGE_SIZE] = {0};
+  auto start_time = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < num_pages; i++) {
+    *reinterpret_cast<page_id_t *>(buf) = page_ids[i];
+    disk_mgr->WritePage(page_ids[i], buf);
+    if ((i + 1) % commit_size == 0) {
+      disk_mgr->Sync();
+    }
+  }
+  disk_mgr->Sync();
+  auto stop_time = std::chrono::steady_clock::now();
+  return num_pages / std::chrono::duration<double>(stop_time - start_time).count();
+}
+
+TEST(DiskManagerPerformanceTest, GroupCommitWriteThroughputTest) {
+  const uint32_t num_pages = 4096;
+  for (auto durability : {DurabilityMode::kWriteThrough, DurabilityMode::kGroupCommit}) {
+    remove(db_file_name.c_str());
+    DiskManager disk_mgr(db_file_name, DiskIOMode::kPositional, durability);
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(i, disk_mgr.AllocatePage());
+    }
+    const char *mode_name = durability == DurabilityMode::kWriteThrough ? "write-through" : "group commit";
+    for (uint32_t commit_size : {16, 256}) {
+      double throughput = CommitWriteThroughput(&disk_mgr, num_pages, commit_size);
+      LOG(INFO) << "[" << mode_name << "] commit every " << commit_size
+                << " pages: " << static_cast<uint64_t>(throughput) << " pages/s";
+    }
+    // every page holds its own id no matter how the writes were issued
+    char buf[PAGE_SIZE];
+    for (uint32_t i = 0; i < num_pages; i++) {
+      disk_mgr.ReadPage(i, buf);
+      ASSERT_EQ(i, *reinterpret_cast<page_id_t *>(buf));
+    }
+    disk_mgr.Close();
+  }
+  remove(db_file_name.c_str());
+}
+
+/**
+ * Keep queue_depth random page reads in flight until num_reads reads completed.
+ * @return number of pages read per second
+ */
+static double QueueDepthReadThroughput(AsyncIOEngine *engine, int fd, uint32_t num_pages, size_t queue_depth,
+                                       int num_reads) {
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<uint32_t> dist(0, num_pages - 1);
+  std::vector<std::unique_ptr<char[]>> bufs;
+  std::vector<uint32_t> slot_pages(queue_depth);
+  std::vector<IOHandle> handles(queue_depth);
+  int mismatch = 0;
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < queue_depth; i++) {
+    bufs.emplace_back(new char[PAGE_SIZE]);
+    slot_pages[i] = dist(rng);
+    handles[i] = engine->Read(fd, bufs[i].get(), static_cast<size_t>(slot_pages[i]) * PAGE_SIZE);
+  }
+  for (int i = 0; i < num_reads; i++) {
+    size_t slot = i % queue_depth;
+    EXPECT_TRUE(handles[slot].get());
+    if (*reinterpret_cast<uint32_t *>(bufs[slot].get()) != slot_pages[slot]) {
+      mismatch++;
+    }
+    if (i + queue_depth < static_cast<size_t>(num_reads)) {
+      slot_pages[slot] = dist(rng);
+      handles[slot] = engine->Read(fd, bufs[slot].get(), static_cast<size_t>(slot_pages[slot]) * PAGE_SIZE);
+    }
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  EXPECT_EQ(0, mismatch);
+  return num_reads / std::chrono::duration<double>(stop_time - start_time).count();
+}
+
+TEST(DiskManagerPerformanceTest, AsyncQueueDepthTest) {
+  const std::string file_name = "async_io_performance_test.db";
+  const uint32_t num_pages = 32768;  // 128 MB with 4 KB pages
+  const int num_reads = 4096;
+  {
+    // every page starts with its own index
+    int fd = open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    char buf[PAGE_SIZE] = {0};
+    for (uint32_t i = 0; i < num_pages; i++) {
+      *reinterpret_cast<uint32_t *>(buf) = i;
+      ASSERT_EQ(PAGE_SIZE, pwrite(fd, buf, PAGE_SIZE, static_cast<size_t>(i) * PAGE_SIZE));
+    }
+    fdatasync(fd);
+    close(fd);
+  }
+
+  int fd = open(file_name.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  std::vector<std::pair<std::string, std::unique_ptr<AsyncIOEngine>>> engines;
+  engines.emplace_back("thread pool", std::make_unique<ThreadPoolIOEngine>(8));
+#ifdef MINISQL_HAVE_IO_URING
+  auto io_uring_engine = IOUringEngine::Create(64);
+  if (io_uring_engine != nullptr) {
+    engines.emplace_back("io_uring", std::move(io_uring_engine));
+  }
+#endif
+  for (auto &engine : engines) {
+    for (size_t queue_depth : {1, 4, 16, 64}) {
+      // drop the file from the page cache so that the reads go to the device
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      double throughput = QueueDepthReadThroughput(engine.second.get(), fd, num_pages, queue_depth, num_reads);
+      LOG(INFO) << "[" << engine.first << "] queue depth " << queue_depth << ": " << static_cast<uint64_t>(throughput)
+                << " pages/s";
+    }
+  }
+  engines.clear();
+  close(fd);
+  remove(file_name.c_str());
+}
+
+/**
+ * @return number of bytes of specific file held in the kernel page cache
+ */
+static size_t PageCacheResidentBytes(const std::string &file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  size_t file_size = lseek(fd, 0, SEEK_END);
+  size_t os_page_size = sysconf(_SC_PAGESIZE);
+  void *ptr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  std::vector<unsigned char> resident((file_size + os_page_size - 1) / os_page_size);
+  mincore(ptr, file_size, resident.data());
+  size_t num_resident = std::count_if(resident.begin(), resident.end(), [](unsigned char v) { return v & 1; });
+  munmap(ptr, file_size);
+  close(fd);
+  return num_resident * os_page_size;
+}
+
+TEST(DiskManagerPerformanceTest, DirectIOMemoryTest) {
+  const uint32_t num_pages = 16384;  // 64 MB with 4 KB pages
+  const size_t buffer_pool_size = 2048;
+  const int num_fetches = 1 << 15;
+  remove(db_file_name.c_str());
+  {
+    DiskManager disk_mgr(db_file_name);
+    char buf[PAGE_SIZE] = {0};
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(i, disk_mgr.AllocatePage());
+      *reinterpret_cast<page_id_t *>(buf) = i;
+      disk_mgr.WritePage(i, buf);
+    }
+    disk_mgr.Close();
+  }
+
+  for (auto io_mode : {DiskIOMode::kPositional, DiskIOMode::kDirect}) {
+    // start from a cold page cache
+    int fd = open(db_file_name.c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+    DiskManager disk_mgr(db_file_name, io_mode);
+    auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, &disk_mgr);
+    // random fetches over a working set larger than the pool, every tenth page gets modified
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+    int mismatch = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_fetches; i++) {
+      page_id_t page_id = dist(rng);
+      Page *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page);
+      if (*reinterpret_cast<page_id_t *>(page->GetData()) != page_id) {
+        mismatch++;
+      }
+      bpm->UnpinPage(page_id, i % 10 == 0);
+    }
+    auto stop_time = std::chrono::steady_clock::now();
+    delete bpm;
+    disk_mgr.Close();
+    EXPECT_EQ(0, mismatch);
+    double throughput = num_fetches / std::chrono::duration<double>(stop_time - start_time).count();
+    size_t cached = PageCacheResidentBytes(db_file_name);
+    const char *mode_name = disk_mgr.GetIOMode() == DiskIOMode::kDirect ? "O_DIRECT" : "buffered";
+    LOG(INFO) << "[" << mode_name << "] " << static_cast<uint64_t>(throughput) << " fetches/s, buffer pool "
+              << buffer_pool_size * PAGE_SIZE / 1024 << " KB + page cache " << cached / 1024 << " KB";
+    if (disk_mgr.GetIOMode() == DiskIOMode::kDirect) {
+      // pages moved with O_DIRECT never enter the page cache
+      EXPECT_LT(cached, buffer_pool_size * PAGE_SIZE);
+    }
+  }
+  remove(db_file_name.c_str());
+}
@@ -1,5 +1,7 @@
 #include "storage/disk_manager.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <unordered_set>
 
 #include "gtest/gtest.h"
@@ -111,7 +113,7 @@ TEST(DiskManagerTest, DISABLED_ExtentPageAllocationTest) {
   EXPECT_EQ(DiskManager::BITMAP_SIZE, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(1, meta_page->GetExtentUsedPage(1));
 
-  // 释放第一个分区的100个页面后，继续分配100个新页，验证这些页仍然分配在第二个分区
+  // 释放第一个分区的100个页面后，继续分配100个新页，验证这些页复用第一个分区中被释放的页
   for (uint32_t i = 0; i < 100; i++) {
     disk_mgr->DeAllocatePage(i);
   }
@@ -120,14 +122,381 @@ TEST(DiskManagerTest, DISABLED_ExtentPageAllocationTest) {
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 100, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(1, meta_page->GetExtentUsedPage(1));
 
-  // 分配100个新页，验证都在第二个分区
+  // 分配100个新页，验证都在第一个分区
   for (int i = 0; i < 100; i++) {
     page_id_t page_id = disk_mgr->AllocatePage();
-    EXPECT_EQ(DiskManager::BITMAP_SIZE + 1 + i, page_id);
+    EXPECT_EQ(i, page_id);
   }
   meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
   EXPECT_EQ(2, meta_page->GetExtentNums());
   EXPECT_EQ(DiskManager::BITMAP_SIZE + 1, meta_page->GetAllocatedPages());
-  EXPECT_EQ(DiskManager::BITMAP_SIZE - 100, meta_page->GetExtentUsedPage(0));
-  EXPECT_EQ(101, meta_page->GetExtentUsedPage(1));
-}
\ No newline at end of file
+  EXPECT_EQ(DiskManager::BITMAP_SIZE, meta_page->GetExtentUsedPage(0));
+  EXPECT_EQ(1, meta_page->GetExtentUsedPage(1));
+}
+
+TEST(DiskManagerTest, FreePageReuseAndShrinkTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  const uint32_t extent_nums = 3;
+  for (uint32_t i = 0; i < DiskManager::BITMAP_SIZE * extent_nums; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  // pages freed in earlier extents are reused before a new extent is opened
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 7);
+  disk_mgr->DeAllocatePage(3);
+  EXPECT_EQ(3, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 7, disk_mgr->AllocatePage());
+  EXPECT_EQ(extent_nums, meta_page->GetExtentNums());
+
+  // nothing to release while the last extent is in use
+  disk_mgr->DeAllocatePage(0);
+  EXPECT_EQ(0, disk_mgr->Shrink());
+
+  // free the last two extents, only they are released
+  for (uint32_t i = DiskManager::BITMAP_SIZE; i < DiskManager::BITMAP_SIZE * extent_nums; i++) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  EXPECT_EQ(2, disk_mgr->Shrink());
+  EXPECT_EQ(1, meta_page->GetExtentNums());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE - 1, meta_page->GetAllocatedPages());
+  EXPECT_GE((2 + DiskManager::BITMAP_SIZE) * PAGE_SIZE, std::filesystem::file_size(db_name));
+  EXPECT_EQ(0, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE, disk_mgr->AllocatePage());
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  disk_mgr->Close();
+  delete disk_mgr;
+
+  disk_mgr = new DiskManager(db_name);
+  meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 1, meta_page->GetAllocatedPages());
+  EXPECT_FALSE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 1));
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, BitmapPersistenceTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const uint32_t num_pages = DiskManager::BITMAP_SIZE + 10;
+  for (uint32_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  disk_mgr->DeAllocatePage(5);
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 5);
+  EXPECT_TRUE(disk_mgr->IsPageFree(5));
+  EXPECT_FALSE(disk_mgr->IsPageFree(6));
+  EXPECT_TRUE(disk_mgr->IsPageFree(num_pages));
+  disk_mgr->Close();
+  delete disk_mgr;
+
+  // bitmaps are written back on close and loaded again on open
+  disk_mgr = new DiskManager(db_name);
+  for (uint32_t i = 0; i < num_pages; i++) {
+    bool expect_free = (i == 5 || i == DiskManager::BITMAP_SIZE + 5);
+    EXPECT_EQ(expect_free, disk_mgr->IsPageFree(i));
+  }
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  EXPECT_EQ(num_pages - 2, meta_page->GetAllocatedPages());
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, GroupCommitTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name, DiskIOMode::kPositional, DurabilityMode::kGroupCommit);
+  ASSERT_EQ(DurabilityMode::kGroupCommit, disk_mgr->GetDurabilityMode());
+  // more than one batch, so some of the writes are issued before the explicit Sync()
+  const uint32_t num_pages = DiskManager::GROUP_COMMIT_BATCH_SIZE * 2 + 10;
+  char buf[PAGE_SIZE] = {0};
+  for (uint32_t i = 0; i < num_pages; i++) {
+    page_id_t page_id = disk_mgr->AllocatePage();
+    *reinterpret_cast<uint32_t *>(buf) = page_id;
+    disk_mgr->WritePage(page_id, buf);
+  }
+  // overwrite a page that is still queued, the queued image is read back
+  *reinterpret_cast<uint32_t *>(buf) = 12345;
+  disk_mgr->WritePage(num_pages - 1, buf);
+  disk_mgr->ReadPage(num_pages - 1, buf);
+  EXPECT_EQ(12345, *reinterpret_cast<uint32_t *>(buf));
+  disk_mgr->Sync();
+  disk_mgr->Close();
+  delete disk_mgr;
+
+  disk_mgr = new DiskManager(db_name);
+  for (uint32_t i = 0; i < num_pages; i++) {
+    disk_mgr->ReadPage(i, buf);
+    EXPECT_EQ(i == num_pages - 1 ? 12345 : i, *reinterpret_cast<uint32_t *>(buf));
+  }
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, WritePagesTest) {
+  std::string db_name = "disk_test.db";
+  const uint32_t num_pages = 40;
+  // runs broken by gaps, given out of order
+  const std::vector<page_id_t> written = {31, 5, 6, 0, 1, 2, 3, 4, 39, 12, 14, 13, 30, 7, 8, 9};
+  std::vector<std::pair<DiskIOMode, DurabilityMode>> modes = {{DiskIOMode::kPositional, DurabilityMode::kWriteThrough},
+                                                              {DiskIOMode::kPositional, DurabilityMode::kGroupCommit},
+                                                              {DiskIOMode::kFstream, DurabilityMode::kWriteThrough}};
+  for (auto mode : modes) {
+    remove(db_name.c_str());
+    auto *disk_mgr = new DiskManager(db_name, mode.first, mode.second);
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(i, disk_mgr->AllocatePage());
+    }
+    std::vector<std::unique_ptr<char[]>> bufs;
+    std::vector<std::pair<page_id_t, const char *>> pages;
+    for (auto page_id : written) {
+      bufs.emplace_back(new char[PAGE_SIZE]);
+      snprintf(bufs.back().get(), PAGE_SIZE, "page %d", static_cast<int>(page_id));
+      pages.emplace_back(page_id, bufs.back().get());
+    }
+    disk_mgr->WritePages(pages);
+    disk_mgr->Sync();
+    disk_mgr->Close();
+    delete disk_mgr;
+
+    disk_mgr = new DiskManager(db_name);
+    char buf[PAGE_SIZE];
+    char expected[PAGE_SIZE];
+    for (uint32_t i = 0; i < num_pages; i++) {
+      disk_mgr->ReadPage(i, buf);
+      bool is_written = std::find(written.begin(), written.end(), static_cast<page_id_t>(i)) != written.end();
+      snprintf(expected, PAGE_SIZE, "page %d", i);
+      EXPECT_STREQ(is_written ? expected : "", buf);
+    }
+    disk_mgr->Close();
+    delete disk_mgr;
+  }
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, AsyncPageIOTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const uint32_t num_pages = 128;
+  std::vector<std::unique_ptr<char[]>> bufs;
+  std::vector<IOHandle> handles;
+  for (uint32_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    bufs.emplace_back(new char[PAGE_SIZE]());
+    *reinterpret_cast<uint32_t *>(bufs[i].get()) = i;
+    handles.emplace_back(disk_mgr->WritePageAsync(i, bufs[i].get()));
+  }
+  for (auto &handle : handles) {
+    EXPECT_TRUE(handle.get());
+  }
+  handles.clear();
+  for (uint32_t i = 0; i < num_pages; i++) {
+    memset(bufs[i].get(), 0xff, PAGE_SIZE);
+    handles.emplace_back(disk_mgr->ReadPageAsync(num_pages - 1 - i, bufs[i].get()));
+  }
+  for (uint32_t i = 0; i < num_pages; i++) {
+    EXPECT_TRUE(handles[i].get());
+    EXPECT_EQ(num_pages - 1 - i, *reinterpret_cast<uint32_t *>(bufs[i].get()));
+    EXPECT_EQ(0, bufs[i][PAGE_SIZE - 1]);
+  }
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, ExtentReservationTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  const uint32_t run_size = 16;
+  ExtentReservation reservation_a(run_size);
+  ExtentReservation reservation_b(run_size);
+  // two objects and single page allocations grow interleaved, each object still gets runs of contiguous pages
+  std::vector<page_id_t> pages_a;
+  std::vector<page_id_t> pages_b;
+  for (uint32_t i = 0; i < run_size * 2; i++) {
+    pages_a.push_back(disk_mgr->AllocatePage(&reservation_a));
+    pages_b.push_back(disk_mgr->AllocatePage(&reservation_b));
+    disk_mgr->AllocatePage();
+  }
+  for (uint32_t i = 0; i < run_size * 2; i++) {
+    if (i % run_size != 0) {
+      EXPECT_EQ(pages_a[i - 1] + 1, pages_a[i]);
+      EXPECT_EQ(pages_b[i - 1] + 1, pages_b[i]);
+    }
+  }
+  EXPECT_EQ(0, reservation_a.GetRemaining());
+  EXPECT_EQ(run_size * 6, meta_page->GetAllocatedPages());
+  // the read ahead of an object stops at the end of its runs
+  EXPECT_EQ(pages_a[run_size - 1] + 1, reservation_a.GetRunEnd(pages_a[0]));
+  EXPECT_EQ(pages_a[run_size * 2 - 1] + 1, reservation_a.GetRunEnd(pages_a[run_size]));
+  EXPECT_EQ(pages_b[0] + 1, reservation_a.GetRunEnd(pages_b[0]));
+
+  // pages not handed out yet are freed on release
+  page_id_t page_id = disk_mgr->AllocatePage(&reservation_a);
+  EXPECT_EQ(run_size - 1, reservation_a.GetRemaining());
+  disk_mgr->ReleaseReservation(&reservation_a);
+  disk_mgr->ReleaseReservation(&reservation_b);
+  EXPECT_EQ(0, reservation_a.GetRemaining());
+  EXPECT_EQ(run_size * 6 + 1, meta_page->GetAllocatedPages());
+  EXPECT_FALSE(disk_mgr->IsPageFree(page_id));
+  EXPECT_TRUE(disk_mgr->IsPageFree(page_id + 1));
+  EXPECT_EQ(page_id + 1, reservation_a.GetRunEnd(page_id));
+
+  // a run never crosses an extent boundary
+  EXPECT_EQ(DiskManager::BITMAP_SIZE, disk_mgr->AllocateContiguousPages(DiskManager::BITMAP_SIZE));
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  EXPECT_EQ(INVALID_PAGE_ID, disk_mgr->AllocateContiguousPages(DiskManager::BITMAP_SIZE + 1));
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, ExtentReservationCrashTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  ExtentReservation reservation;
+  std::vector<page_id_t> page_ids;
+  for (int i = 0; i < 3; i++) {
+    page_ids.push_back(disk_mgr->AllocatePage(&reservation));
+  }
+  EXPECT_EQ(ExtentReservation::DEFAULT_RUN_SIZE - 3, reservation.GetRemaining());
+  EXPECT_FALSE(disk_mgr->IsPageFree(page_ids.back() + 1));
+  disk_mgr->Checkpoint();
+
+  // the db file is opened again as after a crash, only the pages handed out are allocated in it
+  auto *reopened = new DiskManager(db_name);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(reopened->GetMetaData());
+  EXPECT_EQ(3, meta_page->GetAllocatedPages());
+  EXPECT_EQ(3, reopened->GetExtentUsedPage(0));
+  for (uint32_t i = 0; i < ExtentReservation::DEFAULT_RUN_SIZE; i++) {
+    EXPECT_EQ(i >= 3, reopened->IsPageFree(page_ids.front() + i));
+  }
+  delete reopened;
+
+  // pages handed out after the checkpoint are allocated in the file from the next one on
+  page_ids.push_back(disk_mgr->AllocatePage(&reservation));
+  disk_mgr->Checkpoint();
+  reopened = new DiskManager(db_name);
+  EXPECT_FALSE(reopened->IsPageFree(page_ids.back()));
+  EXPECT_TRUE(reopened->IsPageFree(page_ids.back() + 1));
+  EXPECT_EQ(4, reinterpret_cast<DiskFileMetaPage *>(reopened->GetMetaData())->GetAllocatedPages());
+  delete reopened;
+
+  disk_mgr->ReleaseReservation(&reservation);
+  EXPECT_TRUE(disk_mgr->IsPageFree(page_ids.back() + 1));
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, DirectIOTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  const uint32_t num_pages = 64;
+  for (auto durability : {DurabilityMode::kWriteThrough, DurabilityMode::kGroupCommit}) {
+    auto *disk_mgr = new DiskManager(db_name, DiskIOMode::kDirect, durability);
+    // aligned buffers go straight to the device, unaligned ones through a bounce buffer
+    AlignedPageBuffer aligned(DiskManager::AllocateAlignedPages(1));
+    std::unique_ptr<char[]> unaligned_buf(new char[PAGE_SIZE + 1]);
+    char *unaligned = unaligned_buf.get() + 1;
+    for (uint32_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(i, disk_mgr->AllocatePage());
+      char *buf = i % 2 == 0 ? aligned.get() : unaligned;
+      memset(buf, 0, PAGE_SIZE);
+      *reinterpret_cast<uint32_t *>(buf) = i;
+      disk_mgr->WritePage(i, buf);
+    }
+    disk_mgr->Close();
+    delete disk_mgr;
+
+    disk_mgr = new DiskManager(db_name, DiskIOMode::kDirect);
+    EXPECT_EQ(num_pages, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages());
+    for (uint32_t i = 0; i < num_pages; i++) {
+      char *buf = i % 3 == 0 ? aligned.get() : unaligned;
+      memset(buf, 0xff, PAGE_SIZE);
+      if (i % 2 == 0) {
+        disk_mgr->ReadPage(i, buf);
+      } else {
+        EXPECT_TRUE(disk_mgr->ReadPageAsync(i, buf).get());
+      }
+      EXPECT_EQ(i, *reinterpret_cast<uint32_t *>(buf));
+      EXPECT_EQ(0, buf[PAGE_SIZE - 1]);
+    }
+    disk_mgr->Close();
+    delete disk_mgr;
+    remove(db_name.c_str());
+  }
+}
+
+TEST(DiskManagerTest, ExtentDirectoryTest) {
+  std::string db_name = "disk_test.db";
+  remove(db_name.c_str());
+  const size_t bitmap_size = DiskManager::BITMAP_SIZE;
+  const uint32_t num_extents = META_EXTENT_NUM + 2;
+  // the sparse file ends far behind the meta page extents, ext4 limits a file to 16 TB
+  const uintmax_t file_size = static_cast<uintmax_t>(num_extents) * (bitmap_size + 1) * PAGE_SIZE;
+  if (file_size > (static_cast<uintmax_t>(16) << 40)) {
+    GTEST_SKIP() << "the test file would take " << (file_size >> 40) << " TB with " << PAGE_SIZE << " byte pages";
+  }
+  // whole extents at a time keep the test fast, the fstream backend reserves no disk space so the file stays sparse
+  auto *disk_mgr = new DiskManager(db_name, DiskIOMode::kFstream);
+  for (uint32_t i = 0; i < num_extents; i++) {
+    ASSERT_EQ(i * bitmap_size, disk_mgr->AllocateContiguousPages(bitmap_size));
+  }
+  // the first extent beyond the meta page sits behind the first directory page
+  page_id_t page_id = META_EXTENT_NUM * bitmap_size;
+  char buf[PAGE_SIZE] = {0};
+  snprintf(buf, PAGE_SIZE, "page %d", static_cast<int>(page_id));
+  disk_mgr->WritePage(page_id, buf);
+  disk_mgr->DeAllocatePage(page_id + bitmap_size);
+  EXPECT_EQ(bitmap_size, disk_mgr->GetExtentUsedPage(META_EXTENT_NUM));
+  EXPECT_EQ(bitmap_size - 1, disk_mgr->GetExtentUsedPage(META_EXTENT_NUM + 1));
+  disk_mgr->Close();
+  delete disk_mgr;
+  {
+    std::ifstream file(db_name, std::ios::binary);
+    char raw[PAGE_SIZE];
+    file.seekg((META_EXTENT_NUM * (bitmap_size + 1) + 3) * PAGE_SIZE);
+    file.read(raw, PAGE_SIZE);
+    EXPECT_STREQ(buf, raw);
+  }
+
+  // counters beyond the meta page survive a restart
+  disk_mgr = new DiskManager(db_name, DiskIOMode::kFstream);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(num_extents, meta_page->GetExtentNums());
+  EXPECT_EQ(num_extents * bitmap_size - 1, meta_page->GetAllocatedPages());
+  EXPECT_EQ(bitmap_size, disk_mgr->GetExtentUsedPage(META_EXTENT_NUM));
+  EXPECT_EQ(bitmap_size - 1, disk_mgr->GetExtentUsedPage(META_EXTENT_NUM + 1));
+  char read_buf[PAGE_SIZE];
+  disk_mgr->ReadPage(page_id, read_buf);
+  EXPECT_STREQ(buf, read_buf);
+  EXPECT_TRUE(disk_mgr->IsPageFree(page_id + bitmap_size));
+  EXPECT_EQ(page_id + bitmap_size, disk_mgr->AllocatePage());
+
+  // releasing the extents behind the directory page drops the directory page as well
+  for (page_id_t i = page_id; i < static_cast<page_id_t>(page_id + 2 * bitmap_size); i++) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  EXPECT_EQ(2, disk_mgr->Shrink());
+  EXPECT_EQ(META_EXTENT_NUM, meta_page->GetExtentNums());
+  EXPECT_GE(static_cast<uintmax_t>(META_EXTENT_NUM * (bitmap_size + 1) + 1) * PAGE_SIZE,
+            std::filesystem::file_size(db_name));
+  EXPECT_EQ(page_id, disk_mgr->AllocateContiguousPages(bitmap_size));
+  EXPECT_EQ(0, disk_mgr->GetExtentUsedPage(META_EXTENT_NUM + 1));
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
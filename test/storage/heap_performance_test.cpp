@@ -16,7 +16,7 @@ TEST(TableHeapTest, HeapPerformanceTest) {
   // 初始化测试实例，设置较小的缓冲池大小
   remove(db_file_name.c_str());
   auto disk_mgr = new DiskManager(db_file_name);
-  auto bpm = new BufferPoolManager(10, disk_mgr);
+  auto bpm = new BufferPoolManagerInstance(10, disk_mgr);
   const int row_nums = 1000;
 
   // 创建 schema
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/instance.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+
+static const std::string db_file_name = "page_size_performance_test.db";
+
+/**
+ * Insert, point lookup and scan throughput of a table heap with a primary key index. The buffer pool gets the same
+ * amount of memory whatever the page size, build with different MINISQL_PAGE_SIZE to compare, see
+ * page_size_benchmark.sh.
+ */
+TEST(PageSizePerformanceTest, ThroughputTest) {
+  const int row_nums = 50000;
+  const int lookup_nums = 50000;
+  const size_t buffer_pool_bytes = 2 * 1024 * 1024;
+  remove(db_file_name.c_str());
+  auto *disk_mgr = new DiskManager(db_file_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_bytes / PAGE_SIZE, disk_mgr);
+  page_id_t id;
+  ASSERT_NE(nullptr, bpm->NewPage(id));
+  ASSERT_EQ(CATALOG_META_PAGE_ID, id);
+  ASSERT_NE(nullptr, bpm->NewPage(id));
+  ASSERT_EQ(INDEX_ROOTS_PAGE_ID, id);
+  bpm->UnpinPage(CATALOG_META_PAGE_ID, true);
+  bpm->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("score", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  auto *key_schema = Schema::ShallowCopySchema(schema.get(), {0});
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  auto *index = new BPlusTreeIndex(0, key_schema, 16, bpm);
+
+  // insert rows in random key order
+  std::vector<int> keys(row_nums);
+  for (int i = 0; i < row_nums; i++) {
+    keys[i] = i;
+  }
+  std::mt19937 rng(0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  char name[64];
+  auto start_time = std::chrono::steady_clock::now();
+  for (int key : keys) {
+    snprintf(name, sizeof(name), "row %d", key);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, key), Field(TypeId::kTypeChar, name, strlen(name), true),
+                              Field(TypeId::kTypeFloat, static_cast<float>(key))};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, key)};
+    Row key_row(key_fields);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(key_row, row.GetRowId(), nullptr));
+  }
+  auto stop_time = std::chrono::steady_clock::now();
+  double insert_throughput = row_nums / std::chrono::duration<double>(stop_time - start_time).count();
+
+  // point lookups through the index
+  std::uniform_int_distribution<int> dist(0, row_nums - 1);
+  std::vector<RowId> result;
+  start_time = std::chrono::steady_clock::now();
+  for (int i = 0; i < lookup_nums; i++) {
+    int key = dist(rng);
+    result.clear();
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, key)};
+    Row key_row(key_fields);
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(key_row, result, nullptr));
+    ASSERT_EQ(1, result.size());
+    Row row(result[0]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, key)));
+  }
+  stop_time = std::chrono::steady_clock::now();
+  double lookup_throughput = lookup_nums / std::chrono::duration<double>(stop_time - start_time).count();
+
+  // full scan of the table heap
+  int count = 0;
+  start_time = std::chrono::steady_clock::now();
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    count++;
+  }
+  stop_time = std::chrono::steady_clock::now();
+  ASSERT_EQ(row_nums, count);
+  double scan_throughput = row_nums / std::chrono::duration<double>(stop_time - start_time).count();
+
+  LOG(INFO) << "[page size " << PAGE_SIZE << "] insert: " << static_cast<uint64_t>(insert_throughput)
+            << " rows/s, point lookup: " << static_cast<uint64_t>(lookup_throughput)
+            << " rows/s, scan: " << static_cast<uint64_t>(scan_throughput) << " rows/s";
+
+  delete index;
+  delete table_heap;
+  delete key_schema;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_file_name.c_str());
+}
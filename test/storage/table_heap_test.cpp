@@ -16,7 +16,7 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   // init testing instance
   remove(db_file_name.c_str());
   auto disk_mgr_ = new DiskManager(db_file_name);
-  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
   const int row_nums = 10000;
   // create schema
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
@@ -66,7 +66,7 @@ TEST(TableHeapTest, TableHeapDeleteTest) {
   // 初始化测试实例
   remove(db_file_name.c_str());
   auto disk_mgr = new DiskManager(db_file_name);
-  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  auto bpm = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
 
   // 创建 schema
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
@@ -119,7 +119,7 @@ TEST(TableHeapTest, TableHeapUpdateTest) {
   // 初始化测试实例
   remove(db_file_name.c_str());
   auto disk_mgr = new DiskManager(db_file_name);
-  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  auto bpm = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
 
   // 创建 schema
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
@@ -170,7 +170,7 @@ TEST(TableHeapTest, TableHeapMassiveTest) {
   // 初始化测试实例
   remove(db_file_name.c_str());
   auto disk_mgr = new DiskManager(db_file_name);
-  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  auto bpm = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
 
   // 创建四列的schema：int + char + float + char
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
@@ -378,7 +378,7 @@ TEST(TableHeapTest, TableIteratorTest) {
   // 初始化测试实例
   remove(db_file_name.c_str());
   auto disk_mgr = new DiskManager(db_file_name);
-  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  auto bpm = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
 
   // 创建 schema
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};